@@ -0,0 +1,360 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+
+    Benchmarks for the single pattern searchers.
+
+    For each kind of corpus (random bytes, English-like text, DNA, and binary
+    data with long repeats), each corpus size and each pattern length, the
+    pattern is taken from near the end of the corpus, and every searcher is
+    timed on it. Construction and search are timed separately; each is
+    repeated until it has taken at least --min-time seconds, and the average
+    is reported. "Comparisons" are the reads of corpus elements that the
+    searcher makes, counted in a separate (untimed) run through an iterator
+    that counts its dereferences.
+
+    The crossover points in these results are what the defaults in
+    auto_search_thresholds (auto_searcher.hpp) are based on; run this on the
+    target machine to tune them.
+
+    Usage: search_bench [--quick] [--min-time seconds] [--json file]
+*/
+
+#include <boost/algorithm/searching/auto_searcher.hpp>
+#include <boost/algorithm/searching/boyer_moore.hpp>
+#include <boost/algorithm/searching/boyer_moore_horspool.hpp>
+#include <boost/algorithm/searching/knuth_morris_pratt.hpp>
+#include <boost/algorithm/searching/knuth_morris_pratt_dfa.hpp>
+#include <boost/algorithm/searching/two_way.hpp>
+
+#include <boost/config.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/iterator/iterator_adaptor.hpp>
+
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+#ifndef BOOST_NO_CXX11_HDR_CHRONO
+#include <chrono>
+#endif
+
+namespace ba = boost::algorithm;
+
+namespace {
+
+    typedef const char *iter_type;
+
+//  Seconds since some fixed point
+    double now () {
+#ifndef BOOST_NO_CXX11_HDR_CHRONO
+        return std::chrono::duration<double> ( std::chrono::steady_clock::now ().time_since_epoch ()).count ();
+#else
+        return static_cast<double> ( std::clock ()) / CLOCKS_PER_SEC;
+#endif
+        }
+
+//  Somewhere to put results, so that the compiler can't throw the work away
+    const void * volatile g_escape = NULL;
+    volatile std::size_t g_sink = 0;
+
+//  Counts the corpus elements that a searcher reads
+    boost::uintmax_t g_reads = 0;
+
+    class counting_iterator
+        : public boost::iterator_adaptor<counting_iterator, iter_type> {
+    public:
+        counting_iterator () {}
+        explicit counting_iterator ( iter_type p ) : counting_iterator::iterator_adaptor_ ( p ) {}
+    private:
+        friend class boost::iterator_core_access;
+        const char &dereference () const { ++g_reads; return *this->base (); }
+        };
+
+
+//  std::search, dressed up as a searcher
+    class std_search {
+    public:
+        std_search ( iter_type first, iter_type last ) : pat_first ( first ), pat_last ( last ) {}
+
+        template <typename corpusIter>
+        corpusIter operator () ( corpusIter corpus_first, corpusIter corpus_last ) const {
+            return std::search ( corpus_first, corpus_last, pat_first, pat_last );
+            }
+
+    private:
+        iter_type pat_first;
+        iter_type pat_last;
+        };
+
+
+//  Deterministic corpora
+    class lcg {
+    public:
+        explicit lcg ( boost::uint64_t seed ) : state_ ( seed ) {}
+        boost::uint32_t operator () () {
+            state_ = state_ * 6364136223846793005ULL + 1442695040888963407ULL;
+            return static_cast<boost::uint32_t> ( state_ >> 33 );
+            }
+    private:
+        boost::uint64_t state_;
+        };
+
+    std::vector<char> random_bytes ( std::size_t size ) {
+        lcg rand ( 1 );
+        std::vector<char> retVal ( size );
+        for ( std::size_t i = 0; i < size; ++i )
+            retVal [ i ] = static_cast<char> ( rand () & 0xFF );
+        return retVal;
+        }
+
+    std::vector<char> english_text ( std::size_t size ) {
+        static const char *k_words [] = {
+            "the", "of", "and", "to", "a", "in", "is", "it", "you", "that", "he", "was", "for", "on",
+            "are", "with", "as", "his", "they", "be", "at", "one", "have", "this", "from", "or", "had",
+            "by", "word", "but", "what", "some", "we", "can", "out", "other", "were", "all", "there",
+            "when", "up", "use", "your", "how", "said", "an", "each", "she", "which", "do", "their",
+            "time", "if", "will", "way", "about", "many", "then", "them", "write", "would", "like",
+            "so", "these", "her", "long", "make", "thing", "see", "him", "two", "has", "look", "more",
+            "day", "could", "go", "come", "did", "number", "sound", "no", "most", "people", "my",
+            "over", "know", "water", "than", "call", "first", "who", "may", "down", "side", "been",
+            "now", "find", "searching", "algorithm", "pattern", "corpus", "table", "boyer", "moore"
+            };
+        const std::size_t k_count = sizeof ( k_words ) / sizeof ( k_words [ 0 ] );
+        lcg rand ( 2 );
+        std::vector<char> retVal;
+        retVal.reserve ( size + 16 );
+        while ( retVal.size () < size ) {
+        //  Short, common words come up more often
+            const std::size_t limit = 1 + rand () % k_count;
+            const char *word = k_words [ rand () % limit ];
+            retVal.insert ( retVal.end (), word, word + std::strlen ( word ));
+            const boost::uint32_t r = rand () % 16;
+            if ( r == 0 )      { retVal.push_back ( '.' ); retVal.push_back ( ' ' ); }
+            else if ( r == 1 ) { retVal.push_back ( ',' ); retVal.push_back ( ' ' ); }
+            else if ( r == 2 )   retVal.push_back ( '\n' );
+            else                 retVal.push_back ( ' ' );
+            }
+        retVal.resize ( size );
+        return retVal;
+        }
+
+    std::vector<char> dna ( std::size_t size ) {
+        static const char k_bases [] = { 'A', 'C', 'G', 'T' };
+        lcg rand ( 3 );
+        std::vector<char> retVal ( size );
+        for ( std::size_t i = 0; i < size; ++i )
+            retVal [ i ] = k_bases [ rand () % 4 ];
+        return retVal;
+        }
+
+//  Blocks of random bytes, each repeated several times with a few bytes
+//  changed, and runs of zeros in between
+    std::vector<char> binary_repeats ( std::size_t size ) {
+        lcg rand ( 4 );
+        std::vector<char> retVal;
+        retVal.reserve ( size + 8192 );
+        while ( retVal.size () < size ) {
+            std::vector<char> block ( 256 + rand () % 3840 );
+            for ( std::size_t i = 0; i < block.size (); ++i )
+                block [ i ] = static_cast<char> ( rand () & 0xFF );
+            const std::size_t k_copies = 2 + rand () % 6;
+            for ( std::size_t c = 0; c < k_copies; ++c ) {
+                for ( std::size_t j = 0; j < 3; ++j )
+                    block [ rand () % block.size () ] = static_cast<char> ( rand () & 0xFF );
+                retVal.insert ( retVal.end (), block.begin (), block.end ());
+                }
+            retVal.insert ( retVal.end (), rand () % 1024, '\0' );
+            }
+        retVal.resize ( size );
+        return retVal;
+        }
+
+
+    struct result {
+        std::string corpus;
+        std::size_t corpus_size;
+        std::size_t pattern_length;
+        std::string searcher;
+        double construct_ns;        // per construction
+        double search_seconds;      // per search
+        double gb_per_second;
+        double comparisons_per_byte;
+        };
+
+    struct options {
+        options () : quick ( false ), min_time ( 0.1 ) {}
+        bool quick;
+        double min_time;
+        std::string json;
+        };
+
+    template <typename Searcher>
+    void run_one ( const char *name, const std::string &corpus_name,
+                   const std::vector<char> &corpus, const std::vector<char> &pattern,
+                   const options &opts, std::vector<result> &results ) {
+        const iter_type c_first = &corpus [ 0 ];
+        const iter_type c_last  = c_first + corpus.size ();
+        const iter_type p_first = &pattern [ 0 ];
+        const iter_type p_last  = p_first + pattern.size ();
+        const iter_type expected = std::search ( c_first, c_last, p_first, p_last );
+
+    //  Construction
+        std::size_t count = 0;
+        double start = now (), elapsed = 0;
+        do {
+            for ( std::size_t i = 0; i < 16; ++i, ++count ) {
+                const Searcher s ( p_first, p_last );
+                g_escape = &s;
+                }
+            elapsed = now () - start;
+            } while ( elapsed < opts.min_time / 4 );
+        const double construct_ns = elapsed * 1e9 / count;
+
+    //  Search
+        const Searcher s ( p_first, p_last );
+        if ( s ( c_first, c_last ) != expected )
+            throw std::runtime_error ( std::string ( "Unexpected result from " ) + name );
+        count = 0;
+        start = now ();
+        do {
+            g_sink += s ( c_first, c_last ) - c_first;
+            ++count;
+            elapsed = now () - start;
+            } while ( elapsed < opts.min_time );
+        const double search_seconds = elapsed / count;
+
+    //  Reads of the corpus
+        g_reads = 0;
+        s ( counting_iterator ( c_first ), counting_iterator ( c_last ));
+        const double k_scanned = ( expected == c_last ? corpus.size () : ( expected - c_first ) + pattern.size ());
+
+        result r;
+        r.corpus = corpus_name;
+        r.corpus_size = corpus.size ();
+        r.pattern_length = pattern.size ();
+        r.searcher = name;
+        r.construct_ns = construct_ns;
+        r.search_seconds = search_seconds;
+        r.gb_per_second = k_scanned / search_seconds / 1e9;
+        r.comparisons_per_byte = g_reads / k_scanned;
+        results.push_back ( r );
+
+        std::cout
+            << std::setw(8)  << corpus_name << " "
+            << std::setw(10) << r.corpus_size << " "
+            << std::setw(6)  << r.pattern_length << " "
+            << std::setw(22) << name << " "
+            << std::setw(12) << std::setprecision(1) << r.construct_ns << " "
+            << std::setw(8)  << std::setprecision(3) << r.gb_per_second << " "
+            << std::setw(8)  << std::setprecision(3) << r.comparisons_per_byte << std::endl;
+        }
+
+    void run_all ( const std::string &corpus_name, const std::vector<char> &corpus,
+                   const std::vector<std::size_t> &lengths, const options &opts, std::vector<result> &results ) {
+        for ( std::size_t i = 0; i < lengths.size (); ++i ) {
+            const std::size_t m = lengths [ i ];
+            if ( m * 8 > corpus.size ())
+                continue;
+        //  From near the end, so that most of the corpus is searched
+            const std::size_t k_offset = corpus.size () - corpus.size () / 8;
+            const std::vector<char> pattern ( corpus.begin () + k_offset, corpus.begin () + k_offset + m );
+
+            run_one<std_search>                              ( "std::search",            corpus_name, corpus, pattern, opts, results );
+            run_one<ba::boyer_moore<iter_type> >             ( "boyer_moore",            corpus_name, corpus, pattern, opts, results );
+            run_one<ba::boyer_moore_horspool<iter_type> >    ( "boyer_moore_horspool",   corpus_name, corpus, pattern, opts, results );
+            run_one<ba::knuth_morris_pratt<iter_type> >      ( "knuth_morris_pratt",     corpus_name, corpus, pattern, opts, results );
+            run_one<ba::knuth_morris_pratt_dfa<iter_type> >  ( "knuth_morris_pratt_dfa", corpus_name, corpus, pattern, opts, results );
+            run_one<ba::two_way<iter_type> >                 ( "two_way",                corpus_name, corpus, pattern, opts, results );
+            run_one<ba::auto_searcher<iter_type> >           ( "auto_searcher",          corpus_name, corpus, pattern, opts, results );
+            }
+        }
+
+    void write_json ( const std::string &file_name, const std::vector<result> &results ) {
+        std::ofstream out ( file_name.c_str ());
+        if ( !out )
+            throw std::runtime_error ( "Can't open " + file_name );
+        out << std::setprecision(6) << "[\n";
+        for ( std::size_t i = 0; i < results.size (); ++i ) {
+            const result &r = results [ i ];
+            out << "  { \"corpus\": \""         << r.corpus << "\""
+                << ", \"corpus_size\": "        << r.corpus_size
+                << ", \"pattern_length\": "     << r.pattern_length
+                << ", \"searcher\": \""         << r.searcher << "\""
+                << ", \"construct_ns\": "       << r.construct_ns
+                << ", \"search_seconds\": "     << r.search_seconds
+                << ", \"gb_per_second\": "      << r.gb_per_second
+                << ", \"comparisons_per_byte\": " << r.comparisons_per_byte
+                << " }" << ( i + 1 < results.size () ? "," : "" ) << "\n";
+            }
+        out << "]\n";
+        }
+    }
+
+
+int main ( int argc, char *argv [] ) {
+    options opts;
+    for ( int i = 1; i < argc; ++i ) {
+        const std::string arg ( argv [ i ] );
+        if ( arg == "--quick" )
+            opts.quick = true;
+        else if ( arg == "--min-time" && i + 1 < argc )
+            opts.min_time = std::atof ( argv [ ++i ] );
+        else if ( arg == "--json" && i + 1 < argc )
+            opts.json = argv [ ++i ];
+        else {
+            std::cerr << "Usage: " << argv [ 0 ] << " [--quick] [--min-time seconds] [--json file]" << std::endl;
+            return 1;
+            }
+        }
+    if ( opts.quick )
+        opts.min_time = std::min ( opts.min_time, 0.01 );
+
+    std::vector<std::size_t> sizes, lengths;
+    sizes.push_back ( 1 << 16 );
+    sizes.push_back ( 1 << 20 );
+    if ( !opts.quick )
+        sizes.push_back ( 1 << 24 );
+    const std::size_t k_lengths [] = { 4, 8, 16, 32, 64, 256, 1024 };
+    for ( std::size_t i = 0; i < sizeof ( k_lengths ) / sizeof ( k_lengths [ 0 ] ); ++i )
+        if ( !opts.quick || k_lengths [ i ] <= 64 )
+            lengths.push_back ( k_lengths [ i ] );
+
+    std::cout << std::fixed
+        << std::setw(8)  << "corpus" << " "
+        << std::setw(10) << "size" << " "
+        << std::setw(6)  << "m" << " "
+        << std::setw(22) << "searcher" << " "
+        << std::setw(12) << "build (ns)" << " "
+        << std::setw(8)  << "GB/s" << " "
+        << std::setw(8)  << "cmp/byte" << std::endl;
+
+    std::vector<result> results;
+    try {
+        for ( std::size_t i = 0; i < sizes.size (); ++i ) {
+            run_all ( "random",  random_bytes   ( sizes [ i ] ), lengths, opts, results );
+            run_all ( "english", english_text   ( sizes [ i ] ), lengths, opts, results );
+            run_all ( "dna",     dna            ( sizes [ i ] ), lengths, opts, results );
+            run_all ( "repeats", binary_repeats ( sizes [ i ] ), lengths, opts, results );
+            }
+        if ( !opts.json.empty ())
+            write_json ( opts.json, results );
+        }
+    catch ( const std::exception &e ) {
+        std::cerr << e.what () << std::endl;
+        return 1;
+        }
+    return 0;
+    }
@@ -0,0 +1,172 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+
+    Timing of the skip tables that boyer_moore and boyer_moore_horspool use.
+
+    First, byte patterns of lengths that get each width of the byte table:
+    one byte per entry, two bytes, and a whole difference_type. Then, for
+    UTF-16 and UTF-32 text, the flat skip table that is used for wider
+    integers, against the unordered_map one.
+
+    Each corpus is read through an iterator that hides its contiguity, so
+    that the vectorized search doesn't take over, and each pattern ends in
+    an element that is not in the corpus, so that every search runs to the
+    end. Each search is repeated until it has taken at least a fifth of a
+    second, and the speed is given in GB/s.
+
+    Usage: skip_table_bench
+*/
+
+#include <boost/algorithm/searching/boyer_moore.hpp>
+#include <boost/algorithm/searching/boyer_moore_horspool.hpp>
+
+#include <boost/config.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/iterator/iterator_adaptor.hpp>
+
+#include <cstddef>
+#include <ctime>
+#include <iostream>
+#include <iomanip>
+#include <stdexcept>
+#include <vector>
+
+#ifndef BOOST_NO_CXX11_HDR_CHRONO
+#include <chrono>
+#endif
+
+namespace ba = boost::algorithm;
+
+namespace {
+
+    const double k_min_time = 0.2;
+
+//  Seconds since some fixed point
+    double now () {
+#ifndef BOOST_NO_CXX11_HDR_CHRONO
+        return std::chrono::duration<double> ( std::chrono::steady_clock::now ().time_since_epoch ()).count ();
+#else
+        return static_cast<double> ( std::clock ()) / CLOCKS_PER_SEC;
+#endif
+        }
+
+//  Somewhere to put results, so that the compiler can't throw the work away
+    volatile std::size_t g_sink = 0;
+
+    unsigned long next_random ( unsigned long &state ) {
+        state = state * 1103515245UL + 12345UL;
+        return ( state >> 16 ) & 0x7FFF;
+        }
+
+//  Reads a contiguous corpus without saying that it is contiguous
+    template <typename T>
+    class plain_iterator
+        : public boost::iterator_adaptor<plain_iterator<T>, const T *> {
+    public:
+        plain_iterator () {}
+        explicit plain_iterator ( const T *p ) : plain_iterator::iterator_adaptor_ ( p ) {}
+        };
+
+//  The skip table that was used for everything but bytes before the flat one
+    template <typename Iterator>
+    struct map_traits {
+        typedef typename std::iterator_traits<Iterator>::difference_type value_type;
+        typedef typename std::iterator_traits<Iterator>::value_type key_type;
+        typedef ba::detail::skip_table<key_type, value_type, false> skip_table_t;
+        };
+
+//  'size' elements, each one of 'alphabet' values starting at 'base'
+    template <typename T>
+    std::vector<T> make_text ( std::size_t size, boost::uint32_t base, unsigned alphabet, unsigned long seed ) {
+        std::vector<T> retVal ( size );
+        for ( std::size_t i = 0; i < size; ++i )
+            retVal [ i ] = static_cast<T> ( base + next_random ( seed ) % alphabet );
+        return retVal;
+        }
+
+//  GB/s for searches of the whole corpus, for a pattern that isn't in it
+    template <typename Searcher, typename T>
+    double time_one ( const std::vector<T> &corpus, const std::vector<T> &pattern ) {
+        typedef plain_iterator<T> corpus_iter;
+        const corpus_iter c_first ( &corpus [ 0 ] );
+        const corpus_iter c_last  ( &corpus [ 0 ] + corpus.size ());
+        const Searcher s ( &pattern [ 0 ], &pattern [ 0 ] + pattern.size ());
+        if ( s ( c_first, c_last ) != c_last )
+            throw std::runtime_error ( "Unexpected match" );
+        std::size_t count = 0;
+        const double start = now ();
+        double elapsed = 0;
+        do {
+            g_sink += s ( c_first, c_last ) - c_first;
+            ++count;
+            elapsed = now () - start;
+            } while ( elapsed < k_min_time );
+        return corpus.size () * sizeof ( T ) * count / elapsed / 1e9;
+        }
+
+//  A pattern of 'length' elements from the corpus, ending in 'missing'
+    template <typename T>
+    std::vector<T> make_pattern ( const std::vector<T> &corpus, std::size_t length, T missing ) {
+        std::vector<T> retVal ( corpus.end () - length, corpus.end ());
+        retVal.back () = missing;
+        return retVal;
+        }
+
+    void run_bytes ( const std::vector<char> &corpus, std::size_t length ) {
+        typedef const char *pat_iter;
+        const std::vector<char> pattern = make_pattern ( corpus, length, '#' );
+        std::cout << std::fixed << std::setprecision(2)
+            << std::setw(8)  << length << " "
+            << std::setw(10) << time_one<ba::boyer_moore<pat_iter> > ( corpus, pattern ) << " "
+            << std::setw(10) << time_one<ba::boyer_moore_horspool<pat_iter> > ( corpus, pattern ) << std::endl;
+        }
+
+    template <typename T>
+    void run_wide ( const char *name, boost::uint32_t base, std::size_t size ) {
+        typedef const T *pat_iter;
+    //  A few thousand distinct elements, all of them outside the byte range
+        const std::vector<T> corpus = make_text<T> ( size, base, 3000, 5 );
+        const std::vector<T> pattern = make_pattern ( corpus, 32, static_cast<T> ( base + 4000 ));
+        std::cout << std::fixed << std::setprecision(2)
+            << std::setw(8)  << name << " "
+            << std::setw(10) << time_one<ba::boyer_moore<pat_iter> > ( corpus, pattern ) << " "
+            << std::setw(10) << time_one<ba::boyer_moore<pat_iter, map_traits<pat_iter> > > ( corpus, pattern ) << " "
+            << std::setw(10) << time_one<ba::boyer_moore_horspool<pat_iter> > ( corpus, pattern ) << " "
+            << std::setw(10) << time_one<ba::boyer_moore_horspool<pat_iter, map_traits<pat_iter> > > ( corpus, pattern ) << std::endl;
+        }
+    }
+
+
+int main () {
+    try {
+        const std::vector<char> text = make_text<char> ( 32 << 20, 'a', 26, 1 );
+        std::cout << "Byte patterns, 32 MiB of random letters, in GB/s\n"
+            << std::setw(8)  << "length" << " "
+            << std::setw(10) << "bm" << " "
+            << std::setw(10) << "bmh" << std::endl;
+        run_bytes ( text, 4 );          // one byte per entry
+        run_bytes ( text, 16 );
+        run_bytes ( text, 300 );        // two bytes
+        run_bytes ( text, 70000 );      // a whole difference_type
+
+        std::cout << "\nWide elements, 8M elements, in GB/s\n"
+            << std::setw(8)  << "corpus" << " "
+            << std::setw(10) << "bm flat" << " "
+            << std::setw(10) << "bm map" << " "
+            << std::setw(10) << "bmh flat" << " "
+            << std::setw(10) << "bmh map" << std::endl;
+    //  CJK text in UTF-16, and text from the supplementary planes in UTF-32
+        run_wide<boost::uint16_t> ( "UTF-16", 0x4E00,  8 << 20 );
+        run_wide<boost::uint32_t> ( "UTF-32", 0x20000, 8 << 20 );
+        }
+    catch ( const std::exception &e ) {
+        std::cerr << e.what () << std::endl;
+        return 1;
+        }
+    return 0;
+    }
@@ -0,0 +1,171 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+
+    Timing and memory use of wu_manber, against one boyer_moore_horspool
+    object per pattern.
+
+    Each run finds every match of a dictionary of random patterns (one in
+    ten of them taken from the corpus) in a random corpus of 1M chars. The
+    time covers construction and search; the memory is the bytes that the
+    searchers hold on the heap, counted by replacing the global operator new.
+
+    Usage: wu_manber_bench
+*/
+
+#include <boost/algorithm/searching/wu_manber.hpp>
+#include <boost/algorithm/searching/boyer_moore_horspool.hpp>
+
+#include <boost/config.hpp>
+
+#include <new>
+#include <cstdlib>
+#include <ctime>
+#include <iostream>
+#include <iomanip>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <set>
+#include <algorithm>
+
+#ifndef BOOST_NO_CXX11_HDR_CHRONO
+#include <chrono>
+#endif
+
+namespace ba = boost::algorithm;
+
+//  Keep track of the bytes in use on the global heap; each block
+//  records its size in a header in front of it
+namespace {
+    const std::size_t k_header = 16;
+    std::size_t g_bytes_in_use = 0;
+
+    void *counted_malloc ( std::size_t size ) {
+        char *p = static_cast<char *> ( std::malloc ( size + k_header ));
+        if ( p == NULL )
+            throw std::bad_alloc ();
+        *reinterpret_cast<std::size_t *> ( p ) = size;
+        g_bytes_in_use += size;
+        return p + k_header;
+        }
+
+    void counted_free ( void *p ) {
+        if ( p == NULL ) return;
+        char *block = static_cast<char *> ( p ) - k_header;
+        g_bytes_in_use -= *reinterpret_cast<std::size_t *> ( block );
+        std::free ( block );
+        }
+    }
+
+void *operator new   ( std::size_t size ) { return counted_malloc ( size ); }
+void *operator new[] ( std::size_t size ) { return counted_malloc ( size ); }
+void operator delete   ( void *p ) BOOST_NOEXCEPT { counted_free ( p ); }
+void operator delete[] ( void *p ) BOOST_NOEXCEPT { counted_free ( p ); }
+#ifdef __cpp_sized_deallocation
+void operator delete   ( void *p, std::size_t ) BOOST_NOEXCEPT { counted_free ( p ); }
+void operator delete[] ( void *p, std::size_t ) BOOST_NOEXCEPT { counted_free ( p ); }
+#endif
+
+namespace {
+
+    typedef std::string::const_iterator iter_type;
+    typedef ba::boyer_moore_horspool<iter_type> bmh_type;
+    typedef std::vector<std::pair<iter_type, std::size_t> > matches_type;
+
+//  Seconds since some fixed point
+    double now () {
+#ifndef BOOST_NO_CXX11_HDR_CHRONO
+        return std::chrono::duration<double> ( std::chrono::steady_clock::now ().time_since_epoch ()).count ();
+#else
+        return static_cast<double> ( std::clock ()) / CLOCKS_PER_SEC;
+#endif
+        }
+
+    unsigned long next_random ( unsigned long &state ) {
+        state = state * 1103515245UL + 12345UL;
+        return ( state >> 16 ) & 0x7FFF;
+        }
+
+    std::string make_string ( std::size_t size, unsigned long &seed ) {
+        std::string retVal ( size, ' ' );
+        for ( std::size_t i = 0; i < size; ++i )
+            retVal [ i ] = static_cast<char> ( 'a' + next_random ( seed ) % 26 );
+        return retVal;
+        }
+
+    void print_result ( const char *name, double seconds, std::size_t bytes ) {
+        std::cout << std::fixed << std::setprecision(4)
+            << std::setw(34) << name << " "
+            << std::setw(8)  << seconds << " seconds "
+            << std::setw(10) << bytes << " bytes" << std::endl;
+        }
+
+    void run_one ( const std::string &corpus, std::size_t count, std::size_t length ) {
+        unsigned long s = count;
+        std::vector<std::string> patterns;
+        for ( std::size_t i = 0; i < count; ++i )
+            patterns.push_back ( i % 10 == 0 ? corpus.substr ( next_random ( s ) * 7 % ( corpus.size () - length ), length )
+                                             : make_string ( length, s ));
+
+    //  A repeated pattern reports the first id, so only its first copy is searched for
+        std::vector<bool> repeats ( count );
+        std::set<std::string> seen;
+        for ( std::size_t i = 0; i < count; ++i )
+            repeats [ i ] = !seen.insert ( patterns [ i ] ).second;
+
+        std::cout << count << " patterns of " << length << " chars; corpus is " << corpus.size () << " chars long" << std::endl;
+
+    //  Every match, with one Horspool searcher per pattern
+        double start = now ();
+        std::size_t bytes = g_bytes_in_use;
+        std::vector<bmh_type> searchers;
+        searchers.reserve ( count );
+        for ( std::size_t i = 0; i < count; ++i )
+            searchers.push_back ( bmh_type ( patterns [ i ].begin (), patterns [ i ].end ()));
+        bytes = g_bytes_in_use - bytes;
+        matches_type expected;
+        for ( std::size_t i = 0; i < count; ++i ) {
+            if ( repeats [ i ] )
+                continue;
+            std::vector<iter_type> here;
+            searchers [ i ].find_all ( corpus.begin (), corpus.end (), std::back_inserter ( here ));
+            for ( std::size_t j = 0; j < here.size (); ++j )
+                expected.push_back ( std::make_pair ( here [ j ], i ));
+            }
+        print_result ( "boyer_moore_horspool per pattern", now () - start, bytes );
+        std::sort ( expected.begin (), expected.end ());
+
+        start = now ();
+        bytes = g_bytes_in_use;
+        const ba::wu_manber<iter_type> wm ( patterns.begin (), patterns.end ());
+        bytes = g_bytes_in_use - bytes;
+        matches_type found;
+        wm.find_all ( corpus.begin (), corpus.end (), std::back_inserter ( found ));
+        print_result ( "wu_manber", now () - start, bytes );
+
+        if ( found != expected )
+            throw std::runtime_error ( "wu_manber and boyer_moore_horspool disagree" );
+        }
+    }
+
+
+int main () {
+    unsigned long s = 1;
+    const std::string corpus = make_string ( 1 << 20, s );
+
+    try {
+        run_one ( corpus,   100,  8 );
+        run_one ( corpus,  1000,  8 );
+        run_one ( corpus, 10000, 12 );
+        }
+    catch ( const std::exception &e ) {
+        std::cerr << e.what () << std::endl;
+        return 1;
+        }
+    return 0;
+    }
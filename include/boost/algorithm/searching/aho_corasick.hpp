@@ -0,0 +1,206 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+#ifndef BOOST_ALGORITHM_AHO_CORASICK_SEARCH_HPP
+#define BOOST_ALGORITHM_AHO_CORASICK_SEARCH_HPP
+
+#include <cstddef>      // for std::size_t
+#include <vector>
+#include <utility>      // for std::pair
+#include <iterator>     // for std::iterator_traits
+
+#include <boost/assert.hpp>
+#include <boost/static_assert.hpp>
+
+#include <boost/range/begin.hpp>
+#include <boost/range/end.hpp>
+#include <boost/range/iterator.hpp>
+#include <boost/range/value_type.hpp>
+
+#include <boost/type_traits/is_same.hpp>
+
+#include <boost/algorithm/searching/detail/ac_traits.hpp>
+
+namespace boost { namespace algorithm {
+
+/*
+    A templated version of the Aho-Corasick multiple pattern searching algorithm.
+
+    The searcher is built from a sequence of patterns, each of which is a range
+    of 'patIter'. The patterns are numbered by their position in that sequence,
+    and a search reports both where a match starts and which pattern matched.
+    The patterns are copied into the automaton, so (unlike the single pattern
+    searchers) they need not outlive it.
+
+    Requirements:
+        * Random access iterators for the corpus
+        * The pattern iterators and the corpus iterators must
+            "point to" the same underlying type.
+        * Additional requirements may be imposed by the automaton, such as:
+        ** Numeric type (table-based automaton)
+        ** LessThanComparable type (sparse automaton)
+
+    Empty patterns are ignored; if the same pattern occurs more than once,
+    matches report the first id.
+
+    http://en.wikipedia.org/wiki/Aho%E2%80%93Corasick_string_matching_algorithm
+    http://cr.yp.to/bib/1975/aho.pdf
+*/
+
+    template <typename patIter, typename traits = detail::AC_traits<patIter> >
+    class aho_corasick {
+        typedef typename traits::automaton_t automaton_t;
+        typedef typename automaton_t::state_type state_type;
+    public:
+    //  The pattern id reported when nothing was found
+        static const std::size_t npos = static_cast<std::size_t> ( -1 );
+
+        template <typename PatternsIter>
+        aho_corasick ( PatternsIter first, PatternsIter last ) {
+            typename traits::trie_t trie;
+            for ( std::size_t id = 0; first != last; ++first, ++id ) {
+                patIter pFirst = boost::begin ( *first );
+                patIter pLast  = boost::end   ( *first );
+                lengths_.push_back ( std::distance ( pFirst, pLast ));
+                trie.insert ( pFirst, pLast, id );
+                }
+            trie.build ();
+            automaton_.build ( trie );
+            }
+
+        ~aho_corasick () {}
+
+    //  The number of patterns the searcher was built with
+        std::size_t size () const { return lengths_.size (); }
+
+        /// \fn operator ( corpusIter corpus_first, corpusIter corpus_last )
+        /// \brief Searches the corpus for the patterns that were passed into the constructor
+        ///
+        /// \param corpus_first The start of the data to search (Random Access Iterator)
+        /// \param corpus_last  One past the end of the data to search
+        ///
+        /// \return A pair: the start of the match that ends first in the corpus (the
+        ///         longest one, if several end there), and the id of its pattern.
+        ///         If nothing matches, returns (corpus_last, npos).
+        ///
+        template <typename corpusIter>
+        std::pair<corpusIter, std::size_t>
+        operator () ( corpusIter corpus_first, corpusIter corpus_last ) const {
+            BOOST_STATIC_ASSERT (( boost::is_same<
+                typename std::iterator_traits<patIter>::value_type,
+                typename std::iterator_traits<corpusIter>::value_type>::value ));
+
+            state_type s = automaton_.start ();
+            for ( corpusIter curPos = corpus_first; curPos != corpus_last; ) {
+                s = automaton_.next ( s, *curPos++ );
+                const state_type out = automaton_.output ( s );
+                if ( out != automaton_t::k_none )
+                    return make_match ( curPos, out );
+                }
+
+            return std::make_pair ( corpus_last, npos );  // We didn't find anything
+            }
+
+        template <typename Range>
+        std::pair<typename boost::range_iterator<Range>::type, std::size_t>
+        operator () ( Range &r ) const {
+            return (*this) (boost::begin(r), boost::end(r));
+            }
+
+        /// \fn find_all ( corpusIter corpus_first, corpusIter corpus_last, OutputIterator out )
+        /// \brief Finds every (possibly overlapping) occurrence of every pattern in the corpus
+        ///
+        /// \param corpus_first The start of the data to search (Random Access Iterator)
+        /// \param corpus_last  One past the end of the data to search
+        /// \param out          Receives a std::pair<corpusIter, std::size_t> of the start
+        ///                     of the match and the pattern id for each match, ordered by
+        ///                     where the matches end (longest first among equal ends).
+        ///
+        template <typename corpusIter, typename OutputIterator>
+        OutputIterator find_all ( corpusIter corpus_first, corpusIter corpus_last, OutputIterator out ) const {
+            BOOST_STATIC_ASSERT (( boost::is_same<
+                typename std::iterator_traits<patIter>::value_type,
+                typename std::iterator_traits<corpusIter>::value_type>::value ));
+
+            state_type s = automaton_.start ();
+            for ( corpusIter curPos = corpus_first; curPos != corpus_last; ) {
+                s = automaton_.next ( s, *curPos++ );
+                for ( state_type o = automaton_.output ( s ); o != automaton_t::k_none; o = automaton_.next_output ( o ))
+                    *out++ = make_match ( curPos, o );
+                }
+
+            return out;
+            }
+
+        template <typename Range, typename OutputIterator>
+        OutputIterator find_all ( Range &r, OutputIterator out ) const {
+            return this->find_all (boost::begin(r), boost::end(r), out);
+            }
+
+    private:
+/// \cond DOXYGEN_HIDE
+        std::vector<typename std::iterator_traits<patIter>::difference_type> lengths_;
+        automaton_t automaton_;
+
+    //  A match of the pattern recorded at state 'out', ending just before 'match_end'
+        template <typename corpusIter>
+        std::pair<corpusIter, std::size_t> make_match ( corpusIter match_end, state_type out ) const {
+            const std::size_t id = automaton_.pattern ( out );
+            return std::make_pair ( match_end - lengths_ [ id ], id );
+            }
+/// \endcond
+        };
+
+    template <typename patIter, typename traits>
+    const std::size_t aho_corasick<patIter, traits>::npos;
+
+
+/// \fn aho_corasick_search ( corpusIter corpus_first, corpusIter corpus_last,
+///       PatternsIter pats_first, PatternsIter pats_last )
+/// \brief Searches the corpus for any of the patterns.
+///
+/// \param corpus_first The start of the data to search (Random Access Iterator)
+/// \param corpus_last  One past the end of the data to search
+/// \param pats_first   The start of the sequence of patterns to search for
+/// \param pats_last    One past the end of the sequence of patterns
+///
+    template <typename PatternsIter, typename corpusIter>
+    std::pair<corpusIter, std::size_t> aho_corasick_search (
+                  corpusIter corpus_first, corpusIter corpus_last,
+                  PatternsIter pats_first, PatternsIter pats_last )
+    {
+        typedef typename boost::range_iterator<const typename
+            std::iterator_traits<PatternsIter>::value_type>::type pattern_iterator;
+        aho_corasick<pattern_iterator> ac ( pats_first, pats_last );
+        return ac ( corpus_first, corpus_last );
+    }
+
+    template <typename PatternsRange, typename CorpusRange>
+    std::pair<typename boost::range_iterator<CorpusRange>::type, std::size_t>
+    aho_corasick_search ( CorpusRange &corpus, const PatternsRange &patterns )
+    {
+        typedef typename boost::range_iterator<const typename
+            boost::range_value<PatternsRange>::type>::type pattern_iterator;
+        aho_corasick<pattern_iterator> ac ( boost::begin(patterns), boost::end (patterns));
+        return ac (boost::begin (corpus), boost::end (corpus));
+    }
+
+
+    //  Creator function -- take a range of patterns, return an object
+    template <typename PatternsRange>
+    boost::algorithm::aho_corasick<typename boost::range_iterator<const typename
+        boost::range_value<PatternsRange>::type>::type>
+    make_aho_corasick ( const PatternsRange &r ) {
+        return boost::algorithm::aho_corasick<typename boost::range_iterator<const typename
+            boost::range_value<PatternsRange>::type>::type> (boost::begin(r), boost::end(r));
+        }
+
+}}
+
+#endif  //  BOOST_ALGORITHM_AHO_CORASICK_SEARCH_HPP
@@ -0,0 +1,325 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+#ifndef BOOST_ALGORITHM_APPROXIMATE_SEARCH_HPP
+#define BOOST_ALGORITHM_APPROXIMATE_SEARCH_HPP
+
+#include <vector>
+#include <iterator>     // for std::iterator_traits
+#include <algorithm>    // for std::copy, std::fill
+
+#include <boost/assert.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/optional.hpp>
+
+#include <boost/range/begin.hpp>
+#include <boost/range/end.hpp>
+
+#include <boost/type_traits/is_same.hpp>
+
+#include <boost/algorithm/searching/match_mode.hpp>
+#include <boost/algorithm/searching/detail/bm_traits.hpp>
+
+namespace boost { namespace algorithm {
+
+//! What counts as an error in an approximate match
+    enum approximate_mode_type {
+        approximate_exact,          //!< No errors; an ordinary search
+        approximate_substitutions,  //!< Substitutions only (Hamming distance)
+        approximate_edits           //!< Substitutions, insertions and deletions (Levenshtein distance)
+    };
+
+//! An approximate match: where it ends, and how many errors it took
+    template <typename corpusIter>
+    struct approximate_match {
+        approximate_match ( corpusIter e, std::size_t err ) : end ( e ), errors ( err ) {}
+
+        corpusIter end;         //!< One past the last element of the match
+        std::size_t errors;     //!< The fewest errors of any match ending at `end`
+        };
+
+/*
+    The bit-parallel ("bitap", or Shift-And) algorithm of Baeza-Yates and
+    Gonnet, with the extension to k errors of Wu and Manber.
+
+    For each number of errors d in [0, k], the searcher keeps a bit vector
+    R_d, in which bit j is set when the first j+1 elements of the pattern
+    match a suffix of the corpus read so far with at most d errors. Each
+    element of the corpus updates all of them with a few shifts, ands and ors,
+    whatever the pattern looks like; a match ends wherever bit m-1 of R_k is
+    set, and the number of errors is the smallest d for which it is set in R_d.
+
+    The bit vectors are made of 64-bit words. Patterns of up to 64 elements
+    use a single word, and the inner loop is specialised for that; longer
+    patterns use as many words as they need, with the carries propagated from
+    one word to the next.
+
+Reference:
+    S. Wu and U. Manber, "Fast text searching allowing errors", CACM 35(10), 1992
+
+    Requirements:
+        * Random access iterators for the pattern
+        * Forward iterators for the corpus
+        * The two iterator types (patIter and corpusIter) must
+            "point to" the same underlying type, which must be hashable
+            (unless it is integral) and Equality Comparable.
+*/
+
+    template <typename patIter>
+    class bitap {
+        typedef typename std::iterator_traits<patIter>::value_type value_type;
+        typedef typename std::iterator_traits<patIter>::difference_type difference_type;
+        typedef boost::uint64_t word_type;
+        typedef typename detail::BM_traits<patIter>::skip_table_t row_table;
+        BOOST_STATIC_CONSTANT ( std::size_t, k_word_bits = 64 );
+    public:
+        bitap ( patIter first, patIter last, std::size_t max_errors = 0, approximate_mode_type mode = approximate_edits )
+                : k_pattern_length ( std::distance ( first, last )),
+                  k_max_errors ( mode == approximate_exact ? 0 : max_errors ),
+                  k_mode ( k_max_errors == 0 ? approximate_exact : mode ),
+                  words_ (( k_pattern_length + k_word_bits - 1 ) / k_word_bits ),
+                  rows_ ( k_pattern_length, 0 ) {
+        //  Row 0 of the masks is all zeros, for the elements that aren't in the pattern
+            masks_.assign ( words_, 0 );
+            for ( std::size_t j = 0; j < k_pattern_length; ++j ) {
+                difference_type row = rows_ [ first [ j ] ];
+                if ( row == 0 ) {
+                    row = static_cast<difference_type> ( masks_.size () / words_ );
+                    rows_.insert ( first [ j ], row );
+                    masks_.resize ( masks_.size () + words_, 0 );
+                    }
+                masks_ [ row * words_ + j / k_word_bits ] |= word_type ( 1 ) << ( j % k_word_bits );
+                }
+            }
+
+        ~bitap () {}
+
+        /// \fn operator ( corpusIter corpus_first, corpusIter corpus_last )
+        /// \brief Searches the corpus for the first approximate match of the pattern
+        ///
+        /// \param corpus_first The start of the data to search (Forward Iterator)
+        /// \param corpus_last  One past the end of the data to search
+        /// \return             The end of the first match and its number of errors,
+        ///                     or an empty optional if there is none.
+        ///
+        template <typename corpusIter>
+        boost::optional<approximate_match<corpusIter> >
+        operator () ( corpusIter corpus_first, corpusIter corpus_last ) const {
+            BOOST_STATIC_ASSERT (( boost::is_same<
+                typename std::iterator_traits<patIter>::value_type,
+                typename std::iterator_traits<corpusIter>::value_type>::value ));
+            typedef boost::optional<approximate_match<corpusIter> > result_type;
+
+            if ( k_pattern_length == 0 )    // empty pattern matches at start
+                return result_type ( approximate_match<corpusIter> ( corpus_first, 0 ));
+            result_type result;
+            if ( words_ == 1 )
+                do_search<true>  ( corpus_first, corpus_last, first_match_sink<corpusIter> ( result ), match_overlapping );
+            else
+                do_search<false> ( corpus_first, corpus_last, first_match_sink<corpusIter> ( result ), match_overlapping );
+            return result;
+            }
+
+        template <typename Range>
+        boost::optional<approximate_match<typename boost::range_iterator<Range>::type> >
+        operator () ( Range &r ) const {
+            return (*this) (boost::begin(r), boost::end(r));
+            }
+
+        /// \fn find_all ( corpusIter corpus_first, corpusIter corpus_last, OutputIterator out, match_mode_type mode )
+        /// \brief Finds every approximate match of the pattern in the corpus
+        ///
+        /// \param corpus_first The start of the data to search (Forward Iterator)
+        /// \param corpus_last  One past the end of the data to search
+        /// \param out          An output iterator which receives an approximate_match
+        ///                     for each position where a match ends
+        /// \param mode         Whether or not to report overlapping matches
+        ///
+        template <typename corpusIter, typename OutputIterator>
+        OutputIterator find_all ( corpusIter corpus_first, corpusIter corpus_last,
+                        OutputIterator out, match_mode_type mode = match_overlapping ) const {
+            BOOST_STATIC_ASSERT (( boost::is_same<
+                typename std::iterator_traits<patIter>::value_type,
+                typename std::iterator_traits<corpusIter>::value_type>::value ));
+            if ( k_pattern_length == 0 ) return out;    // empty pattern matches nothing here
+            if ( words_ == 1 )
+                return do_search<true>  ( corpus_first, corpus_last, all_matches_sink<corpusIter, OutputIterator> ( out ), mode ).out;
+            return do_search<false> ( corpus_first, corpus_last, all_matches_sink<corpusIter, OutputIterator> ( out ), mode ).out;
+            }
+
+        template <typename Range, typename OutputIterator>
+        OutputIterator find_all ( Range &r, OutputIterator out, match_mode_type mode = match_overlapping ) const {
+            return this->find_all (boost::begin(r), boost::end(r), out, mode);
+            }
+
+    //  The length of the pattern that was passed into the constructor
+        std::size_t pattern_length () const { return k_pattern_length; }
+
+    //  The largest number of errors that a match may have
+        std::size_t max_errors () const { return k_max_errors; }
+
+        approximate_mode_type mode () const { return k_mode; }
+
+    private:
+/// \cond DOXYGEN_HIDE
+        const std::size_t k_pattern_length;
+        const std::size_t k_max_errors;
+        const approximate_mode_type k_mode;
+        const std::size_t words_;           // words in each bit vector
+        row_table rows_;                    // element -> row of masks_
+        std::vector<word_type> masks_;      // one row of words_ words for each distinct element, plus one
+
+    //  Where the matches go; the search stops when the sink says so
+        template <typename corpusIter>
+        struct first_match_sink {
+            first_match_sink ( boost::optional<approximate_match<corpusIter> > &r ) : result ( r ) {}
+            bool operator () ( corpusIter end, std::size_t errors ) {
+                result = approximate_match<corpusIter> ( end, errors );
+                return false;
+                }
+            boost::optional<approximate_match<corpusIter> > &result;
+            };
+
+        template <typename corpusIter, typename OutputIterator>
+        struct all_matches_sink {
+            all_matches_sink ( OutputIterator o ) : out ( o ) {}
+            bool operator () ( corpusIter end, std::size_t errors ) {
+                *out++ = approximate_match<corpusIter> ( end, errors );
+                return true;
+                }
+            OutputIterator out;
+            };
+
+    //  R_d starts with the first d elements of the pattern matched (by deleting them)
+        void reset ( std::vector<word_type> &state ) const {
+            std::fill ( state.begin (), state.end (), word_type ( 0 ));
+            if ( k_mode != approximate_edits )
+                return;
+            for ( std::size_t d = 1; d <= k_max_errors; ++d )
+                for ( std::size_t j = 0; j < d && j < k_pattern_length; ++j )
+                    state [ d * words_ + j / k_word_bits ] |= word_type ( 1 ) << ( j % k_word_bits );
+            }
+
+        template <bool Single, typename corpusIter, typename Sink>
+        Sink do_search ( corpusIter corpus_first, corpusIter corpus_last, Sink sink, match_mode_type mode ) const {
+            const std::size_t k_words = Single ? 1 : words_;
+            const std::size_t k_last_word = ( k_pattern_length - 1 ) / k_word_bits;
+            const word_type k_match_bit = word_type ( 1 ) << (( k_pattern_length - 1 ) % k_word_bits );
+            const bool k_edits = k_mode == approximate_edits;
+
+        //  R_0 .. R_k, followed by two scratch vectors for the previous values of R_d and R_{d-1}
+            std::vector<word_type> state ( ( k_max_errors + 3 ) * k_words );
+            reset ( state );
+            word_type *scratch = &state [ ( k_max_errors + 1 ) * k_words ];
+
+            for ( corpusIter it = corpus_first; it != corpus_last; ) {
+                const word_type *mask = &masks_ [ rows_ [ *it ] * k_words ];
+                word_type *old_prev = scratch;              // R_{d-1}, before this element
+                word_type *old_cur  = scratch + k_words;    // R_d,     before this element
+                for ( std::size_t d = 0; d <= k_max_errors; ++d ) {
+                    word_type *cur = &state [ d * k_words ];
+                    const word_type *prev = d > 0 ? cur - k_words : NULL;  // R_{d-1}, after this element
+                    std::copy ( cur, cur + k_words, old_cur );
+                    for ( std::size_t w = 0; w < k_words; ++w ) {
+                    //  Match: extend with the element
+                        word_type r = (( old_cur [ w ] << 1 ) | ( w == 0 ? 1 : old_cur [ w - 1 ] >> ( k_word_bits - 1 ))) & mask [ w ];
+                        if ( d > 0 ) {
+                        //  Substitution: extend R_{d-1} with any element
+                            r |= ( old_prev [ w ] << 1 ) | ( w == 0 ? 1 : old_prev [ w - 1 ] >> ( k_word_bits - 1 ));
+                            if ( k_edits ) {
+                            //  Insertion: skip the element; deletion: skip a pattern element
+                                r |= old_prev [ w ];
+                                r |= ( prev [ w ] << 1 ) | ( w == 0 ? 0 : prev [ w - 1 ] >> ( k_word_bits - 1 ));
+                                }
+                            }
+                        cur [ w ] = r;
+                        }
+                    std::swap ( old_prev, old_cur );
+                    }
+
+                ++it;
+                if ( state [ k_max_errors * k_words + k_last_word ] & k_match_bit ) {
+                    std::size_t errors = 0;
+                    while ( !( state [ errors * k_words + k_last_word ] & k_match_bit ))
+                        ++errors;
+                    if ( !sink ( it, errors ))
+                        break;
+                    if ( mode == match_non_overlapping )
+                        reset ( state );
+                    }
+                }
+            return sink;
+            }
+/// \endcond
+        };
+
+    template <typename patIter>
+    const std::size_t bitap<patIter>::k_word_bits;
+
+
+/// \fn approximate_search ( corpusIter corpus_first, corpusIter corpus_last,
+///       patIter pat_first, patIter pat_last, std::size_t max_errors, approximate_mode_type mode )
+/// \brief Searches the corpus for the first match of the pattern with at most max_errors errors.
+///
+/// \param corpus_first The start of the data to search (Forward Iterator)
+/// \param corpus_last  One past the end of the data to search
+/// \param pat_first    The start of the pattern to search for (Random Access Iterator)
+/// \param pat_last     One past the end of the data to search for
+/// \param max_errors   The largest number of errors allowed in a match
+/// \param mode         What counts as an error
+///
+    template <typename patIter, typename corpusIter>
+    boost::optional<approximate_match<corpusIter> > approximate_search (
+                  corpusIter corpus_first, corpusIter corpus_last,
+                  patIter pat_first, patIter pat_last,
+                  std::size_t max_errors, approximate_mode_type mode = approximate_edits )
+    {
+        bitap<patIter> bp ( pat_first, pat_last, max_errors, mode );
+        return bp ( corpus_first, corpus_last );
+    }
+
+    template <typename PatternRange, typename corpusIter>
+    boost::optional<approximate_match<corpusIter> > approximate_search (
+                  corpusIter corpus_first, corpusIter corpus_last, const PatternRange &pattern,
+                  std::size_t max_errors, approximate_mode_type mode = approximate_edits )
+    {
+        typedef typename boost::range_iterator<const PatternRange>::type pattern_iterator;
+        bitap<pattern_iterator> bp ( boost::begin(pattern), boost::end (pattern), max_errors, mode );
+        return bp ( corpus_first, corpus_last );
+    }
+
+    template <typename PatternRange, typename CorpusRange>
+    boost::optional<approximate_match<typename boost::range_iterator<CorpusRange>::type> >
+    approximate_search ( CorpusRange &corpus, const PatternRange &pattern,
+                         std::size_t max_errors, approximate_mode_type mode = approximate_edits )
+    {
+        typedef typename boost::range_iterator<const PatternRange>::type pattern_iterator;
+        bitap<pattern_iterator> bp ( boost::begin(pattern), boost::end (pattern), max_errors, mode );
+        return bp (boost::begin (corpus), boost::end (corpus));
+    }
+
+
+    //  Creator functions -- take a pattern range, return an object
+    template <typename Range>
+    boost::algorithm::bitap<typename boost::range_iterator<const Range>::type>
+    make_bitap ( const Range &r, std::size_t max_errors = 0, approximate_mode_type mode = approximate_edits ) {
+        return boost::algorithm::bitap
+            <typename boost::range_iterator<const Range>::type> (boost::begin(r), boost::end(r), max_errors, mode);
+        }
+
+    template <typename Range>
+    boost::algorithm::bitap<typename boost::range_iterator<Range>::type>
+    make_bitap ( Range &r, std::size_t max_errors = 0, approximate_mode_type mode = approximate_edits ) {
+        return boost::algorithm::bitap
+            <typename boost::range_iterator<Range>::type> (boost::begin(r), boost::end(r), max_errors, mode);
+        }
+}}
+
+#endif  //  BOOST_ALGORITHM_APPROXIMATE_SEARCH_HPP
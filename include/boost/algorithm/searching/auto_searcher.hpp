@@ -0,0 +1,438 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+#ifndef BOOST_ALGORITHM_AUTO_SEARCHER_HPP
+#define BOOST_ALGORITHM_AUTO_SEARCHER_HPP
+
+#include <cstddef>      // for std::size_t
+#include <cstring>      // for std::memchr
+#include <iterator>     // for std::iterator_traits
+#include <algorithm>    // for std::find, std::sort, std::unique
+#include <vector>
+
+#include <boost/assert.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/make_shared.hpp>
+
+#include <boost/range/begin.hpp>
+#include <boost/range/end.hpp>
+
+#include <boost/utility/enable_if.hpp>
+#include <boost/type_traits/integral_constant.hpp>
+#include <boost/type_traits/is_same.hpp>
+#include <boost/type_traits/remove_cv.hpp>
+
+#include <boost/algorithm/searching/boyer_moore.hpp>
+#include <boost/algorithm/searching/boyer_moore_horspool.hpp>
+#include <boost/algorithm/searching/two_way.hpp>
+#include <boost/algorithm/searching/detail/simd.hpp>
+#include <boost/algorithm/searching/detail/match_counter.hpp>
+#include <boost/algorithm/searching/match_mode.hpp>
+
+//  The default thresholds. These came from bench/search_bench on x86-64 with
+//  SSE2; to tune them for another machine, run the benchmark there and define
+//  these before including this header (or pass an auto_search_thresholds).
+#ifndef BOOST_ALGORITHM_AUTO_SEARCH_SIMD_MAX_LENGTH
+#define BOOST_ALGORITHM_AUTO_SEARCH_SIMD_MAX_LENGTH             16
+#endif
+#ifndef BOOST_ALGORITHM_AUTO_SEARCH_BOYER_MOORE_MIN_LENGTH
+#define BOOST_ALGORITHM_AUTO_SEARCH_BOYER_MOORE_MIN_LENGTH      256
+#endif
+#ifndef BOOST_ALGORITHM_AUTO_SEARCH_BOYER_MOORE_MIN_ALPHABET
+#define BOOST_ALGORITHM_AUTO_SEARCH_BOYER_MOORE_MIN_ALPHABET    64
+#endif
+#ifndef BOOST_ALGORITHM_AUTO_SEARCH_BOYER_MOORE_ANY_ALPHABET_LENGTH
+#define BOOST_ALGORITHM_AUTO_SEARCH_BOYER_MOORE_ANY_ALPHABET_LENGTH 1024
+#endif
+#ifndef BOOST_ALGORITHM_AUTO_SEARCH_PERIODIC_REPEATS
+#define BOOST_ALGORITHM_AUTO_SEARCH_PERIODIC_REPEATS            4
+#endif
+#ifndef BOOST_ALGORITHM_AUTO_SEARCH_TABLE_CORPUS_RATIO
+#define BOOST_ALGORITHM_AUTO_SEARCH_TABLE_CORPUS_RATIO          8
+#endif
+
+namespace boost { namespace algorithm {
+
+/*
+    A searcher that looks at the pattern, and picks one of the other searchers
+    to do the work.
+
+    The constructor measures the length of the pattern, the number of distinct
+    elements in it (its alphabet) and its smallest period, and then chooses:
+
+        engine_memchr       a single byte:  std::memchr
+        engine_simd         a short pattern of bytes: the vectorized filter
+                                from detail/simd.hpp, which needs no tables
+        engine_two_way      a highly periodic pattern (one that is its period
+                                repeated several times), where the skip loops
+                                can go quadratic: the linear-time Two-Way searcher
+        engine_boyer_moore  a long pattern with a large alphabet (or a very
+                                long one): Boyer-Moore, whose good suffix table
+                                pays for itself there
+        engine_horspool     everything else: Boyer-Moore-Horspool
+
+    Where the chosen engine needs contiguous bytes (memchr, simd) and the
+    corpus is not, the search falls back to std::find and Two-Way.
+
+    The thresholds are in an auto_search_thresholds, which can be passed to the
+    constructor. If the length of the corpus is known when the searcher is
+    built (as it is in the free function auto_search), it can be passed in as
+    well; when the corpus isn't much longer than the pattern, building a skip
+    table doesn't pay, and a table-free engine is used instead.
+
+    Requirements:
+        * Random access iterators
+        * The two iterator types (patIter and corpusIter) must
+            "point to" the same underlying type.
+        * That type must be LessThan Comparable (to measure the alphabet,
+            and for Two-Way) and Equality Comparable.
+        * Additional requirements may be imposed by the skip tables of
+            boyer_moore and boyer_moore_horspool.
+*/
+
+    enum auto_search_engine {
+        engine_memchr,
+        engine_simd,
+        engine_horspool,
+        engine_boyer_moore,
+        engine_two_way
+        };
+
+    inline const char *auto_search_engine_name ( auto_search_engine e ) {
+        switch ( e ) {
+            case engine_memchr:         return "memchr";
+            case engine_simd:           return "simd";
+            case engine_horspool:       return "boyer_moore_horspool";
+            case engine_boyer_moore:    return "boyer_moore";
+            case engine_two_way:        return "two_way";
+            }
+        return "unknown";
+        }
+
+/*!
+    \struct auto_search_thresholds
+    \brief  The lengths and sizes at which auto_searcher changes engines
+*/
+struct auto_search_thresholds {
+    auto_search_thresholds ()
+        : simd_max_length ( BOOST_ALGORITHM_AUTO_SEARCH_SIMD_MAX_LENGTH ),
+          boyer_moore_min_length ( BOOST_ALGORITHM_AUTO_SEARCH_BOYER_MOORE_MIN_LENGTH ),
+          boyer_moore_min_alphabet ( BOOST_ALGORITHM_AUTO_SEARCH_BOYER_MOORE_MIN_ALPHABET ),
+          boyer_moore_any_alphabet_length ( BOOST_ALGORITHM_AUTO_SEARCH_BOYER_MOORE_ANY_ALPHABET_LENGTH ),
+          periodic_repeats ( BOOST_ALGORITHM_AUTO_SEARCH_PERIODIC_REPEATS ),
+          table_corpus_ratio ( BOOST_ALGORITHM_AUTO_SEARCH_TABLE_CORPUS_RATIO ) {}
+
+    std::size_t simd_max_length;                //  byte patterns up to this long use engine_simd
+    std::size_t boyer_moore_min_length;         //  with an alphabet of at least boyer_moore_min_alphabet,
+    std::size_t boyer_moore_min_alphabet;       //      patterns this long use engine_boyer_moore
+    std::size_t boyer_moore_any_alphabet_length;//  patterns this long use engine_boyer_moore whatever the alphabet
+    std::size_t periodic_repeats;               //  patterns that repeat their period this many times use engine_two_way (0: never)
+    std::size_t table_corpus_ratio;             //  no skip tables unless the corpus is this many times longer than the pattern
+    };
+
+
+    template <typename patIter>
+    class auto_searcher {
+        typedef typename std::iterator_traits<patIter>::difference_type difference_type;
+        typedef typename std::iterator_traits<patIter>::value_type value_type;
+        typedef boyer_moore<patIter> bm_type;
+        typedef boyer_moore_horspool<patIter> bmh_type;
+
+        BOOST_STATIC_CONSTANT ( bool, k_bytes = detail::is_byte_type<typename boost::remove_cv<value_type>::type>::value );
+
+    public:
+        auto_searcher ( patIter first, patIter last,
+                        const auto_search_thresholds &thresholds = auto_search_thresholds (),
+                        std::size_t corpus_length = 0 )
+                : pat_first ( first ), pat_last ( last ),
+                  k_pattern_length ( std::distance ( pat_first, pat_last )),
+                  thresholds_ ( thresholds ), alphabet_size_ ( 0 ), period_ ( 0 ),
+                  two_way_ ( first, last ) {
+            const std::size_t m = k_pattern_length;
+            const bool k_small_corpus = corpus_length != 0 &&
+                    corpus_length / ( thresholds_.table_corpus_ratio == 0 ? 1 : thresholds_.table_corpus_ratio ) < m;
+
+        //  Short patterns of bytes are decided on their length alone
+            if ( m == 0 )
+                engine_ = engine_two_way;
+            else if ( k_bytes && m == 1 )
+                engine_ = engine_memchr;
+            else if ( k_bytes && ( m <= thresholds_.simd_max_length || k_small_corpus ))
+                engine_ = engine_simd;
+            else if ( k_small_corpus )
+                engine_ = engine_two_way;
+            else {
+                alphabet_size_ = this->count_alphabet ( boost::integral_constant<bool, k_bytes> ());
+                period_        = this->find_period ();
+                if ( thresholds_.periodic_repeats != 0 && period_ <= m / thresholds_.periodic_repeats )
+                    engine_ = engine_two_way;
+                else if ( m >= thresholds_.boyer_moore_any_alphabet_length ||
+                        ( m >= thresholds_.boyer_moore_min_length && alphabet_size_ >= thresholds_.boyer_moore_min_alphabet ))
+                    engine_ = engine_boyer_moore;
+                else
+                    engine_ = engine_horspool;
+                }
+
+            if ( engine_ == engine_boyer_moore )
+                bm_ = boost::make_shared<const bm_type> ( first, last );
+            else if ( engine_ == engine_horspool )
+                bmh_ = boost::make_shared<const bmh_type> ( first, last );
+            }
+
+        ~auto_searcher () {}
+
+        /// \fn operator ( corpusIter corpus_first, corpusIter corpus_last )
+        /// \brief Searches the corpus for the pattern that was passed into the constructor
+        ///
+        /// \param corpus_first The start of the data to search (Random Access Iterator)
+        /// \param corpus_last  One past the end of the data to search
+        ///
+        template <typename corpusIter>
+        corpusIter operator () ( corpusIter corpus_first, corpusIter corpus_last ) const {
+            BOOST_STATIC_ASSERT (( boost::is_same<
+                typename std::iterator_traits<patIter>::value_type,
+                typename std::iterator_traits<corpusIter>::value_type>::value ));
+
+            switch ( engine_ ) {
+                case engine_memchr:
+                case engine_simd:
+                    return this->do_search ( corpus_first, corpus_last, detail::use_simd_search<corpusIter> ());
+                case engine_horspool:
+                    return (*bmh_) ( corpus_first, corpus_last );
+                case engine_boyer_moore:
+                    return (*bm_) ( corpus_first, corpus_last );
+                case engine_two_way:
+                    break;
+                }
+            return two_way_ ( corpus_first, corpus_last );
+            }
+
+        template <typename Range>
+        typename boost::range_iterator<Range>::type operator () ( Range &r ) const {
+            return (*this) (boost::begin(r), boost::end(r));
+            }
+
+        /// \fn find_all ( corpusIter corpus_first, corpusIter corpus_last, OutputIterator out, match_mode_type mode )
+        /// \brief Finds every occurrence of the pattern in the corpus
+        ///
+        /// \param corpus_first The start of the data to search (Random Access Iterator)
+        /// \param corpus_last  One past the end of the data to search
+        /// \param out          An output iterator which receives the start of each match
+        /// \param mode         Whether or not to report overlapping matches
+        ///
+        template <typename corpusIter, typename OutputIterator>
+        OutputIterator find_all ( corpusIter corpus_first, corpusIter corpus_last,
+                        OutputIterator out, match_mode_type mode = match_overlapping ) const {
+            BOOST_STATIC_ASSERT (( boost::is_same<
+                typename std::iterator_traits<patIter>::value_type,
+                typename std::iterator_traits<corpusIter>::value_type>::value ));
+
+            switch ( engine_ ) {
+                case engine_memchr:
+                case engine_simd:
+                    return this->do_find_all ( corpus_first, corpus_last, out, mode, detail::use_simd_search<corpusIter> ());
+                case engine_horspool:
+                    return bmh_->find_all ( corpus_first, corpus_last, out, mode );
+                case engine_boyer_moore:
+                    return bm_->find_all ( corpus_first, corpus_last, out, mode );
+                case engine_two_way:
+                    break;
+                }
+            return two_way_.find_all ( corpus_first, corpus_last, out, mode );
+            }
+
+        template <typename Range, typename OutputIterator>
+        OutputIterator find_all ( Range &r, OutputIterator out, match_mode_type mode = match_overlapping ) const {
+            return this->find_all (boost::begin(r), boost::end(r), out, mode);
+            }
+
+        /// \fn count ( corpusIter corpus_first, corpusIter corpus_last, match_mode_type mode )
+        /// \brief Counts the occurrences of the pattern in the corpus
+        ///
+        /// \param corpus_first The start of the data to search (Random Access Iterator)
+        /// \param corpus_last  One past the end of the data to search
+        /// \param mode         Whether or not to count overlapping matches
+        ///
+        template <typename corpusIter>
+        std::size_t count ( corpusIter corpus_first, corpusIter corpus_last, match_mode_type mode = match_overlapping ) const {
+            return detail::count_matches ( *this, pat_first, corpus_first, corpus_last, mode, detail::use_simd_search<corpusIter> ());
+            }
+
+        template <typename Range>
+        std::size_t count ( Range &r, match_mode_type mode = match_overlapping ) const {
+            return this->count (boost::begin(r), boost::end(r), mode);
+            }
+
+    //  What the constructor chose, and what it based that on. The alphabet
+    //  and period are only measured when the length alone doesn't decide;
+    //  otherwise they are zero.
+        auto_search_engine engine () const { return engine_; }
+        const char *engine_name () const { return auto_search_engine_name ( engine_ ); }
+        std::size_t pattern_length () const { return k_pattern_length; }
+        std::size_t alphabet_size () const { return alphabet_size_; }
+        std::size_t period () const { return period_; }
+        const auto_search_thresholds &thresholds () const { return thresholds_; }
+
+    private:
+/// \cond DOXYGEN_HIDE
+        patIter pat_first, pat_last;
+        std::size_t k_pattern_length;
+        auto_search_thresholds thresholds_;
+        std::size_t alphabet_size_;
+        std::size_t period_;
+        auto_search_engine engine_;
+        two_way<patIter> two_way_;                  // always there; it costs nothing to build
+        boost::shared_ptr<const bm_type>  bm_;      // only for engine_boyer_moore
+        boost::shared_ptr<const bmh_type> bmh_;     // only for engine_horspool
+
+    //  The number of distinct elements in the pattern
+        std::size_t count_alphabet ( boost::true_type ) const {
+            bool seen [ 256 ] = { false };
+            std::size_t retVal = 0;
+            for ( patIter iter = pat_first; iter != pat_last; ++iter ) {
+                bool &s = seen [ static_cast<unsigned char> ( *iter ) ];
+                if ( !s ) { s = true; ++retVal; }
+                }
+            return retVal;
+            }
+
+        std::size_t count_alphabet ( boost::false_type ) const {
+            std::vector<value_type> elements ( pat_first, pat_last );
+            std::sort ( elements.begin (), elements.end ());
+            return std::unique ( elements.begin (), elements.end ()) - elements.begin ();
+            }
+
+    //  The smallest period of the pattern: its length less its longest border
+        std::size_t find_period () const {
+            const std::size_t m = k_pattern_length;
+            std::vector<std::size_t> border ( m + 1 );
+            border [ 0 ] = 0;
+            std::size_t k = 0;
+            for ( std::size_t i = 1; i < m; ++i ) {
+                while ( k > 0 && !( pat_first [ i ] == pat_first [ k ] ))
+                    k = border [ k ];
+                if ( pat_first [ i ] == pat_first [ k ] )
+                    ++k;
+                border [ i + 1 ] = k;
+                }
+            return m - border [ m ];
+            }
+
+    //  Contiguous bytes: memchr, or the vectorized filter
+        template <typename corpusIter>
+        corpusIter do_search ( corpusIter corpus_first, corpusIter corpus_last, boost::true_type ) const {
+            const std::size_t n = std::distance ( corpus_first, corpus_last );
+            if ( n < k_pattern_length || n == 0 )
+                return corpus_last;
+            const unsigned char *first = detail::as_bytes ( corpus_first );
+            return corpus_first + ( detail::simd_search ( first, first + n, pat_first, k_pattern_length ) - first );
+            }
+
+    //  Anything else: std::find, or Two-Way
+        template <typename corpusIter>
+        corpusIter do_search ( corpusIter corpus_first, corpusIter corpus_last, boost::false_type ) const {
+            if ( engine_ == engine_memchr )
+                return std::find ( corpus_first, corpus_last, *pat_first );
+            return two_way_ ( corpus_first, corpus_last );
+            }
+
+        template <typename corpusIter, typename OutputIterator>
+        OutputIterator do_find_all ( corpusIter corpus_first, corpusIter corpus_last,
+                        OutputIterator out, match_mode_type mode, boost::true_type ) const {
+            const std::size_t n = std::distance ( corpus_first, corpus_last );
+            if ( n < k_pattern_length || n == 0 )
+                return out;
+            const unsigned char *first = detail::as_bytes ( corpus_first );
+            const unsigned char *last  = first + n;
+            const std::size_t k_step = mode == match_overlapping ? 1 : k_pattern_length;
+            const unsigned char *curPos = first;
+
+            while ( static_cast<std::size_t> ( last - curPos ) >= k_pattern_length ) {
+                const unsigned char *found = detail::simd_search ( curPos, last, pat_first, k_pattern_length );
+                if ( found == last )
+                    break;
+                *out++ = corpus_first + ( found - first );
+                curPos = found + k_step;
+                }
+            return out;
+            }
+
+        template <typename corpusIter, typename OutputIterator>
+        OutputIterator do_find_all ( corpusIter corpus_first, corpusIter corpus_last,
+                        OutputIterator out, match_mode_type mode, boost::false_type ) const {
+            return two_way_.find_all ( corpus_first, corpus_last, out, mode );
+            }
+// \endcond
+        };
+
+/*  Two ranges as inputs gives us four possibilities; with 2,3,3,4 parameters
+    Use a bit of TMP to disambiguate the 3-argument templates */
+
+/// \fn auto_search ( corpusIter corpus_first, corpusIter corpus_last,
+///       patIter pat_first, patIter pat_last )
+/// \brief Searches the corpus for the pattern, with whichever searcher suits it.
+///
+/// \param corpus_first The start of the data to search (Random Access Iterator)
+/// \param corpus_last  One past the end of the data to search
+/// \param pat_first    The start of the pattern to search for (Random Access Iterator)
+/// \param pat_last     One past the end of the data to search for
+///
+    template <typename patIter, typename corpusIter>
+    corpusIter auto_search (
+                  corpusIter corpus_first, corpusIter corpus_last,
+                  patIter pat_first, patIter pat_last )
+    {
+        auto_searcher<patIter> as ( pat_first, pat_last, auto_search_thresholds (),
+                                    std::distance ( corpus_first, corpus_last ));
+        return as ( corpus_first, corpus_last );
+    }
+
+    template <typename PatternRange, typename corpusIter>
+    corpusIter auto_search (
+        corpusIter corpus_first, corpusIter corpus_last, const PatternRange &pattern )
+    {
+        return auto_search ( corpus_first, corpus_last, boost::begin(pattern), boost::end (pattern));
+    }
+
+    template <typename patIter, typename CorpusRange>
+    typename boost::lazy_disable_if_c<
+        boost::is_same<CorpusRange, patIter>::value, typename boost::range_iterator<CorpusRange> >
+    ::type
+    auto_search ( CorpusRange &corpus, patIter pat_first, patIter pat_last )
+    {
+        return auto_search ( boost::begin (corpus), boost::end (corpus), pat_first, pat_last );
+    }
+
+    template <typename PatternRange, typename CorpusRange>
+    typename boost::range_iterator<CorpusRange>::type
+    auto_search ( CorpusRange &corpus, const PatternRange &pattern )
+    {
+        return auto_search ( boost::begin (corpus), boost::end (corpus), boost::begin(pattern), boost::end (pattern));
+    }
+
+
+    //  Creator functions -- take a pattern range, return an object
+    template <typename Range>
+    boost::algorithm::auto_searcher<typename boost::range_iterator<const Range>::type>
+    make_auto_searcher ( const Range &r ) {
+        return boost::algorithm::auto_searcher
+            <typename boost::range_iterator<const Range>::type> (boost::begin(r), boost::end(r));
+        }
+
+    template <typename Range>
+    boost::algorithm::auto_searcher<typename boost::range_iterator<Range>::type>
+    make_auto_searcher ( Range &r ) {
+        return boost::algorithm::auto_searcher
+            <typename boost::range_iterator<Range>::type> (boost::begin(r), boost::end(r));
+        }
+
+}}
+
+#endif  //  BOOST_ALGORITHM_AUTO_SEARCHER_HPP
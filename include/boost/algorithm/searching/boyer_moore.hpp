@@ -10,7 +10,8 @@
 #ifndef BOOST_ALGORITHM_BOYER_MOORE_SEARCH_HPP
 #define BOOST_ALGORITHM_BOYER_MOORE_SEARCH_HPP
 
-#include <iterator>     // for std::iterator_traits
+#include <vector>
+#include <iterator>     // for std::iterator_traits, std::reverse_iterator
 
 #include <boost/assert.hpp>
 #include <boost/static_assert.hpp>
@@ -23,6 +24,11 @@
 
 #include <boost/algorithm/searching/detail/bm_traits.hpp>
 #include <boost/algorithm/searching/detail/debugging.hpp>
+#include <boost/algorithm/searching/detail/match_counter.hpp>
+#include <boost/algorithm/searching/detail/simd.hpp>
+#include <boost/algorithm/searching/instrumentation.hpp>
+#include <boost/algorithm/searching/match_mode.hpp>
+#include <boost/algorithm/searching/segmented_iterator.hpp>
 
 namespace boost { namespace algorithm {
 
@@ -50,17 +56,27 @@ Requirements:
         * Additional requirements may be imposed but the skip table, such as:
         ** Numeric type (array-based skip table)
         ** Hashable type (map-based skip table)
+
+Everything the searcher allocates - the tables, and the temporaries used to
+build them - comes from the allocator in the traits (BM_traits<patIter, Alloc>),
+so a searcher can be built in an arena without touching the global heap.
+
+The Instrumentation policy (see instrumentation.hpp) is told about each
+comparison, shift, verification and match; the default does nothing.
 */
 
-    template <typename patIter, typename traits = detail::BM_traits<patIter> >
+    template <typename patIter, typename traits = detail::BM_traits<patIter>,
+              typename Instrumentation = no_instrumentation>
     class boyer_moore {
         typedef typename std::iterator_traits<patIter>::difference_type difference_type;
     public:
-        boyer_moore ( patIter first, patIter last ) 
+        typedef typename detail::traits_allocator<traits>::type allocator_type;
+
+        boyer_moore ( patIter first, patIter last, const allocator_type &alloc = allocator_type ())
                 : pat_first ( first ), pat_last ( last ),
                   k_pattern_length ( std::distance ( pat_first, pat_last )),
-                  skip_ ( k_pattern_length, -1 ),
-                  suffix_ ( k_pattern_length + 1 )
+                  skip_ ( detail::traits_allocator<traits>::make_skip_table ( k_pattern_length, -1, alloc )),
+                  suffix_ ( k_pattern_length + 1, 0, difference_allocator ( alloc ))
             {
             this->build_skip_table   ( first, last );
             this->build_suffix_table ( first, last );
@@ -89,7 +105,7 @@ Requirements:
                 return corpus_last;
 
         //  Do the search 
-            return this->do_search   ( corpus_first, corpus_last );
+            return this->do_search   ( corpus_first, corpus_last, typename detail::segmented_dispatch<corpusIter>::type ());
             }
             
         template <typename Range>
@@ -97,12 +113,84 @@ Requirements:
             return (*this) (boost::begin(r), boost::end(r));
             }
 
+        /// \fn find_all ( corpusIter corpus_first, corpusIter corpus_last, OutputIterator out, match_mode_type mode )
+        /// \brief Finds every occurrence of the pattern in the corpus
+        /// 
+        /// \param corpus_first The start of the data to search (Random Access Iterator)
+        /// \param corpus_last  One past the end of the data to search
+        /// \param out          An output iterator which receives the start of each match
+        /// \param mode         Whether or not to report overlapping matches
+        ///
+        /// The search keeps its state from one match to the next, and uses the
+        /// Galil rule after each match, so the search is linear in the size
+        /// of the corpus, even for periodic patterns.
+        ///
+        template <typename corpusIter, typename OutputIterator>
+        OutputIterator find_all ( corpusIter corpus_first, corpusIter corpus_last, 
+                        OutputIterator out, match_mode_type mode = match_overlapping ) const {
+            BOOST_STATIC_ASSERT (( boost::is_same<
+                                    typename std::iterator_traits<patIter>::value_type, 
+                                    typename std::iterator_traits<corpusIter>::value_type>::value ));
+
+            if ( corpus_first == corpus_last ) return out;  // if nothing to search, we didn't find it!
+            if (    pat_first ==    pat_last ) return out;  // empty pattern matches nothing here
+
+            const difference_type k_corpus_length  = std::distance ( corpus_first, corpus_last );
+        //  If the pattern is larger than the corpus, we can't find it!
+            if ( k_corpus_length < k_pattern_length ) 
+                return out;
+
+            return this->do_find_all ( corpus_first, corpus_last, out, mode, typename detail::segmented_dispatch<corpusIter>::type ());
+            }
+
+        template <typename Range, typename OutputIterator>
+        OutputIterator find_all ( Range &r, OutputIterator out, match_mode_type mode = match_overlapping ) const {
+            return this->find_all (boost::begin(r), boost::end(r), out, mode);
+            }
+
+        /// \fn count ( corpusIter corpus_first, corpusIter corpus_last, match_mode_type mode )
+        /// \brief Counts the occurrences of the pattern in the corpus
+        ///
+        /// \param corpus_first The start of the data to search (Random Access Iterator)
+        /// \param corpus_last  One past the end of the data to search
+        /// \param mode         Whether or not to count overlapping matches
+        ///
+        template <typename corpusIter>
+        std::size_t count ( corpusIter corpus_first, corpusIter corpus_last, match_mode_type mode = match_overlapping ) const {
+            return detail::count_matches ( *this, pat_first, corpus_first, corpus_last, mode,
+                        boost::integral_constant<bool, detail::use_simd_search<corpusIter>::value &&
+                            boost::is_same<Instrumentation, no_instrumentation>::value> ());
+            }
+
+        template <typename Range>
+        std::size_t count ( Range &r, match_mode_type mode = match_overlapping ) const {
+            return this->count (boost::begin(r), boost::end(r), mode);
+            }
+
+    //  The length of the pattern that was passed into the constructor
+        std::size_t pattern_length () const { return k_pattern_length; }
+
+    //  The instrumentation policy object
+        const Instrumentation &instrumentation () const { return instr_; }
+        Instrumentation &instrumentation () { return instr_; }
+
     private:
 /// \cond DOXYGEN_HIDE
+        typedef typename boost::allocator_rebind<allocator_type, difference_type>::type difference_allocator;
+        typedef std::vector <difference_type, difference_allocator> difference_vector;
+
         patIter pat_first, pat_last;
         const difference_type k_pattern_length;
         typename traits::skip_table_t skip_;
-        std::vector <difference_type> suffix_;
+        difference_vector suffix_;
+        Instrumentation instr_;
+
+    //  Compare a pattern element with a corpus element, and tell the instrumentation
+        template <typename T, typename U>
+        bool compare ( const T &lhs, const U &rhs ) const {
+            instr_.compare ();
+            return lhs == rhs;
+            }
 
         /// \fn operator ( corpusIter corpus_first, corpusIter corpus_last, Pred p )
         /// \brief Searches the corpus for the pattern that was passed into the constructor
@@ -112,7 +200,18 @@ Requirements:
         /// \param p            A predicate used for the search comparisons.
         ///
         template <typename corpusIter>
-        corpusIter do_search ( corpusIter corpus_first, corpusIter corpus_last ) const {
+        corpusIter do_search ( corpusIter corpus_first, corpusIter corpus_last, boost::false_type ) const {
+            typedef typename traits::skip_table_t table_type;
+            switch ( detail::skip_width ( skip_ )) {
+                case 1:  return this->search_loop ( corpus_first, corpus_last, detail::skip_view<table_type, 1>::make ( skip_ ));
+                case 2:  return this->search_loop ( corpus_first, corpus_last, detail::skip_view<table_type, 2>::make ( skip_ ));
+                default: return this->search_loop ( corpus_first, corpus_last, detail::skip_view<table_type, 0>::make ( skip_ ));
+                }
+            }
+
+    //  The search itself, with the skip table's width already chosen
+        template <typename corpusIter, typename Skip>
+        corpusIter search_loop ( corpusIter corpus_first, corpusIter corpus_last, const Skip &skip ) const {
         /*  ---- Do the matching ---- */
             corpusIter curPos = corpus_first;
             const corpusIter lastPos = corpus_last - k_pattern_length;
@@ -121,26 +220,97 @@ Requirements:
             while ( curPos <= lastPos ) {
         /*  while ( std::distance ( curPos, corpus_last ) >= k_pattern_length ) { */
             //  Do we match right where we are?
+                instr_.verify ();
                 j = k_pattern_length;
-                while ( pat_first [j-1] == curPos [j-1] ) {
+                while ( this->compare ( pat_first [j-1], curPos [j-1] )) {
                     j--;
                 //  We matched - we're done!
-                    if ( j == 0 )
+                    if ( j == 0 ) {
+                        instr_.match ();
                         return curPos;
+                        }
                     }
                 
             //  Since we didn't match, figure out how far to skip forward
-                k = skip_ [ curPos [ j - 1 ]];
+                k = skip [ curPos [ j - 1 ]];
                 m = j - k - 1;
-                if ( k < j && m > suffix_ [ j ] )
-                    curPos += m;
-                else
-                    curPos += suffix_ [ j ];
+                const difference_type shift = ( k < j && m > suffix_ [ j ] ) ? m : suffix_ [ j ];
+                instr_.shift ( shift );
+                curPos += shift;
                 }
         
             return corpus_last;     // We didn't find anything
             }
 
+        template <typename corpusIter>
+        corpusIter do_search ( corpusIter corpus_first, corpusIter corpus_last, detail::segmented_iterator_tag ) const {
+            return detail::segmented_search ( *this, corpus_first, corpus_last );
+            }
+
+        template <typename corpusIter, typename OutputIterator>
+        OutputIterator do_find_all ( corpusIter corpus_first, corpusIter corpus_last, 
+                                        OutputIterator out, match_mode_type mode, detail::segmented_iterator_tag ) const {
+            return detail::segmented_find_all ( *this, corpus_first, corpus_last, out, mode );
+            }
+
+        template <typename corpusIter, typename OutputIterator>
+        OutputIterator do_find_all ( corpusIter corpus_first, corpusIter corpus_last, 
+                                        OutputIterator out, match_mode_type mode, boost::false_type ) const {
+            typedef typename traits::skip_table_t table_type;
+            switch ( detail::skip_width ( skip_ )) {
+                case 1:  return this->find_all_loop ( corpus_first, corpus_last, out, mode, detail::skip_view<table_type, 1>::make ( skip_ ));
+                case 2:  return this->find_all_loop ( corpus_first, corpus_last, out, mode, detail::skip_view<table_type, 2>::make ( skip_ ));
+                default: return this->find_all_loop ( corpus_first, corpus_last, out, mode, detail::skip_view<table_type, 0>::make ( skip_ ));
+                }
+            }
+
+        template <typename corpusIter, typename OutputIterator, typename Skip>
+        OutputIterator find_all_loop ( corpusIter corpus_first, corpusIter corpus_last,
+                                        OutputIterator out, match_mode_type mode, const Skip &skip ) const {
+            corpusIter curPos = corpus_first;
+            difference_type remaining = std::distance ( corpus_first, corpus_last ) - k_pattern_length;
+            const difference_type k_period = suffix_ [ 0 ];
+            difference_type known = 0;  // leading elements known to match at curPos (Galil rule)
+            difference_type j, k, m, shift;
+
+            while ( true ) {
+            //  Do we match right where we are?
+                instr_.verify ();
+                j = k_pattern_length;
+                while ( j > known && this->compare ( pat_first [j-1], curPos [j-1] ))
+                    j--;
+
+                if ( j == known ) {
+                    instr_.match ();
+                    *out++ = curPos;
+                //  After shifting by the period of the pattern, the first
+                //  (length - period) elements are already known to match.
+                    if ( mode == match_overlapping ) {
+                        shift = k_period;
+                        known = k_pattern_length - k_period;
+                        }
+                    else {
+                        shift = k_pattern_length;
+                        known = 0;
+                        }
+                    }
+                else {
+                    k = skip [ curPos [ j - 1 ]];
+                    m = j - k - 1;
+                    shift = ( k < j && m > suffix_ [ j ] ) ? m : suffix_ [ j ];
+                    known = 0;
+                    }
+
+                if ( shift > remaining )
+                    break;
+                instr_.shift ( shift );
+                curPos    += shift;
+                remaining -= shift;
+                }
+
+            return out;
+            }
+
 
         void build_skip_table ( patIter first, patIter last ) {
             for ( std::size_t i = 0; first != last; ++first, ++i )
@@ -173,14 +343,13 @@ Requirements:
             const std::size_t count = (std::size_t) std::distance ( pat_first, pat_last );
             
             if ( count > 0 ) {  // empty pattern
-                std::vector<typename std::iterator_traits<patIter>::value_type> reversed(count);
-                (void) std::reverse_copy ( pat_first, pat_last, reversed.begin ());
-                
-                std::vector<difference_type> prefix (count);
+                difference_vector prefix ( count, 0, suffix_.get_allocator ());
                 compute_bm_prefix ( pat_first, pat_last, prefix );
         
-                std::vector<difference_type> prefix_reversed (count);
-                compute_bm_prefix ( reversed.begin (), reversed.end (), prefix_reversed );
+            //  The pattern is random access, so it can be read backwards in place
+                typedef std::reverse_iterator<patIter> reversed_iterator;
+                difference_vector prefix_reversed ( count, 0, suffix_.get_allocator ());
+                compute_bm_prefix ( reversed_iterator ( pat_last ), reversed_iterator ( pat_first ), prefix_reversed );
                 
                 for ( std::size_t i = 0; i <= count; i++ )
                     suffix_[i] = count - prefix [count-1];
@@ -215,8 +384,8 @@ Requirements:
                   corpusIter corpus_first, corpusIter corpus_last, 
                   patIter pat_first, patIter pat_last )
     {
-        boyer_moore<patIter> bm ( pat_first, pat_last );
-        return bm ( corpus_first, corpus_last );
+        return detail::one_shot_search<boyer_moore<patIter> > ( corpus_first, corpus_last,
+                    pat_first, pat_last, typename detail::simd_search_kind<corpusIter>::type ());
     }
 
     template <typename PatternRange, typename corpusIter>
@@ -224,8 +393,8 @@ Requirements:
         corpusIter corpus_first, corpusIter corpus_last, const PatternRange &pattern )
     {
         typedef typename boost::range_iterator<const PatternRange>::type pattern_iterator;
-        boyer_moore<pattern_iterator> bm ( boost::begin(pattern), boost::end (pattern));
-        return bm ( corpus_first, corpus_last );
+        return detail::one_shot_search<boyer_moore<pattern_iterator> > ( corpus_first, corpus_last,
+                    boost::begin(pattern), boost::end (pattern), typename detail::simd_search_kind<corpusIter>::type ());
     }
     
     template <typename patIter, typename CorpusRange>
@@ -234,8 +403,9 @@ Requirements:
     ::type
     boyer_moore_search ( CorpusRange &corpus, patIter pat_first, patIter pat_last )
     {
-        boyer_moore<patIter> bm ( pat_first, pat_last );
-        return bm (boost::begin (corpus), boost::end (corpus));
+        typedef typename boost::range_iterator<CorpusRange>::type corpus_iterator;
+        return detail::one_shot_search<boyer_moore<patIter> > ( boost::begin (corpus), boost::end (corpus),
+                    pat_first, pat_last, typename detail::simd_search_kind<corpus_iterator>::type ());
     }
     
     template <typename PatternRange, typename CorpusRange>
@@ -243,8 +413,9 @@ Requirements:
     boyer_moore_search ( CorpusRange &corpus, const PatternRange &pattern )
     {
         typedef typename boost::range_iterator<const PatternRange>::type pattern_iterator;
-        boyer_moore<pattern_iterator> bm ( boost::begin(pattern), boost::end (pattern));
-        return bm (boost::begin (corpus), boost::end (corpus));
+        typedef typename boost::range_iterator<CorpusRange>::type corpus_iterator;
+        return detail::one_shot_search<boyer_moore<pattern_iterator> > ( boost::begin (corpus), boost::end (corpus),
+                    boost::begin(pattern), boost::end (pattern), typename detail::simd_search_kind<corpus_iterator>::type ());
     }
 
 
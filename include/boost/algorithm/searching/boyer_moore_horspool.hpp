@@ -20,9 +20,15 @@
 
 #include <boost/utility/enable_if.hpp>
 #include <boost/type_traits/is_same.hpp>
+#include <boost/type_traits/conditional.hpp>
 
 #include <boost/algorithm/searching/detail/bm_traits.hpp>
 #include <boost/algorithm/searching/detail/debugging.hpp>
+#include <boost/algorithm/searching/detail/match_counter.hpp>
+#include <boost/algorithm/searching/detail/simd.hpp>
+#include <boost/algorithm/searching/instrumentation.hpp>
+#include <boost/algorithm/searching/match_mode.hpp>
+#include <boost/algorithm/searching/segmented_iterator.hpp>
 
 // #define  BOOST_ALGORITHM_BOYER_MOORE_HORSPOOL_DEBUG_HPP
 
@@ -39,18 +45,34 @@ namespace boost { namespace algorithm {
         ** Numeric type (array-based skip table)
         ** Hashable type (map-based skip table)
 
+    When both the pattern and the corpus are contiguous ranges of bytes (pointers,
+    or iterators into a std::vector or std::basic_string of a character type), and
+    the target supports SSE2, the search is done by a vectorized candidate filter
+    instead of the skip loop; see detail/simd.hpp.
+
+    The skip table is allocated with the allocator in the traits
+    (BM_traits<patIter, Alloc>).
+
+    The Instrumentation policy (see instrumentation.hpp) is told about each
+    comparison, shift, verification and match; the default does nothing.
+    The vectorized search can't report what it does, so it is only used
+    with the default policy.
+
 http://www-igm.univ-mlv.fr/%7Elecroq/string/node18.html
 
 */
 
-    template <typename patIter, typename traits = detail::BM_traits<patIter> >
+    template <typename patIter, typename traits = detail::BM_traits<patIter>,
+              typename Instrumentation = no_instrumentation>
     class boyer_moore_horspool {
         typedef typename std::iterator_traits<patIter>::difference_type difference_type;
     public:
-        boyer_moore_horspool ( patIter first, patIter last ) 
+        typedef typename detail::traits_allocator<traits>::type allocator_type;
+
+        boyer_moore_horspool ( patIter first, patIter last, const allocator_type &alloc = allocator_type ())
                 : pat_first ( first ), pat_last ( last ),
                   k_pattern_length ( std::distance ( pat_first, pat_last )),
-                  skip_ ( k_pattern_length, k_pattern_length ) {
+                  skip_ ( detail::traits_allocator<traits>::make_skip_table ( k_pattern_length, k_pattern_length, alloc )) {
                   
         //  Build the skip table
             std::size_t i = 0;
@@ -86,7 +108,8 @@ http://www-igm.univ-mlv.fr/%7Elecroq/string/node18.html
                 return corpus_last;
     
         //  Do the search 
-            return this->do_search ( corpus_first, corpus_last );
+            return this->do_search ( corpus_first, corpus_last,
+                        typename detail::segmented_dispatch<corpusIter, typename simd_kind<corpusIter>::type>::type ());
             }
             
         template <typename Range>
@@ -94,11 +117,86 @@ http://www-igm.univ-mlv.fr/%7Elecroq/string/node18.html
             return (*this) (boost::begin(r), boost::end(r));
             }
 
+        /// \fn find_all ( corpusIter corpus_first, corpusIter corpus_last, OutputIterator out, match_mode_type mode )
+        /// \brief Finds every occurrence of the pattern in the corpus
+        /// 
+        /// \param corpus_first The start of the data to search (Random Access Iterator)
+        /// \param corpus_last  One past the end of the data to search
+        /// \param out          An output iterator which receives the start of each match
+        /// \param mode         Whether or not to report overlapping matches
+        ///
+        template <typename corpusIter, typename OutputIterator>
+        OutputIterator find_all ( corpusIter corpus_first, corpusIter corpus_last, 
+                        OutputIterator out, match_mode_type mode = match_overlapping ) const {
+            BOOST_STATIC_ASSERT (( boost::is_same<
+                typename std::iterator_traits<patIter>::value_type, 
+                typename std::iterator_traits<corpusIter>::value_type>::value ));
+
+            if ( corpus_first == corpus_last ) return out;  // if nothing to search, we didn't find it!
+            if (    pat_first ==    pat_last ) return out;  // empty pattern matches nothing here
+
+            const difference_type k_corpus_length  = std::distance ( corpus_first, corpus_last );
+        //  If the pattern is larger than the corpus, we can't find it!
+            if ( k_corpus_length < k_pattern_length )
+                return out;
+    
+            return this->do_find_all ( corpus_first, corpus_last, out, mode,
+                        typename detail::segmented_dispatch<corpusIter, typename simd_kind<corpusIter>::type>::type ());
+            }
+
+        template <typename Range, typename OutputIterator>
+        OutputIterator find_all ( Range &r, OutputIterator out, match_mode_type mode = match_overlapping ) const {
+            return this->find_all (boost::begin(r), boost::end(r), out, mode);
+            }
+
+        /// \fn count ( corpusIter corpus_first, corpusIter corpus_last, match_mode_type mode )
+        /// \brief Counts the occurrences of the pattern in the corpus
+        ///
+        /// \param corpus_first The start of the data to search (Random Access Iterator)
+        /// \param corpus_last  One past the end of the data to search
+        /// \param mode         Whether or not to count overlapping matches
+        ///
+        template <typename corpusIter>
+        std::size_t count ( corpusIter corpus_first, corpusIter corpus_last, match_mode_type mode = match_overlapping ) const {
+            return detail::count_matches ( *this, pat_first, corpus_first, corpus_last, mode, use_simd<corpusIter> ());
+            }
+
+        template <typename Range>
+        std::size_t count ( Range &r, match_mode_type mode = match_overlapping ) const {
+            return this->count (boost::begin(r), boost::end(r), mode);
+            }
+
+    //  The length of the pattern that was passed into the constructor
+        std::size_t pattern_length () const { return k_pattern_length; }
+
+    //  The instrumentation policy object
+        const Instrumentation &instrumentation () const { return instr_; }
+        Instrumentation &instrumentation () { return instr_; }
+
     private:
 /// \cond DOXYGEN_HIDE
         patIter pat_first, pat_last;
         const difference_type k_pattern_length;
         typename traits::skip_table_t skip_;
+        Instrumentation instr_;
+
+        template <typename corpusIter>
+        struct use_simd : public boost::integral_constant<bool,
+            detail::use_simd_search<corpusIter>::value &&
+            boost::is_same<Instrumentation, no_instrumentation>::value> {};
+
+    //  Which vector kernel do_search and do_find_all use, if any
+        template <typename corpusIter>
+        struct simd_kind : public boost::conditional<
+            boost::is_same<Instrumentation, no_instrumentation>::value,
+            typename detail::simd_search_kind<corpusIter>::type, boost::false_type> {};
+
+    //  Compare a pattern element with a corpus element, and tell the instrumentation
+        template <typename T, typename U>
+        bool compare ( const T &lhs, const U &rhs ) const {
+            instr_.compare ();
+            return lhs == rhs;
+            }
 
         /// \fn do_search ( corpusIter corpus_first, corpusIter corpus_last )
         /// \brief Searches the corpus for the pattern that was passed into the constructor
@@ -108,24 +206,160 @@ http://www-igm.univ-mlv.fr/%7Elecroq/string/node18.html
         /// \param k_corpus_length The length of the corpus to search
         ///
         template <typename corpusIter>
-        corpusIter do_search ( corpusIter corpus_first, corpusIter corpus_last ) const {
+        corpusIter do_search ( corpusIter corpus_first, corpusIter corpus_last, boost::false_type ) const {
+            typedef typename traits::skip_table_t table_type;
+            switch ( detail::skip_width ( skip_ )) {
+                case 1:  return this->search_loop ( corpus_first, corpus_last, detail::skip_view<table_type, 1>::make ( skip_ ));
+                case 2:  return this->search_loop ( corpus_first, corpus_last, detail::skip_view<table_type, 2>::make ( skip_ ));
+                default: return this->search_loop ( corpus_first, corpus_last, detail::skip_view<table_type, 0>::make ( skip_ ));
+                }
+            }
+
+    //  The search itself, with the skip table's width already chosen
+        template <typename corpusIter, typename Skip>
+        corpusIter search_loop ( corpusIter corpus_first, corpusIter corpus_last, const Skip &skip ) const {
             corpusIter curPos = corpus_first;
             const corpusIter lastPos = corpus_last - k_pattern_length;
             while ( curPos <= lastPos ) {
             //  Do we match right where we are?
+                instr_.verify ();
                 std::size_t j = k_pattern_length - 1;
-                while ( pat_first [j] == curPos [j] ) {
+                while ( this->compare ( pat_first [j], curPos [j] )) {
                 //  We matched - we're done!
-                    if ( j == 0 )
+                    if ( j == 0 ) {
+                        instr_.match ();
                         return curPos;
+                        }
                     j--;
                     }
         
-                curPos += skip_ [ curPos [ k_pattern_length - 1 ]];
+                const difference_type shift = skip [ curPos [ k_pattern_length - 1 ]];
+                instr_.shift ( shift );
+                curPos += shift;
                 }
             
             return corpus_last;
             }
+
+        /// \fn do_search ( corpusIter corpus_first, corpusIter corpus_last, boost::true_type )
+        /// \brief Searches a contiguous range of bytes, using the vectorized candidate filter
+        ///         rather than the skip table.
+        ///
+        template <typename corpusIter>
+        corpusIter do_search ( corpusIter corpus_first, corpusIter corpus_last, boost::true_type ) const {
+            const unsigned char *first = detail::as_bytes ( corpus_first );
+            const unsigned char *last  = first + std::distance ( corpus_first, corpus_last );
+            const unsigned char *found = detail::simd_search ( first, last, pat_first, k_pattern_length );
+            return corpus_first + ( found - first );
+            }
+
+#if defined(BOOST_ALGORITHM_SEARCH_SSE2)
+        /// \fn do_search ( corpusIter corpus_first, corpusIter corpus_last, detail::simd_wide_tag )
+        /// \brief Searches a contiguous range of 2, 4 or 8 byte integers, using the
+        ///         vectorized candidate filter rather than the skip table.
+        ///
+        template <typename corpusIter>
+        corpusIter do_search ( corpusIter corpus_first, corpusIter corpus_last, detail::simd_wide_tag ) const {
+            const typename detail::simd_element<corpusIter>::type *first = detail::as_elements ( corpus_first );
+            const typename detail::simd_element<corpusIter>::type *last  = first + std::distance ( corpus_first, corpus_last );
+            return corpus_first + ( detail::simd_search_wide ( first, last, pat_first, k_pattern_length ) - first );
+            }
+#endif
+
+        template <typename corpusIter>
+        corpusIter do_search ( corpusIter corpus_first, corpusIter corpus_last, detail::segmented_iterator_tag ) const {
+            return detail::segmented_search ( *this, corpus_first, corpus_last );
+            }
+
+        template <typename corpusIter, typename OutputIterator>
+        OutputIterator do_find_all ( corpusIter corpus_first, corpusIter corpus_last, 
+                        OutputIterator out, match_mode_type mode, boost::false_type ) const {
+            typedef typename traits::skip_table_t table_type;
+            switch ( detail::skip_width ( skip_ )) {
+                case 1:  return this->find_all_loop ( corpus_first, corpus_last, out, mode, detail::skip_view<table_type, 1>::make ( skip_ ));
+                case 2:  return this->find_all_loop ( corpus_first, corpus_last, out, mode, detail::skip_view<table_type, 2>::make ( skip_ ));
+                default: return this->find_all_loop ( corpus_first, corpus_last, out, mode, detail::skip_view<table_type, 0>::make ( skip_ ));
+                }
+            }
+
+        template <typename corpusIter, typename OutputIterator, typename Skip>
+        OutputIterator find_all_loop ( corpusIter corpus_first, corpusIter corpus_last,
+                        OutputIterator out, match_mode_type mode, const Skip &skip ) const {
+            corpusIter curPos = corpus_first;
+            difference_type remaining = std::distance ( corpus_first, corpus_last ) - k_pattern_length;
+            difference_type shift;
+
+            while ( true ) {
+            //  Do we match right where we are?
+                instr_.verify ();
+                difference_type j = k_pattern_length;
+                while ( j > 0 && this->compare ( pat_first [j-1], curPos [j-1] ))
+                    j--;
+
+                if ( j == 0 ) {
+                    instr_.match ();
+                    *out++ = curPos;
+                    shift = mode == match_overlapping ? skip [ curPos [ k_pattern_length - 1 ]] : k_pattern_length;
+                    }
+                else
+                    shift = skip [ curPos [ k_pattern_length - 1 ]];
+
+                if ( shift > remaining )
+                    break;
+                instr_.shift ( shift );
+                curPos    += shift;
+                remaining -= shift;
+                }
+
+            return out;
+            }
+
+        template <typename corpusIter, typename OutputIterator>
+        OutputIterator do_find_all ( corpusIter corpus_first, corpusIter corpus_last, 
+                        OutputIterator out, match_mode_type mode, boost::true_type ) const {
+            const unsigned char *first = detail::as_bytes ( corpus_first );
+            const unsigned char *last  = first + std::distance ( corpus_first, corpus_last );
+            const difference_type k_step = mode == match_overlapping ? 1 : k_pattern_length;
+            const unsigned char *curPos = first;
+
+            while ( last - curPos >= k_pattern_length ) {
+                const unsigned char *found = detail::simd_search ( curPos, last, pat_first, k_pattern_length );
+                if ( found == last )
+                    break;
+                *out++ = corpus_first + ( found - first );
+                curPos = found + k_step;
+                }
+
+            return out;
+            }
+
+#if defined(BOOST_ALGORITHM_SEARCH_SSE2)
+        template <typename corpusIter, typename OutputIterator>
+        OutputIterator do_find_all ( corpusIter corpus_first, corpusIter corpus_last, 
+                        OutputIterator out, match_mode_type mode, detail::simd_wide_tag ) const {
+            typedef typename detail::simd_element<corpusIter>::type element;
+            const element *first = detail::as_elements ( corpus_first );
+            const element *last  = first + std::distance ( corpus_first, corpus_last );
+            const difference_type k_step = mode == match_overlapping ? 1 : k_pattern_length;
+            const element *curPos = first;
+
+            while ( last - curPos >= k_pattern_length ) {
+                const element *found = detail::simd_search_wide ( curPos, last, pat_first, k_pattern_length );
+                if ( found == last )
+                    break;
+                *out++ = corpus_first + ( found - first );
+                curPos = found + k_step;
+                }
+
+            return out;
+            }
+#endif
+
+        template <typename corpusIter, typename OutputIterator>
+        OutputIterator do_find_all ( corpusIter corpus_first, corpusIter corpus_last, 
+                        OutputIterator out, match_mode_type mode, detail::segmented_iterator_tag ) const {
+            return detail::segmented_find_all ( *this, corpus_first, corpus_last, out, mode );
+            }
 // \endcond
         };
 
@@ -146,8 +380,8 @@ http://www-igm.univ-mlv.fr/%7Elecroq/string/node18.html
                   corpusIter corpus_first, corpusIter corpus_last, 
                   patIter pat_first, patIter pat_last )
     {
-        boyer_moore_horspool<patIter> bmh ( pat_first, pat_last );
-        return bmh ( corpus_first, corpus_last );
+        return detail::one_shot_search<boyer_moore_horspool<patIter> > ( corpus_first, corpus_last,
+                    pat_first, pat_last, typename detail::simd_search_kind<corpusIter>::type ());
     }
 
     template <typename PatternRange, typename corpusIter>
@@ -155,8 +389,8 @@ http://www-igm.univ-mlv.fr/%7Elecroq/string/node18.html
         corpusIter corpus_first, corpusIter corpus_last, const PatternRange &pattern )
     {
         typedef typename boost::range_iterator<const PatternRange>::type pattern_iterator;
-        boyer_moore_horspool<pattern_iterator> bmh ( boost::begin(pattern), boost::end (pattern));
-        return bmh ( corpus_first, corpus_last );
+        return detail::one_shot_search<boyer_moore_horspool<pattern_iterator> > ( corpus_first, corpus_last,
+                    boost::begin(pattern), boost::end (pattern), typename detail::simd_search_kind<corpusIter>::type ());
     }
     
     template <typename patIter, typename CorpusRange>
@@ -165,8 +399,9 @@ http://www-igm.univ-mlv.fr/%7Elecroq/string/node18.html
     ::type
     boyer_moore_horspool_search ( CorpusRange &corpus, patIter pat_first, patIter pat_last )
     {
-        boyer_moore_horspool<patIter> bmh ( pat_first, pat_last );
-        return bm (boost::begin (corpus), boost::end (corpus));
+        typedef typename boost::range_iterator<CorpusRange>::type corpus_iterator;
+        return detail::one_shot_search<boyer_moore_horspool<patIter> > ( boost::begin (corpus), boost::end (corpus),
+                    pat_first, pat_last, typename detail::simd_search_kind<corpus_iterator>::type ());
     }
     
     template <typename PatternRange, typename CorpusRange>
@@ -174,8 +409,9 @@ http://www-igm.univ-mlv.fr/%7Elecroq/string/node18.html
     boyer_moore_horspool_search ( CorpusRange &corpus, const PatternRange &pattern )
     {
         typedef typename boost::range_iterator<const PatternRange>::type pattern_iterator;
-        boyer_moore_horspool<pattern_iterator> bmh ( boost::begin(pattern), boost::end (pattern));
-        return bmh (boost::begin (corpus), boost::end (corpus));
+        typedef typename boost::range_iterator<CorpusRange>::type corpus_iterator;
+        return detail::one_shot_search<boyer_moore_horspool<pattern_iterator> > ( boost::begin (corpus), boost::end (corpus),
+                    boost::begin(pattern), boost::end (pattern), typename detail::simd_search_kind<corpus_iterator>::type ());
     }
 
 
@@ -0,0 +1,302 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+#ifndef BOOST_ALGORITHM_SEARCH_DETAIL_AC_TRAITS_HPP
+#define BOOST_ALGORITHM_SEARCH_DETAIL_AC_TRAITS_HPP
+
+#include <climits>      // for CHAR_BIT
+#include <cstddef>      // for std::size_t
+#include <vector>
+#include <utility>      // for std::pair
+#include <algorithm>    // for std::sort, std::lower_bound
+#include <stdexcept>    // for std::length_error
+#include <iterator>     // for std::iterator_traits
+
+#include <boost/cstdint.hpp>
+#include <boost/array.hpp>
+#include <boost/throw_exception.hpp>
+#include <boost/type_traits/make_unsigned.hpp>
+#include <boost/type_traits/is_integral.hpp>
+
+#include <boost/algorithm/searching/detail/debugging.hpp>
+
+/// \cond DOXYGEN_HIDE
+
+namespace boost { namespace algorithm { namespace detail {
+
+//
+//  The keyword trie for Aho-Corasick, with the failure and dictionary-suffix
+//  links filled in. This is only used during construction; the automata
+//  below compile it into their search representation.
+//
+    template <typename key_type>
+    struct ac_trie {
+        typedef boost::uint32_t state_type;
+        typedef std::pair<key_type, state_type> edge_type;
+        static const state_type k_root = 0;
+        static const state_type k_none = ~state_type ( 0 );
+
+        std::vector<std::vector<edge_type> > children;
+        std::vector<state_type> fail;       // longest proper suffix that is also a trie state
+        std::vector<state_type> match;      // id of the pattern ending at this state (or k_none)
+        std::vector<state_type> output;     // first state on the failure chain (inclusive) with a match
+        std::vector<state_type> bfs;        // states in breadth-first order
+
+        ac_trie () : children ( 1 ), match ( 1, k_none ) {}
+
+        state_type child ( state_type s, const key_type &k ) const {
+            const std::vector<edge_type> &c = children [ s ];
+            for ( typename std::vector<edge_type>::const_iterator it = c.begin (); it != c.end (); ++it )
+                if ( it->first == k )
+                    return it->second;
+            return k_none;
+            }
+
+        template <typename patIter>
+        void insert ( patIter first, patIter last, std::size_t id ) {
+            state_type s = k_root;
+            for ( ; first != last; ++first ) {
+                state_type next = child ( s, *first );
+                if ( next == k_none ) {
+                    if ( children.size () >= static_cast<std::size_t> ( k_none ))
+                        boost::throw_exception ( std::length_error ( "aho_corasick: too many states" ));
+                    next = static_cast<state_type> ( children.size ());
+                    children [ s ].push_back ( edge_type ( *first, next ));
+                    children.push_back ( std::vector<edge_type> ());
+                    match.push_back ( k_none );
+                    }
+                s = next;
+                }
+        //  Duplicate patterns report the first id
+            if ( s != k_root && match [ s ] == k_none )
+                match [ s ] = static_cast<state_type> ( id );
+            }
+
+        void build () {
+            const std::size_t count = children.size ();
+            fail.assign   ( count, k_root );
+            output.assign ( count, k_none );
+            bfs.clear ();
+            bfs.reserve ( count );
+            bfs.push_back ( k_root );
+            for ( std::size_t i = 0; i < bfs.size (); ++i ) {
+                const state_type u = bfs [ i ];
+                const std::vector<edge_type> &c = children [ u ];
+                for ( typename std::vector<edge_type>::const_iterator it = c.begin (); it != c.end (); ++it ) {
+                    const state_type v = it->second;
+                    if ( u != k_root ) {
+                        state_type f = fail [ u ];
+                        state_type next;
+                        while (( next = child ( f, it->first )) == k_none && f != k_root )
+                            f = fail [ f ];
+                        fail [ v ] = next == k_none ? k_root : next;
+                        }
+                    output [ v ] = match [ v ] != k_none ? v : output [ fail [ v ]];
+                    bfs.push_back ( v );
+                    }
+                }
+            }
+
+    //  The next state after 's' on the failure chain where a pattern ends
+        state_type next_output ( state_type s ) const {
+            return s == k_root ? k_none : output [ fail [ s ]];
+            }
+        };
+
+    template <typename key_type>
+    const typename ac_trie<key_type>::state_type ac_trie<key_type>::k_root;
+    template <typename key_type>
+    const typename ac_trie<key_type>::state_type ac_trie<key_type>::k_none;
+
+//  The outputs of an automaton: for each state, the id of the pattern ending
+//  there, and the next state on its failure chain where another one ends.
+    template <typename key_type>
+    class ac_outputs {
+    public:
+        typedef boost::uint32_t state_type;
+
+        void build ( const ac_trie<key_type> &trie ) {
+            const std::size_t count = trie.children.size ();
+            match_ = trie.match;
+            next_output_.resize ( count );
+            for ( std::size_t s = 0; s < count; ++s )
+                next_output_ [ s ] = trie.next_output ( static_cast<state_type> ( s ));
+            }
+
+        std::size_t pattern     ( state_type out ) const { return match_ [ out ]; }
+        state_type  next_output ( state_type out ) const { return next_output_ [ out ]; }
+
+    private:
+        std::vector<state_type> match_;
+        std::vector<state_type> next_output_;
+        };
+
+
+//
+//  Default implementations of the Aho-Corasick automaton
+//
+    template<typename key_type, bool /*useArray*/> class ac_automaton;
+
+//  General case: each state keeps its transitions sorted in one flat array,
+//  and the search follows failure links on a miss.
+    template<typename key_type>
+    class ac_automaton<key_type, false> : public ac_outputs<key_type> {
+    public:
+        typedef boost::uint32_t state_type;
+        static const state_type k_none = ac_trie<key_type>::k_none;
+
+        ac_automaton () {}
+
+        void build ( const ac_trie<key_type> &trie ) {
+            const std::size_t count = trie.children.size ();
+            first_edge_.resize ( count + 1 );
+            keys_.clear ();
+            targets_.clear ();
+            std::vector<typename ac_trie<key_type>::edge_type> edges;
+            for ( std::size_t s = 0; s < count; ++s ) {
+                first_edge_ [ s ] = static_cast<state_type> ( keys_.size ());
+                edges = trie.children [ s ];
+                std::sort ( edges.begin (), edges.end (), edge_less ());
+                for ( std::size_t i = 0; i < edges.size (); ++i ) {
+                    keys_.push_back    ( edges [ i ].first );
+                    targets_.push_back ( edges [ i ].second );
+                    }
+                }
+            first_edge_ [ count ] = static_cast<state_type> ( keys_.size ());
+            fail_   = trie.fail;
+            output_ = trie.output;
+            ac_outputs<key_type>::build ( trie );
+            }
+
+        state_type start () const { return 0; }
+
+        state_type next ( state_type s, const key_type &k ) const {
+            while ( true ) {
+                const typename std::vector<key_type>::const_iterator first = keys_.begin () + first_edge_ [ s ];
+                const typename std::vector<key_type>::const_iterator last  = keys_.begin () + first_edge_ [ s + 1 ];
+                const typename std::vector<key_type>::const_iterator it = std::lower_bound ( first, last, k );
+                if ( it != last && !( k < *it ))
+                    return targets_ [ it - keys_.begin () ];
+                if ( s == 0 )
+                    return 0;
+                s = fail_ [ s ];
+                }
+            }
+
+    //  The first state (on the failure chain of 's') where a pattern ends, or k_none
+        state_type output ( state_type s ) const { return output_ [ s ]; }
+
+    private:
+        struct edge_less {
+            bool operator () ( const typename ac_trie<key_type>::edge_type &a,
+                               const typename ac_trie<key_type>::edge_type &b ) const {
+                return a.first < b.first;
+                }
+            };
+
+        std::vector<state_type> first_edge_;
+        std::vector<key_type>   keys_;
+        std::vector<state_type> targets_;
+        std::vector<state_type> fail_;
+        std::vector<state_type> output_;
+        };
+
+
+//  Special case small numeric values; use a dense transition table.
+//  The byte values that occur in the patterns are mapped to a compact set of
+//  character classes (class 0 is "anything else"), and the failure links are
+//  compiled into the table, so each corpus element costs two loads.
+//  States are stored premultiplied by the row width, and states that have an
+//  output are tagged with the high bit.
+    template<typename key_type>
+    class ac_automaton<key_type, true> : public ac_outputs<key_type> {
+        typedef typename boost::make_unsigned<key_type>::type unsigned_key_type;
+    public:
+        typedef boost::uint32_t state_type;
+        static const state_type k_none = ac_trie<key_type>::k_none;
+
+        ac_automaton () : k_classes ( 1 ) {}
+
+        void build ( const ac_trie<key_type> &trie ) {
+            const std::size_t count = trie.children.size ();
+
+        //  Build the character classes
+            std::fill_n ( class_.begin (), class_.size (), static_cast<boost::uint16_t> ( 0 ));
+            k_classes = 1;
+            for ( std::size_t s = 0; s < count; ++s )
+                for ( std::size_t i = 0; i < trie.children [ s ].size (); ++i ) {
+                    boost::uint16_t &c = class_ [ static_cast<unsigned_key_type> ( trie.children [ s ][ i ].first ) ];
+                    if ( c == 0 )
+                        c = static_cast<boost::uint16_t> ( k_classes++ );
+                    }
+
+            if ( count * k_classes >= k_output_flag )
+                boost::throw_exception ( std::length_error ( "aho_corasick: too many states" ));
+
+        //  Fill in the transitions in breadth-first order, so that the
+        //  row for the failure state is always complete before we need it.
+            delta_.assign ( count * k_classes, 0 );
+            for ( std::size_t i = 0; i < count; ++i ) {
+                const state_type u = trie.bfs [ i ];
+                state_type *row = &delta_ [ u * k_classes ];
+                if ( u != 0 ) {
+                    const state_type *fail_row = &delta_ [ trie.fail [ u ] * k_classes ];
+                    std::copy ( fail_row, fail_row + k_classes, row );
+                    }
+                for ( std::size_t j = 0; j < trie.children [ u ].size (); ++j ) {
+                    const state_type v = trie.children [ u ][ j ].second;
+                    row [ class_ [ static_cast<unsigned_key_type> ( trie.children [ u ][ j ].first ) ]] =
+                        static_cast<state_type> ( v * k_classes ) |
+                        ( trie.output [ v ] != k_none ? k_output_flag : 0 );
+                    }
+                }
+            output_ = trie.output;
+            ac_outputs<key_type>::build ( trie );
+            }
+
+        state_type start () const { return 0; }
+
+        state_type next ( state_type s, key_type k ) const {
+            return delta_ [ ( s & ~k_output_flag ) + class_ [ static_cast<unsigned_key_type> ( k ) ]];
+            }
+
+        state_type output ( state_type s ) const {
+            return ( s & k_output_flag ) == 0 ? k_none :
+                    output_ [ ( s & ~k_output_flag ) / k_classes ];
+            }
+
+    private:
+        static const state_type k_output_flag = 0x80000000U;
+
+        boost::array<boost::uint16_t, 1U << (CHAR_BIT * sizeof(key_type))> class_;
+        std::size_t k_classes;
+        std::vector<state_type> delta_;
+        std::vector<state_type> output_;
+        };
+
+    template<typename key_type>
+    const typename ac_automaton<key_type, false>::state_type ac_automaton<key_type, false>::k_none;
+    template<typename key_type>
+    const typename ac_automaton<key_type, true>::state_type ac_automaton<key_type, true>::k_none;
+    template<typename key_type>
+    const typename ac_automaton<key_type, true>::state_type ac_automaton<key_type, true>::k_output_flag;
+
+    template<typename Iterator>
+    struct AC_traits {
+        typedef typename std::iterator_traits<Iterator>::value_type key_type;
+        typedef boost::algorithm::detail::ac_trie<key_type> trie_t;
+        typedef boost::algorithm::detail::ac_automaton<key_type,
+                boost::is_integral<key_type>::value && (sizeof(key_type)==1)> automaton_t;
+        };
+
+}}} // namespaces
+
+/// \endcond
+
+#endif  //  BOOST_ALGORITHM_SEARCH_DETAIL_AC_TRAITS_HPP
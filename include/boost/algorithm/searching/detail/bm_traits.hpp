@@ -12,8 +12,18 @@
 
 #include <climits>      // for CHAR_BIT
 #include <vector>
+#include <memory>       // for std::allocator
+#include <functional>   // for std::equal_to
+#include <algorithm>    // for std::fill_n
 #include <iterator>     // for std::iterator_traits
+#include <stdexcept>    // for std::length_error
 
+#include <boost/config.hpp>
+#include <boost/assert.hpp>
+#include <boost/throw_exception.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/core/allocator_access.hpp>
+#include <boost/mpl/has_xxx.hpp>
 #include <boost/type_traits/make_unsigned.hpp>
 #include <boost/type_traits/is_integral.hpp>
 #include <boost/type_traits/remove_pointer.hpp>
@@ -33,23 +43,31 @@ namespace boost { namespace algorithm { namespace detail {
 //
 //  Default implementations of the skip tables for B-M and B-M-H
 //
-    template<typename key_type, typename value_type, bool /*useArray*/> class skip_table;
+//  All of them take an allocator (of any type; it is rebound to whatever is
+//  needed), which is used for everything they allocate.
+//
+    template<typename key_type, typename value_type, bool /*useArray*/,
+             typename Alloc = std::allocator<char> > class skip_table;
 
-//  General case for data searching other than bytes; use a map
-    template<typename key_type, typename value_type>
-    class skip_table<key_type, value_type, false> {
+//  General case for data searching other than integers; use a map
+    template<typename key_type, typename value_type, typename Alloc>
+    class skip_table<key_type, value_type, false, Alloc> {
     private:
+        typedef typename boost::allocator_rebind<Alloc, std::pair<const key_type, value_type> >::type map_allocator;
 #ifdef BOOST_NO_CXX11_HDR_UNORDERED_MAP
-        typedef std::tr1::unordered_map<key_type, value_type> skip_map;
+        typedef std::tr1::unordered_map<key_type, value_type,
+                    std::tr1::hash<key_type>, std::equal_to<key_type>, map_allocator> skip_map;
 #else
-        typedef std::unordered_map<key_type, value_type> skip_map;
+        typedef std::unordered_map<key_type, value_type,
+                    std::hash<key_type>, std::equal_to<key_type>, map_allocator> skip_map;
 #endif
         const value_type k_default_value;
         skip_map skip_;
         
     public:
-        skip_table ( std::size_t patSize, value_type default_value ) 
-            : k_default_value ( default_value ), skip_ ( patSize ) {}
+        skip_table ( std::size_t patSize, value_type default_value, const Alloc &alloc = Alloc ())
+            : k_default_value ( default_value ),
+              skip_ ( patSize, typename skip_map::hasher (), typename skip_map::key_equal (), map_allocator ( alloc )) {}
         
         void insert ( key_type key, value_type val ) {
             skip_ [ key ] = val;    // Would skip_.insert (val) be better here?
@@ -70,42 +88,246 @@ namespace boost { namespace algorithm { namespace detail {
         };
         
     
-//  Special case small numeric values; use an array
-    template<typename key_type, typename value_type>
-    class skip_table<key_type, value_type, true> {
+//  Special case small numeric values; use an array.
+//  The entries are as narrow as the pattern length allows, so that the table
+//  takes up as little of the cache as possible; short patterns get one byte
+//  per entry, instead of a whole difference_type. The skip values are always
+//  in [-1, pattern length], so they are stored offset by one.
+    template<typename key_type, typename value_type, typename Alloc>
+    class skip_table<key_type, value_type, true, Alloc> {
     private:
         typedef typename boost::make_unsigned<key_type>::type unsigned_key_type;
-        typedef boost::array<value_type, 1U << (CHAR_BIT * sizeof(key_type))> skip_map;
-        skip_map skip_;
+        BOOST_STATIC_CONSTANT ( std::size_t, k_table_size = 1U << (CHAR_BIT * sizeof(key_type)));
+        typedef boost::array<boost::uint8_t, k_table_size> skip_map;
+        typedef typename boost::allocator_rebind<Alloc, boost::uint16_t>::type medium_allocator;
+        typedef typename boost::allocator_rebind<Alloc, value_type>::type wide_allocator;
+        skip_map narrow_;                                           // used when width_ == 1
+        std::vector<boost::uint16_t, medium_allocator> medium_;     // used when width_ == 2
+        std::vector<value_type, wide_allocator> wide_;              // used when width_ == 0
         const value_type k_default_value;
+        int width_;
+
     public:
-        skip_table ( std::size_t patSize, value_type default_value ) : k_default_value ( default_value ) {
-            std::fill_n ( skip_.begin(), skip_.size(), default_value );
+        skip_table ( std::size_t patSize, value_type default_value, const Alloc &alloc = Alloc ())
+                : medium_ ( medium_allocator ( alloc )), wide_ ( wide_allocator ( alloc )),
+                  k_default_value ( default_value ),
+                  width_ ( patSize < 0xFFU ? 1 : patSize < 0xFFFFU ? 2 : 0 ) {
+            if ( width_ == 1 )
+                std::fill_n ( narrow_.begin (), narrow_.size (), static_cast<boost::uint8_t> ( default_value + 1 ));
+            else if ( width_ == 2 )
+                medium_.assign ( k_table_size, static_cast<boost::uint16_t> ( default_value + 1 ));
+            else
+                wide_.assign ( k_table_size, default_value );
             }
         
         void insert ( key_type key, value_type val ) {
-            skip_ [ static_cast<unsigned_key_type> ( key ) ] = val;
+            const unsigned_key_type k = static_cast<unsigned_key_type> ( key );
+            if ( width_ == 1 ) {
+                BOOST_ASSERT ( val >= -1 && val < 0xFF );
+                narrow_ [ k ] = static_cast<boost::uint8_t> ( val + 1 );
+                }
+            else if ( width_ == 2 ) {
+                BOOST_ASSERT ( val >= -1 && val < 0xFFFF );
+                medium_ [ k ] = static_cast<boost::uint16_t> ( val + 1 );
+                }
+            else
+                wide_ [ k ] = val;
             }
 
         value_type operator [] ( key_type key ) const {
-            return skip_ [ static_cast<unsigned_key_type> ( key ) ];
+            const unsigned_key_type k = static_cast<unsigned_key_type> ( key );
+            if ( width_ == 1 ) return static_cast<value_type> ( narrow_ [ k ] ) - 1;
+            if ( width_ == 2 ) return static_cast<value_type> ( medium_ [ k ] ) - 1;
+            return wide_ [ k ];
             }
 
+    //  For the search loops, which pick a skip_view once for each search
+        int width () const { return width_; }
+        const boost::uint8_t  *narrow_data () const { return narrow_.data (); }
+        const boost::uint16_t *medium_data () const { return &medium_ [ 0 ]; }
+        const value_type      *wide_data   () const { return &wide_ [ 0 ]; }
+
         void PrintSkipTable () const {
             std::cout << "BM(H) Skip Table <boost:array>:" << std::endl;
+            for ( std::size_t i = 0; i < k_table_size; ++i ) {
+                const value_type val = (*this) [ static_cast<key_type> ( i ) ];
+                if ( val != k_default_value )
+                    std::cout << "  " << i << ": " << val << std::endl;
+                }
+            std::cout << std::endl;
+            }
+        };
+
+
+//  Wider integral values (wchar_t, char16_t, char32_t, etc); use a flat,
+//  open-addressed hash table. Each entry holds the key and the skip value
+//  (offset by two, so that zero marks an empty slot) side by side, so a
+//  lookup is usually a single cache line, with no pointers to follow.
+    template<typename key_type, typename value_type, typename Alloc = std::allocator<char> >
+    class flat_skip_table {
+    private:
+        typedef typename boost::make_unsigned<key_type>::type unsigned_key_type;
+        struct entry {
+            unsigned_key_type key;
+            boost::uint32_t value;
+            };
+        typedef typename boost::allocator_rebind<Alloc, entry>::type entry_allocator;
+        typedef std::vector<entry, entry_allocator> skip_map;
+        skip_map skip_;
+        std::size_t mask_;
+        int shift_;
+        const value_type k_default_value;
+
+        std::size_t slot ( unsigned_key_type key ) const {
+            const boost::uint32_t h = static_cast<boost::uint32_t> ( key ^ ( key >> 16 >> 16 ));
+            return static_cast<boost::uint32_t> ( h * 2654435761U ) >> shift_;     // Fibonacci hashing
+            }
+
+    public:
+        flat_skip_table ( std::size_t patSize, value_type default_value, const Alloc &alloc = Alloc ())
+                : skip_ ( entry_allocator ( alloc )), mask_ ( 7 ), shift_ ( 29 ), k_default_value ( default_value ) {
+            if ( patSize > ( std::size_t ( 1 ) << 30 ))
+                boost::throw_exception ( std::length_error ( "boost::algorithm: pattern too long for the skip table" ));
+        //  At most half full, so the probe sequences stay short
+            while ( mask_ + 1 < 2 * patSize ) {
+                mask_ = 2 * mask_ + 1;
+                --shift_;
+                }
+            entry empty = { 0, 0 };
+            skip_.assign ( mask_ + 1, empty );
+            }
+
+        void insert ( key_type key, value_type val ) {
+            BOOST_ASSERT ( val >= -1 );
+            const unsigned_key_type k = static_cast<unsigned_key_type> ( key );
+            std::size_t i = slot ( k );
+            while ( skip_ [ i ].value != 0 && skip_ [ i ].key != k )
+                i = ( i + 1 ) & mask_;
+            skip_ [ i ].key   = k;
+            skip_ [ i ].value = static_cast<boost::uint32_t> ( val + 2 );
+            }
+
+        value_type operator [] ( key_type key ) const {
+            const unsigned_key_type k = static_cast<unsigned_key_type> ( key );
+            for ( std::size_t i = slot ( k ); ; i = ( i + 1 ) & mask_ ) {
+                const entry &e = skip_ [ i ];
+                if ( e.value == 0 ) return k_default_value;
+                if ( e.key == k )   return static_cast<value_type> ( e.value ) - 2;
+                }
+            }
+
+        void PrintSkipTable () const {
+            std::cout << "BM(H) Skip Table <flat>:" << std::endl;
             for ( typename skip_map::const_iterator it = skip_.begin (); it != skip_.end (); ++it )
-                if ( *it != k_default_value )
-                    std::cout << "  " << std::distance (skip_.begin (), it) << ": " << *it << std::endl;
+                if ( it->value != 0 && static_cast<value_type> ( it->value ) - 2 != k_default_value )
+                    std::cout << "  " << it->key << ": " << static_cast<value_type> ( it->value ) - 2 << std::endl;
             std::cout << std::endl;
             }
         };
 
-    template<typename Iterator>
+
+//  Pick the skip table for a key type
+    template<typename key_type, typename value_type, typename Alloc,
+             bool isIntegral = boost::is_integral<key_type>::value, std::size_t keySize = sizeof(key_type)>
+    struct select_skip_table {
+        typedef skip_table<key_type, value_type, false, Alloc> type;
+        };
+
+    template<typename key_type, typename value_type, typename Alloc, std::size_t keySize>
+    struct select_skip_table<key_type, value_type, Alloc, true, keySize> {
+        typedef flat_skip_table<key_type, value_type, Alloc> type;
+        };
+
+    template<typename key_type, typename value_type, typename Alloc>
+    struct select_skip_table<key_type, value_type, Alloc, true, 1> {
+        typedef skip_table<key_type, value_type, true, Alloc> type;
+        };
+
+//  The search loops look up a skip for almost every position of the corpus,
+//  so the byte table's width is tested once per search, not once per lookup:
+//
+//      switch ( skip_width ( skip_ )) {
+//          case 1:  return loop ( ..., skip_view<table, 1>::make ( skip_ ));
+//          case 2:  return loop ( ..., skip_view<table, 2>::make ( skip_ ));
+//          default: return loop ( ..., skip_view<table, 0>::make ( skip_ ));
+//          }
+//
+//  Any other table is used as it is.
+    template<typename key_type, typename value_type, typename Entry, int Bias>
+    class byte_skip_view {
+    public:
+        explicit byte_skip_view ( const Entry *table ) : table_ ( table ) {}
+
+        value_type operator [] ( key_type key ) const {
+            return static_cast<value_type> ( table_ [ static_cast<typename boost::make_unsigned<key_type>::type> ( key ) ] ) - Bias;
+            }
+
+    private:
+        const Entry *table_;
+        };
+
+    template<typename Table>
+    int skip_width ( const Table & ) { return 0; }
+
+    template<typename key_type, typename value_type, typename Alloc>
+    int skip_width ( const skip_table<key_type, value_type, true, Alloc> &table ) { return table.width (); }
+
+    template<typename Table, int Width>
+    struct skip_view {
+        typedef const Table &type;
+        static type make ( const Table &table ) { return table; }
+        };
+
+    template<typename key_type, typename value_type, typename Alloc>
+    struct skip_view<skip_table<key_type, value_type, true, Alloc>, 1> {
+        typedef byte_skip_view<key_type, value_type, boost::uint8_t, 1> type;
+        static type make ( const skip_table<key_type, value_type, true, Alloc> &table ) { return type ( table.narrow_data ()); }
+        };
+
+    template<typename key_type, typename value_type, typename Alloc>
+    struct skip_view<skip_table<key_type, value_type, true, Alloc>, 2> {
+        typedef byte_skip_view<key_type, value_type, boost::uint16_t, 1> type;
+        static type make ( const skip_table<key_type, value_type, true, Alloc> &table ) { return type ( table.medium_data ()); }
+        };
+
+    template<typename key_type, typename value_type, typename Alloc>
+    struct skip_view<skip_table<key_type, value_type, true, Alloc>, 0> {
+        typedef byte_skip_view<key_type, value_type, value_type, 0> type;
+        static type make ( const skip_table<key_type, value_type, true, Alloc> &table ) { return type ( table.wide_data ()); }
+        };
+
+
+    template<typename Iterator, typename Alloc = std::allocator<char> >
     struct BM_traits {
         typedef typename std::iterator_traits<Iterator>::difference_type value_type;
         typedef typename std::iterator_traits<Iterator>::value_type key_type;
-        typedef boost::algorithm::detail::skip_table<key_type, value_type, 
-                boost::is_integral<key_type>::value && (sizeof(key_type)==1)> skip_table_t;
+        typedef Alloc allocator_type;
+        typedef typename boost::algorithm::detail::select_skip_table<key_type, value_type, Alloc>::type skip_table_t;
+        };
+
+
+//  Traits that were written before the searchers took an allocator don't
+//  have an allocator_type; their skip tables get built without one.
+    BOOST_MPL_HAS_XXX_TRAIT_DEF(allocator_type)
+
+    template <typename traits, bool hasAllocator = has_allocator_type<traits>::value>
+    struct traits_allocator {
+        typedef typename traits::allocator_type type;
+
+        static typename traits::skip_table_t make_skip_table (
+                    std::size_t patSize, typename traits::value_type default_value, const type &alloc ) {
+            return typename traits::skip_table_t ( patSize, default_value, alloc );
+            }
+        };
+
+    template <typename traits>
+    struct traits_allocator<traits, false> {
+        typedef std::allocator<char> type;
+
+        static typename traits::skip_table_t make_skip_table (
+                    std::size_t patSize, typename traits::value_type default_value, const type & ) {
+            return typename traits::skip_table_t ( patSize, default_value );
+            }
         };
 
 }}} // namespaces
@@ -0,0 +1,193 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+#ifndef BOOST_ALGORITHM_SEARCH_DETAIL_CASE_FOLD_HPP
+#define BOOST_ALGORITHM_SEARCH_DETAIL_CASE_FOLD_HPP
+
+#include <locale>
+#include <vector>
+#include <iterator>     // for std::iterator_traits, std::random_access_iterator_tag
+
+#include <boost/array.hpp>
+#include <boost/iterator/iterator_adaptor.hpp>
+#include <boost/type_traits/make_unsigned.hpp>
+
+#include <boost/algorithm/searching/detail/bm_traits.hpp>
+#include <boost/algorithm/searching/instrumentation.hpp>
+#include <boost/algorithm/searching/match_mode.hpp>
+
+/// \cond DOXYGEN_HIDE
+
+namespace boost { namespace algorithm { namespace detail {
+
+//
+//  Case folding for the case-insensitive searchers. Each character is mapped
+//  to its upper case equivalent in a locale, the same way that is_iequal
+//  compares them, so that two characters compare equal ignoring case exactly
+//  when their foldings are equal.
+//
+    template <typename charT, bool isByte = sizeof(charT) == 1> class case_folder;
+
+//  Bytes: the whole mapping is one 256-entry table, built once.
+//  In the "C" locale, there's no need to ask the ctype facet.
+    template <typename charT>
+    class case_folder<charT, true> {
+    public:
+        typedef charT result_type;
+
+        explicit case_folder ( const std::locale &loc ) {
+            if ( loc == std::locale::classic ()) {
+                for ( int i = 0; i < 256; ++i )
+                    table_ [ i ] = static_cast<charT> ( i >= 'a' && i <= 'z' ? i - 'a' + 'A' : i );
+                }
+            else {
+                const std::ctype<char> &ct = std::use_facet<std::ctype<char> > ( loc );
+                for ( std::size_t i = 0; i < table_.size (); ++i )
+                    table_ [ i ] = static_cast<charT> ( ct.toupper ( static_cast<char> ( i )));
+                }
+            }
+
+        charT operator () ( charT c ) const {
+            return table_ [ static_cast<unsigned char> ( c ) ];
+            }
+
+    private:
+        boost::array<charT, 256> table_;
+        };
+
+//  Wider characters: a table for the first 256 code points (which covers
+//  ASCII and Latin-1), and the ctype facet for the rest.
+    template <typename charT>
+    class case_folder<charT, false> {
+        typedef typename boost::make_unsigned<charT>::type unsigned_char_type;
+    public:
+        typedef charT result_type;
+
+        explicit case_folder ( const std::locale &loc )
+                : loc_ ( loc ), ctype_ ( &std::use_facet<std::ctype<charT> > ( loc_ )) {
+            for ( std::size_t i = 0; i < table_.size (); ++i )
+                table_ [ i ] = ctype_->toupper ( static_cast<charT> ( i ));
+            }
+
+        case_folder ( const case_folder &rhs )
+                : loc_ ( rhs.loc_ ), ctype_ ( &std::use_facet<std::ctype<charT> > ( loc_ )), table_ ( rhs.table_ ) {}
+
+        charT operator () ( charT c ) const {
+            const unsigned_char_type u = static_cast<unsigned_char_type> ( c );
+            return u < table_.size () ? table_ [ u ] : ctype_->toupper ( c );
+            }
+
+    private:
+        case_folder &operator = ( const case_folder & );
+
+        std::locale loc_;                   // keeps the facet alive
+        const std::ctype<charT> *ctype_;
+        boost::array<charT, 256> table_;
+        };
+
+
+//  Folds the characters of a corpus as they are read.
+//  The folder is held by pointer, so that copying the iterator is cheap.
+    template <typename Iter, typename Folder>
+    class case_fold_iterator
+        : public boost::iterator_adaptor<case_fold_iterator<Iter, Folder>, Iter,
+                    typename std::iterator_traits<Iter>::value_type,
+                    std::random_access_iterator_tag,
+                    typename std::iterator_traits<Iter>::value_type> {
+        typedef boost::iterator_adaptor<case_fold_iterator<Iter, Folder>, Iter,
+                    typename std::iterator_traits<Iter>::value_type,
+                    std::random_access_iterator_tag,
+                    typename std::iterator_traits<Iter>::value_type> super_t;
+    public:
+        case_fold_iterator () : folder_ ( NULL ) {}
+        case_fold_iterator ( Iter it, const Folder &folder ) : super_t ( it ), folder_ ( &folder ) {}
+
+    private:
+        friend class boost::iterator_core_access;
+        typename super_t::reference dereference () const { return (*folder_) ( *this->base ()); }
+        const Folder *folder_;
+        };
+
+
+//  Unwraps the case_fold_iterators written to it by find_all
+    template <typename OutputIterator>
+    class unfold_output_iterator {
+    public:
+        typedef std::output_iterator_tag iterator_category;
+        typedef void value_type;
+        typedef void difference_type;
+        typedef void pointer;
+        typedef void reference;
+
+        explicit unfold_output_iterator ( OutputIterator out ) : out_ ( out ) {}
+
+        template <typename Iter, typename Folder>
+        unfold_output_iterator &operator = ( const case_fold_iterator<Iter, Folder> &match ) {
+            *out_++ = match.base ();
+            return *this;
+            }
+        unfold_output_iterator &operator *  ()    { return *this; }
+        unfold_output_iterator &operator ++ ()    { return *this; }
+        unfold_output_iterator &operator ++ (int) { return *this; }
+
+        OutputIterator base () const { return out_; }
+
+    private:
+        OutputIterator out_;
+        };
+
+
+//  The guts of iboyer_moore and iboyer_moore_horspool: a copy of the pattern,
+//  folded, and a searcher for that.
+    template <typename patIter, template <typename, typename, typename> class Searcher>
+    class case_insensitive_searcher {
+        typedef typename std::iterator_traits<patIter>::value_type value_type;
+        typedef typename std::vector<value_type>::const_iterator fold_iterator;
+        typedef case_folder<value_type> folder_type;
+    public:
+        case_insensitive_searcher ( patIter first, patIter last, const std::locale &loc )
+                : folder_ ( loc ),
+                  pattern_ ( case_fold_iterator<patIter, folder_type> ( first, folder_ ),
+                             case_fold_iterator<patIter, folder_type> ( last,  folder_ )),
+                  searcher_ ( pattern_.begin (), pattern_.end ()) {}
+
+    //  The searcher refers to our copy of the pattern, so it must be rebuilt
+        case_insensitive_searcher ( const case_insensitive_searcher &rhs )
+                : folder_ ( rhs.folder_ ), pattern_ ( rhs.pattern_ ),
+                  searcher_ ( pattern_.begin (), pattern_.end ()) {}
+
+        template <typename corpusIter>
+        corpusIter operator () ( corpusIter corpus_first, corpusIter corpus_last ) const {
+            typedef case_fold_iterator<corpusIter, folder_type> iter_type;
+            return searcher_ ( iter_type ( corpus_first, folder_ ), iter_type ( corpus_last, folder_ )).base ();
+            }
+
+        template <typename corpusIter, typename OutputIterator>
+        OutputIterator find_all ( corpusIter corpus_first, corpusIter corpus_last,
+                                  OutputIterator out, match_mode_type mode ) const {
+            typedef case_fold_iterator<corpusIter, folder_type> iter_type;
+            return searcher_.find_all ( iter_type ( corpus_first, folder_ ), iter_type ( corpus_last, folder_ ),
+                                        unfold_output_iterator<OutputIterator> ( out ), mode ).base ();
+            }
+
+        std::size_t pattern_length () const { return pattern_.size (); }
+
+    private:
+        case_insensitive_searcher &operator = ( const case_insensitive_searcher & );
+
+        folder_type folder_;
+        std::vector<value_type> pattern_;
+        Searcher<fold_iterator, BM_traits<fold_iterator>, no_instrumentation> searcher_;
+        };
+
+}}} // namespaces
+
+/// \endcond
+
+#endif  //  BOOST_ALGORITHM_SEARCH_DETAIL_CASE_FOLD_HPP
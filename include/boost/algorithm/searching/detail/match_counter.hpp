@@ -0,0 +1,83 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+#ifndef BOOST_ALGORITHM_SEARCH_DETAIL_MATCH_COUNTER_HPP
+#define BOOST_ALGORITHM_SEARCH_DETAIL_MATCH_COUNTER_HPP
+
+#include <cstddef>      // for std::size_t
+#include <iterator>     // for std::output_iterator_tag, std::distance
+
+#include <boost/type_traits/integral_constant.hpp>
+
+#include <boost/algorithm/searching/detail/simd.hpp>
+#include <boost/algorithm/searching/match_mode.hpp>
+
+/// \cond DOXYGEN_HIDE
+
+namespace boost { namespace algorithm { namespace detail {
+
+//  An output iterator that only counts what is written to it, so that the
+//  searchers' count members can use find_all without storing the matches.
+    class match_counter {
+    public:
+        typedef std::output_iterator_tag iterator_category;
+        typedef void value_type;
+        typedef void difference_type;
+        typedef void pointer;
+        typedef void reference;
+
+        match_counter () : count_ ( 0 ) {}
+
+        template <typename T>
+        match_counter &operator = ( const T & ) { ++count_; return *this; }
+        match_counter &operator *  ()    { return *this; }
+        match_counter &operator ++ ()    { return *this; }
+        match_counter &operator ++ ( int ) { return *this; }
+
+        std::size_t count () const { return count_; }
+
+    private:
+        std::size_t count_;
+        };
+
+/*
+    The guts of the searchers' count members.
+
+    A single byte is counted with the vector kernel, when the corpus is
+    contiguous bytes (the 'true_type' overload); matches of one element
+    can't overlap, so the mode doesn't matter. Anything else goes through
+    the searcher's find_all.
+*/
+    template <typename Searcher, typename corpusIter>
+    std::size_t count_matches ( const Searcher &searcher, corpusIter corpus_first, corpusIter corpus_last,
+                                match_mode_type mode ) {
+        return searcher.find_all ( corpus_first, corpus_last, match_counter (), mode ).count ();
+        }
+
+    template <typename Searcher, typename patIter, typename corpusIter>
+    std::size_t count_matches ( const Searcher &searcher, patIter, corpusIter corpus_first, corpusIter corpus_last,
+                                match_mode_type mode, boost::false_type ) {
+        return count_matches ( searcher, corpus_first, corpus_last, mode );
+        }
+
+    template <typename Searcher, typename patIter, typename corpusIter>
+    std::size_t count_matches ( const Searcher &searcher, patIter pat_first, corpusIter corpus_first, corpusIter corpus_last,
+                                match_mode_type mode, boost::true_type ) {
+        if ( searcher.pattern_length () != 1 || corpus_first == corpus_last )
+            return count_matches ( searcher, corpus_first, corpus_last, mode );
+        const unsigned char *first = as_bytes ( corpus_first );
+        return simd_count ( first, first + std::distance ( corpus_first, corpus_last ),
+                            static_cast<unsigned char> ( *pat_first ));
+        }
+
+}}} // namespaces
+
+/// \endcond
+
+#endif  //  BOOST_ALGORITHM_SEARCH_DETAIL_MATCH_COUNTER_HPP
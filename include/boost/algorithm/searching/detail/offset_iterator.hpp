@@ -0,0 +1,61 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+#ifndef BOOST_ALGORITHM_SEARCH_DETAIL_OFFSET_ITERATOR_HPP
+#define BOOST_ALGORITHM_SEARCH_DETAIL_OFFSET_ITERATOR_HPP
+
+#include <iterator>     // for std::distance, std::output_iterator_tag
+
+#include <boost/cstdint.hpp>
+
+/// \cond DOXYGEN_HIDE
+
+namespace boost { namespace algorithm { namespace detail {
+
+//  An output iterator that turns the corpus iterators written to it by a
+//  searcher's find_all into offsets from some base position, and passes
+//  them on. If 'last_match' is given, it is updated with each offset.
+    template <typename corpusIter, typename OutputIterator>
+    class offset_output_iterator {
+    public:
+        typedef std::output_iterator_tag iterator_category;
+        typedef void value_type;
+        typedef void difference_type;
+        typedef void pointer;
+        typedef void reference;
+
+        offset_output_iterator ( corpusIter first, boost::uintmax_t base,
+                                 OutputIterator out, boost::uintmax_t *last_match = NULL )
+            : first_ ( first ), base_ ( base ), out_ ( out ), last_match_ ( last_match ) {}
+
+        offset_output_iterator &operator =  ( corpusIter match ) {
+            const boost::uintmax_t offset = base_ + std::distance ( first_, match );
+            if ( last_match_ != NULL )
+                *last_match_ = offset;
+            *out_++ = offset;
+            return *this;
+            }
+        offset_output_iterator &operator *  ()    { return *this; }
+        offset_output_iterator &operator ++ ()    { return *this; }
+        offset_output_iterator &operator ++ (int) { return *this; }
+
+        OutputIterator base () const { return out_; }
+
+    private:
+        corpusIter first_;
+        boost::uintmax_t base_;
+        OutputIterator out_;
+        boost::uintmax_t *last_match_;
+        };
+
+}}} // namespaces
+
+/// \endcond
+
+#endif  //  BOOST_ALGORITHM_SEARCH_DETAIL_OFFSET_ITERATOR_HPP
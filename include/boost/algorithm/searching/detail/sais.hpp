@@ -0,0 +1,173 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+#ifndef BOOST_ALGORITHM_SEARCH_DETAIL_SAIS_HPP
+#define BOOST_ALGORITHM_SEARCH_DETAIL_SAIS_HPP
+
+#include <cstddef>      // for std::size_t
+#include <vector>
+#include <algorithm>    // for std::fill
+
+/// \cond DOXYGEN_HIDE
+
+namespace boost { namespace algorithm { namespace detail {
+
+/*
+    Suffix sorting by induced sorting (SA-IS).
+
+    's' is a string of 'n' integers in [0, k), whose last element is a zero
+    that occurs nowhere else (the sentinel). On return, 'sa' holds the start
+    of each suffix of 's', in lexicographic order; sa[0] is always n-1.
+
+    Each suffix is classified as S-type (smaller than the suffix after it) or
+    L-type (larger). The leftmost S-type suffixes of each run (LMS suffixes)
+    are sorted first, by sorting the LMS substrings between them and, if two
+    of those are equal, recursing on the string of their names. Then one
+    pass from the left places the L-type suffixes, and one from the right
+    places the S-type ones.
+
+    Everything but the type bits and the buckets is done in 'sa' itself;
+    the reduced string lives in the top half of 'sa' while the recursion
+    fills in the bottom half. Index must be able to hold n, and its largest
+    value marks an empty slot.
+
+Reference:
+    G. Nong, S. Zhang and W. H. Chan, "Two efficient algorithms for linear
+    time suffix array construction", IEEE Transactions on Computers 60(10),
+    2011
+*/
+
+    template <typename Index>
+    struct sais_impl {
+        static const Index k_empty = static_cast<Index> ( -1 );
+
+        static bool is_lms ( const std::vector<bool> &stype, std::size_t i ) {
+            return i > 0 && stype [ i ] && !stype [ i - 1 ];
+            }
+
+    //  The start (or one past the end) of each bucket, from the number of
+    //  times each character occurs
+        static void get_buckets ( const std::vector<Index> &counts, std::vector<Index> &bkt, bool ends ) {
+            Index sum = 0;
+            for ( std::size_t c = 0; c < counts.size (); ++c ) {
+                sum += counts [ c ];
+                bkt [ c ] = ends ? sum : sum - counts [ c ];
+                }
+            }
+
+    //  Place the L-type suffixes from the left, then the S-type ones from the right
+        static void induce ( const Index *s, Index *sa, std::size_t n, const std::vector<bool> &stype,
+                             const std::vector<Index> &counts, std::vector<Index> &bkt ) {
+            get_buckets ( counts, bkt, false );
+            for ( std::size_t i = 0; i < n; ++i ) {
+                const Index j = sa [ i ];
+                if ( j != k_empty && j > 0 && !stype [ j - 1 ] )
+                    sa [ bkt [ s [ j - 1 ]]++ ] = j - 1;
+                }
+
+            get_buckets ( counts, bkt, true );
+            for ( std::size_t i = n; i-- > 0; ) {
+                const Index j = sa [ i ];
+                if ( j != k_empty && j > 0 && stype [ j - 1 ] )
+                    sa [ --bkt [ s [ j - 1 ]]] = j - 1;
+                }
+            }
+
+    //  Are the LMS substrings that start at 'a' and 'b' different?
+        static bool lms_differ ( const Index *s, const std::vector<bool> &stype, std::size_t a, std::size_t b ) {
+            for ( std::size_t d = 0; ; ++d ) {
+                if ( s [ a + d ] != s [ b + d ] || stype [ a + d ] != stype [ b + d ] )
+                    return true;
+                if ( d > 0 && ( is_lms ( stype, a + d ) || is_lms ( stype, b + d )))
+                    return false;
+                }
+            }
+
+        static void sort ( const Index *s, Index *sa, std::size_t n, std::size_t k ) {
+            if ( n == 1 ) {
+                sa [ 0 ] = 0;
+                return;
+                }
+
+            std::vector<bool> stype ( n );
+            stype [ n - 1 ] = true;
+            for ( std::size_t i = n - 1; i-- > 0; )
+                stype [ i ] = s [ i ] < s [ i + 1 ] || ( s [ i ] == s [ i + 1 ] && stype [ i + 1 ] );
+
+        //  Sort the LMS substrings
+            std::vector<Index> counts ( k ), bkt ( k );
+            for ( std::size_t i = 0; i < n; ++i )
+                ++counts [ s [ i ]];
+            get_buckets ( counts, bkt, true );
+            std::fill ( sa, sa + n, k_empty );
+            for ( std::size_t i = 1; i < n; ++i )
+                if ( is_lms ( stype, i ))
+                    sa [ --bkt [ s [ i ]]] = static_cast<Index> ( i );
+            induce ( s, sa, n, stype, counts, bkt );
+
+        //  Move them to the front, in order, and name them
+            std::size_t n1 = 0;
+            for ( std::size_t i = 0; i < n; ++i )
+                if ( is_lms ( stype, sa [ i ] ))
+                    sa [ n1++ ] = sa [ i ];
+            std::fill ( sa + n1, sa + n, k_empty );
+
+            Index name = 0;
+            std::size_t prev = n;
+            for ( std::size_t i = 0; i < n1; ++i ) {
+                const std::size_t pos = sa [ i ];
+                if ( prev == n || lms_differ ( s, stype, pos, prev )) {
+                    ++name;
+                    prev = pos;
+                    }
+                sa [ n1 + pos / 2 ] = name - 1;
+                }
+            for ( std::size_t i = n, j = n; i-- > n1; )
+                if ( sa [ i ] != k_empty )
+                    sa [ --j ] = sa [ i ];
+
+        //  Sort the LMS suffixes, recursing if the names are not unique
+            Index *s1 = sa + n - n1;
+            if ( name < n1 )
+                sort ( s1, sa, n1, name );
+            else
+                for ( std::size_t i = 0; i < n1; ++i )
+                    sa [ s1 [ i ]] = static_cast<Index> ( i );
+
+        //  ... and induce the rest from them
+            for ( std::size_t i = 1, j = 0; i < n; ++i )
+                if ( is_lms ( stype, i ))
+                    s1 [ j++ ] = static_cast<Index> ( i );
+            for ( std::size_t i = 0; i < n1; ++i )
+                sa [ i ] = s1 [ sa [ i ]];
+            std::fill ( sa + n1, sa + n, k_empty );
+
+            get_buckets ( counts, bkt, true );
+            for ( std::size_t i = n1; i-- > 0; ) {
+                const Index j = sa [ i ];
+                sa [ i ] = k_empty;
+                sa [ --bkt [ s [ j ]]] = j;
+                }
+            induce ( s, sa, n, stype, counts, bkt );
+            }
+        };
+
+    template <typename Index>
+    const Index sais_impl<Index>::k_empty;
+
+    template <typename Index>
+    void suffix_sort ( const Index *s, Index *sa, std::size_t n, std::size_t k ) {
+        sais_impl<Index>::sort ( s, sa, n, k );
+        }
+
+}}}
+
+/// \endcond
+
+#endif  //  BOOST_ALGORITHM_SEARCH_DETAIL_SAIS_HPP
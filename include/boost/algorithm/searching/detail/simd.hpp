@@ -0,0 +1,512 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+#ifndef BOOST_ALGORITHM_SEARCH_DETAIL_SIMD_HPP
+#define BOOST_ALGORITHM_SEARCH_DETAIL_SIMD_HPP
+
+#include <cstddef>      // for std::size_t
+#include <cstring>      // for std::memchr, std::memcmp
+#include <string>
+#include <vector>
+#include <iterator>     // for std::iterator_traits
+
+#include <boost/config.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/type_traits/integral_constant.hpp>
+#include <boost/type_traits/is_same.hpp>
+#include <boost/type_traits/is_integral.hpp>
+#include <boost/type_traits/remove_cv.hpp>
+#include <boost/type_traits/conditional.hpp>
+
+//  Vectorized search support.
+//
+//  The vector kernels are selected at compile time from the target flags;
+//  define BOOST_ALGORITHM_NO_SIMD to fall back to the portable searchers.
+#if !defined(BOOST_ALGORITHM_NO_SIMD)
+#  if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || ( defined(_M_IX86_FP) && _M_IX86_FP >= 2 )
+#    define BOOST_ALGORITHM_SEARCH_SSE2
+#  endif
+#  if defined(BOOST_ALGORITHM_SEARCH_SSE2) && defined(__AVX2__)
+#    define BOOST_ALGORITHM_SEARCH_AVX2
+#  endif
+#endif
+
+#if defined(BOOST_ALGORITHM_SEARCH_AVX2)
+#include <immintrin.h>
+#elif defined(BOOST_ALGORITHM_SEARCH_SSE2)
+#include <emmintrin.h>
+#endif
+
+#if defined(_MSC_VER) && defined(BOOST_ALGORITHM_SEARCH_SSE2)
+#include <intrin.h>
+#endif
+
+/// \cond DOXYGEN_HIDE
+
+namespace boost { namespace algorithm { namespace detail {
+
+//  Is 'T' one of the three character types?
+    template <typename T>
+    struct is_byte_type : public boost::integral_constant<bool,
+        boost::is_same<T, char>::value ||
+        boost::is_same<T, signed char>::value ||
+        boost::is_same<T, unsigned char>::value> {};
+
+//  Is 'Iter' an iterator into contiguous storage of a character type?
+//  We recognize pointers, and the iterators of std::vector and std::basic_string,
+//  which are required to be contiguous.
+    template <typename Iter, typename T>
+    struct is_contiguous_iterator_of : public boost::integral_constant<bool,
+        boost::is_same<Iter, T *>::value ||
+        boost::is_same<Iter, const T *>::value ||
+        boost::is_same<Iter, typename std::vector<T>::iterator>::value ||
+        boost::is_same<Iter, typename std::vector<T>::const_iterator>::value ||
+        boost::is_same<Iter, typename std::basic_string<T>::iterator>::value ||
+        boost::is_same<Iter, typename std::basic_string<T>::const_iterator>::value> {};
+
+    template <typename Iter>
+    struct is_contiguous_byte_iterator : public boost::integral_constant<bool,
+        is_contiguous_iterator_of<Iter, char>::value ||
+        is_contiguous_iterator_of<Iter, signed char>::value ||
+        is_contiguous_iterator_of<Iter, unsigned char>::value> {};
+
+//  Should searches over 'Iter' use the vector kernels?
+    template <typename Iter>
+    struct use_simd_search : public boost::integral_constant<bool,
+#if defined(BOOST_ALGORITHM_SEARCH_SSE2)
+        is_contiguous_byte_iterator<Iter>::value
+#else
+        false
+#endif
+        > {};
+
+//  Is 'T' an integer type of 2, 4 or 8 bytes, whose elements can be
+//  compared a vector at a time?
+    template <typename T>
+    struct is_wide_integral : public boost::integral_constant<bool,
+        boost::is_integral<T>::value && !boost::is_same<T, bool>::value &&
+        ( sizeof ( T ) == 2 || sizeof ( T ) == 4 || sizeof ( T ) == 8 )> {};
+
+//  Is 'Iter' an iterator into contiguous storage of such a type? Pointers and
+//  the iterators of std::vector, and of std::basic_string for the wide
+//  character types.
+    template <typename Iter, typename T>
+    struct is_wide_string_iterator : public boost::false_type {};
+
+    template <typename Iter>
+    struct is_wide_string_iterator<Iter, wchar_t> : public boost::integral_constant<bool,
+        boost::is_same<Iter, std::wstring::iterator>::value ||
+        boost::is_same<Iter, std::wstring::const_iterator>::value> {};
+
+#if !defined(BOOST_NO_CXX11_CHAR16_T) && !defined(BOOST_NO_CXX11_CHAR32_T)
+    template <typename Iter>
+    struct is_wide_string_iterator<Iter, char16_t> : public boost::integral_constant<bool,
+        boost::is_same<Iter, std::u16string::iterator>::value ||
+        boost::is_same<Iter, std::u16string::const_iterator>::value> {};
+
+    template <typename Iter>
+    struct is_wide_string_iterator<Iter, char32_t> : public boost::integral_constant<bool,
+        boost::is_same<Iter, std::u32string::iterator>::value ||
+        boost::is_same<Iter, std::u32string::const_iterator>::value> {};
+#endif
+
+    template <typename Iter,
+              typename T = typename boost::remove_cv<typename std::iterator_traits<Iter>::value_type>::type,
+              bool Wide = is_wide_integral<T>::value>
+    struct is_contiguous_wide_iterator : public boost::false_type {};
+
+    template <typename Iter, typename T>
+    struct is_contiguous_wide_iterator<Iter, T, true> : public boost::integral_constant<bool,
+        boost::is_same<Iter, T *>::value ||
+        boost::is_same<Iter, const T *>::value ||
+        boost::is_same<Iter, typename std::vector<T>::iterator>::value ||
+        boost::is_same<Iter, typename std::vector<T>::const_iterator>::value ||
+        is_wide_string_iterator<Iter, T>::value> {};
+
+//  Which vector kernel, if any, a search over 'Iter' should use:
+//  true_type for bytes, simd_wide_tag for wider integers, false_type for none
+    struct simd_wide_tag {};
+
+    template <typename Iter>
+    struct simd_search_kind : public boost::conditional<use_simd_search<Iter>::value, boost::true_type,
+        typename boost::conditional<
+#if defined(BOOST_ALGORITHM_SEARCH_SSE2)
+            is_contiguous_wide_iterator<Iter>::value,
+#else
+            false,
+#endif
+            simd_wide_tag, boost::false_type>::type> {};
+
+//  Get at the bytes underneath a (non-empty) contiguous range
+    template <typename Iter>
+    const unsigned char *as_bytes ( Iter it ) {
+        return reinterpret_cast<const unsigned char *> ( &*it );
+        }
+
+//  Index of the lowest set bit; 'mask' must be non-zero
+    inline unsigned find_first_set ( unsigned mask ) {
+#if defined(__GNUC__)
+        return static_cast<unsigned> ( __builtin_ctz ( mask ));
+#elif defined(_MSC_VER) && defined(BOOST_ALGORITHM_SEARCH_SSE2)
+        unsigned long idx;
+        _BitScanForward ( &idx, mask );
+        return static_cast<unsigned> ( idx );
+#else
+        unsigned idx = 0;
+        while (( mask & 1U ) == 0 ) { mask >>= 1; ++idx; }
+        return idx;
+#endif
+        }
+
+//  Compare 'count' bytes of the corpus against the pattern
+    template <typename patIter>
+    bool equal_bytes ( const unsigned char *p, patIter pat, std::size_t count ) {
+        for ( std::size_t i = 0; i < count; ++i )
+            if ( p [ i ] != static_cast<unsigned char> ( pat [ i ] ))
+                return false;
+        return true;
+        }
+
+    inline bool equal_bytes ( const unsigned char *p, const char *pat, std::size_t count ) {
+        return std::memcmp ( p, pat, count ) == 0;
+        }
+
+    inline bool equal_bytes ( const unsigned char *p, const signed char *pat, std::size_t count ) {
+        return std::memcmp ( p, pat, count ) == 0;
+        }
+
+    inline bool equal_bytes ( const unsigned char *p, const unsigned char *pat, std::size_t count ) {
+        return std::memcmp ( p, pat, count ) == 0;
+        }
+
+//  Check every candidate position recorded in 'mask'
+    template <typename patIter>
+    const unsigned char *verify_candidates ( unsigned mask, const unsigned char *p,
+                                                patIter pat, std::size_t m ) {
+        while ( mask != 0 ) {
+            const unsigned char *cand = p + find_first_set ( mask );
+            if ( equal_bytes ( cand + 1, pat + 1, m - 2 ))
+                return cand;
+            mask &= mask - 1;
+            }
+        return NULL;
+        }
+
+/*
+    Search [first, last) for the m-byte pattern at 'pat', where 1 <= m <= last - first.
+
+    The kernel compares the first and last bytes of the pattern against 16 (SSE2)
+    or 32 (AVX2) positions of the corpus at a time, and only verifies the positions
+    where both bytes match. Returns 'last' if the pattern is not found.
+
+    http://0x80.pl/articles/simd-strfind.html
+*/
+    template <typename patIter>
+    const unsigned char *simd_search ( const unsigned char *first, const unsigned char *last,
+                                       patIter pat, std::size_t m ) {
+        if ( m == 1 ) {
+            const void *p = std::memchr ( first, static_cast<unsigned char> ( pat [ 0 ] ), last - first );
+            return p == NULL ? last : static_cast<const unsigned char *> ( p );
+            }
+
+        const unsigned char k_first = static_cast<unsigned char> ( pat [ 0 ] );
+        const unsigned char k_last  = static_cast<unsigned char> ( pat [ m - 1 ] );
+        const std::size_t positions = static_cast<std::size_t> ( last - first ) - m + 1;
+        const unsigned char *curPos = first;
+        const unsigned char *const endPos = first + positions;  // one past the last candidate
+
+#if defined(BOOST_ALGORITHM_SEARCH_AVX2)
+        {
+        const __m256i v_first = _mm256_set1_epi8 ( static_cast<char> ( k_first ));
+        const __m256i v_last  = _mm256_set1_epi8 ( static_cast<char> ( k_last ));
+        for ( ; endPos - curPos >= 32; curPos += 32 ) {
+            const __m256i b_first = _mm256_loadu_si256 ( reinterpret_cast<const __m256i *> ( curPos ));
+            const __m256i b_last  = _mm256_loadu_si256 ( reinterpret_cast<const __m256i *> ( curPos + m - 1 ));
+            const unsigned mask = static_cast<unsigned> ( _mm256_movemask_epi8 ( _mm256_and_si256 (
+                    _mm256_cmpeq_epi8 ( b_first, v_first ), _mm256_cmpeq_epi8 ( b_last, v_last ))));
+            if ( mask != 0 ) {
+                const unsigned char *found = verify_candidates ( mask, curPos, pat, m );
+                if ( found != NULL ) return found;
+                }
+            }
+        }
+#endif
+
+#if defined(BOOST_ALGORITHM_SEARCH_SSE2)
+        {
+        const __m128i v_first = _mm_set1_epi8 ( static_cast<char> ( k_first ));
+        const __m128i v_last  = _mm_set1_epi8 ( static_cast<char> ( k_last ));
+        for ( ; endPos - curPos >= 16; curPos += 16 ) {
+            const __m128i b_first = _mm_loadu_si128 ( reinterpret_cast<const __m128i *> ( curPos ));
+            const __m128i b_last  = _mm_loadu_si128 ( reinterpret_cast<const __m128i *> ( curPos + m - 1 ));
+            const unsigned mask = static_cast<unsigned> ( _mm_movemask_epi8 ( _mm_and_si128 (
+                    _mm_cmpeq_epi8 ( b_first, v_first ), _mm_cmpeq_epi8 ( b_last, v_last ))));
+            if ( mask != 0 ) {
+                const unsigned char *found = verify_candidates ( mask, curPos, pat, m );
+                if ( found != NULL ) return found;
+                }
+            }
+        }
+#endif
+
+    //  Whatever is left over, a position at a time
+        for ( ; curPos != endPos; ++curPos )
+            if ( curPos [ 0 ] == k_first && curPos [ m - 1 ] == k_last &&
+                                    equal_bytes ( curPos + 1, pat + 1, m - 2 ))
+                return curPos;
+
+        return last;
+        }
+
+/*
+    Count the bytes in [first, last) that are equal to 'value'.
+
+    The comparison results (0 or -1 in each lane) are subtracted from a vector
+    of byte counters, which are summed with psadbw before any of them can
+    overflow, every 255 blocks.
+*/
+    inline std::size_t simd_count ( const unsigned char *first, const unsigned char *last, unsigned char value ) {
+        std::size_t retVal = 0;
+        const unsigned char *curPos = first;
+
+#if defined(BOOST_ALGORITHM_SEARCH_AVX2)
+        {
+        const __m256i v_value = _mm256_set1_epi8 ( static_cast<char> ( value ));
+        const __m256i v_zero  = _mm256_setzero_si256 ();
+        while ( last - curPos >= 32 ) {
+            __m256i counts = v_zero;
+            for ( int i = 0; i < 255 && last - curPos >= 32; ++i, curPos += 32 ) {
+                const __m256i block = _mm256_loadu_si256 ( reinterpret_cast<const __m256i *> ( curPos ));
+                counts = _mm256_sub_epi8 ( counts, _mm256_cmpeq_epi8 ( block, v_value ));
+                }
+            const __m256i sums = _mm256_sad_epu8 ( counts, v_zero );
+            retVal += static_cast<std::size_t> ( _mm256_extract_epi64 ( sums, 0 ) + _mm256_extract_epi64 ( sums, 1 ) +
+                                                 _mm256_extract_epi64 ( sums, 2 ) + _mm256_extract_epi64 ( sums, 3 ));
+            }
+        }
+#endif
+
+#if defined(BOOST_ALGORITHM_SEARCH_SSE2)
+        {
+        const __m128i v_value = _mm_set1_epi8 ( static_cast<char> ( value ));
+        const __m128i v_zero  = _mm_setzero_si128 ();
+        while ( last - curPos >= 16 ) {
+            __m128i counts = v_zero;
+            for ( int i = 0; i < 255 && last - curPos >= 16; ++i, curPos += 16 ) {
+                const __m128i block = _mm_loadu_si128 ( reinterpret_cast<const __m128i *> ( curPos ));
+                counts = _mm_sub_epi8 ( counts, _mm_cmpeq_epi8 ( block, v_value ));
+                }
+            const __m128i sums = _mm_sad_epu8 ( counts, v_zero );
+            retVal += static_cast<std::size_t> ( _mm_cvtsi128_si32 ( sums ) + _mm_cvtsi128_si32 ( _mm_srli_si128 ( sums, 8 )));
+            }
+        }
+#endif
+
+    //  Whatever is left over, a byte at a time
+        for ( ; curPos != last; ++curPos )
+            if ( *curPos == value )
+                ++retVal;
+
+        return retVal;
+        }
+
+#if defined(BOOST_ALGORITHM_SEARCH_SSE2)
+//  Lane-wise equality for elements of 2, 4 and 8 bytes. SSE2 has no 64-bit
+//  compare, so both 32-bit halves of a lane have to match.
+    template <std::size_t Size> struct wide_lanes;
+
+    template <> struct wide_lanes<2> {
+        static __m128i set1  ( boost::uint64_t v ) { return _mm_set1_epi16 ( static_cast<short> ( v )); }
+        static __m128i cmpeq ( __m128i a, __m128i b ) { return _mm_cmpeq_epi16 ( a, b ); }
+#if defined(BOOST_ALGORITHM_SEARCH_AVX2)
+        static __m256i set1_256  ( boost::uint64_t v ) { return _mm256_set1_epi16 ( static_cast<short> ( v )); }
+        static __m256i cmpeq ( __m256i a, __m256i b ) { return _mm256_cmpeq_epi16 ( a, b ); }
+#endif
+        };
+
+    template <> struct wide_lanes<4> {
+        static __m128i set1  ( boost::uint64_t v ) { return _mm_set1_epi32 ( static_cast<int> ( v )); }
+        static __m128i cmpeq ( __m128i a, __m128i b ) { return _mm_cmpeq_epi32 ( a, b ); }
+#if defined(BOOST_ALGORITHM_SEARCH_AVX2)
+        static __m256i set1_256  ( boost::uint64_t v ) { return _mm256_set1_epi32 ( static_cast<int> ( v )); }
+        static __m256i cmpeq ( __m256i a, __m256i b ) { return _mm256_cmpeq_epi32 ( a, b ); }
+#endif
+        };
+
+    template <> struct wide_lanes<8> {
+        static __m128i set1  ( boost::uint64_t v ) { return _mm_set1_epi64x ( static_cast<long long> ( v )); }
+        static __m128i cmpeq ( __m128i a, __m128i b ) {
+            const __m128i halves = _mm_cmpeq_epi32 ( a, b );
+            return _mm_and_si128 ( halves, _mm_shuffle_epi32 ( halves, _MM_SHUFFLE ( 2, 3, 0, 1 )));
+            }
+#if defined(BOOST_ALGORITHM_SEARCH_AVX2)
+        static __m256i set1_256  ( boost::uint64_t v ) { return _mm256_set1_epi64x ( static_cast<long long> ( v )); }
+        static __m256i cmpeq ( __m256i a, __m256i b ) { return _mm256_cmpeq_epi64 ( a, b ); }
+#endif
+        };
+
+//  Compare 'count' elements of the corpus against the pattern
+    template <typename T, typename patIter>
+    bool equal_elements ( const T *p, patIter pat, std::size_t count ) {
+        for ( std::size_t i = 0; i < count; ++i )
+            if ( p [ i ] != pat [ i ] )
+                return false;
+        return true;
+        }
+
+    template <typename T>
+    bool equal_elements ( const T *p, const T *pat, std::size_t count ) {
+        return std::memcmp ( p, pat, count * sizeof ( T )) == 0;
+        }
+
+    template <typename T>
+    bool equal_elements ( const T *p, T *pat, std::size_t count ) {
+        return std::memcmp ( p, pat, count * sizeof ( T )) == 0;
+        }
+
+//  Check every candidate lane recorded in the byte mask 'mask'
+    template <typename T, typename patIter>
+    const T *verify_wide_candidates ( unsigned mask, const T *p, patIter pat, std::size_t m ) {
+        const unsigned k_lane_bits = ( 1U << sizeof ( T )) - 1;
+        const std::size_t k_inner = m > 2 ? m - 2 : 0;
+        while ( mask != 0 ) {
+            const unsigned lane = find_first_set ( mask ) / sizeof ( T );
+            if ( equal_elements ( p + lane + 1, pat + 1, k_inner ))
+                return p + lane;
+            mask &= ~( k_lane_bits << ( lane * sizeof ( T )));
+            }
+        return NULL;
+        }
+
+/*
+    The same as simd_search, for elements of 2, 4 or 8 bytes: the first and last
+    elements of the pattern are compared against a vector of positions at a time,
+    and only the positions where both match are verified. No tables are used.
+*/
+    template <typename T, typename patIter>
+    const T *simd_search_wide ( const T *first, const T *last, patIter pat, std::size_t m ) {
+        typedef wide_lanes<sizeof ( T )> lanes;
+        const T k_first = pat [ 0 ];
+        const T k_last  = pat [ m - 1 ];
+        const std::size_t positions = static_cast<std::size_t> ( last - first ) - m + 1;
+        const T *curPos = first;
+        const T *const endPos = first + positions;  // one past the last candidate
+
+#if defined(BOOST_ALGORITHM_SEARCH_AVX2)
+        {
+        const std::ptrdiff_t k_lanes = 32 / sizeof ( T );
+        const __m256i v_first = lanes::set1_256 ( static_cast<boost::uint64_t> ( k_first ));
+        const __m256i v_last  = lanes::set1_256 ( static_cast<boost::uint64_t> ( k_last ));
+        for ( ; endPos - curPos >= k_lanes; curPos += k_lanes ) {
+            const __m256i b_first = _mm256_loadu_si256 ( reinterpret_cast<const __m256i *> ( curPos ));
+            const __m256i b_last  = _mm256_loadu_si256 ( reinterpret_cast<const __m256i *> ( curPos + m - 1 ));
+            const unsigned mask = static_cast<unsigned> ( _mm256_movemask_epi8 ( _mm256_and_si256 (
+                    lanes::cmpeq ( b_first, v_first ), lanes::cmpeq ( b_last, v_last ))));
+            if ( mask != 0 ) {
+                const T *found = verify_wide_candidates ( mask, curPos, pat, m );
+                if ( found != NULL ) return found;
+                }
+            }
+        }
+#endif
+
+        {
+        const std::ptrdiff_t k_lanes = 16 / sizeof ( T );
+        const __m128i v_first = lanes::set1 ( static_cast<boost::uint64_t> ( k_first ));
+        const __m128i v_last  = lanes::set1 ( static_cast<boost::uint64_t> ( k_last ));
+        for ( ; endPos - curPos >= k_lanes; curPos += k_lanes ) {
+            const __m128i b_first = _mm_loadu_si128 ( reinterpret_cast<const __m128i *> ( curPos ));
+            const __m128i b_last  = _mm_loadu_si128 ( reinterpret_cast<const __m128i *> ( curPos + m - 1 ));
+            const unsigned mask = static_cast<unsigned> ( _mm_movemask_epi8 ( _mm_and_si128 (
+                    lanes::cmpeq ( b_first, v_first ), lanes::cmpeq ( b_last, v_last ))));
+            if ( mask != 0 ) {
+                const T *found = verify_wide_candidates ( mask, curPos, pat, m );
+                if ( found != NULL ) return found;
+                }
+            }
+        }
+
+    //  Whatever is left over, a position at a time
+        for ( ; curPos != endPos; ++curPos )
+            if ( curPos [ 0 ] == k_first && curPos [ m - 1 ] == k_last &&
+                                    equal_elements ( curPos + 1, pat + 1, m > 2 ? m - 2 : 0 ))
+                return curPos;
+
+        return last;
+        }
+#endif
+
+//  Get at the elements underneath a (non-empty) contiguous range
+    template <typename Iter>
+    struct simd_element : public boost::remove_cv<typename std::iterator_traits<Iter>::value_type> {};
+
+    template <typename Iter>
+    const typename simd_element<Iter>::type *as_elements ( Iter it ) {
+        return &*it;
+        }
+
+//  Patterns up to this long are searched for by the free functions with
+//  simd_search directly; building the tables would cost more than it saves.
+    static const std::size_t k_short_pattern_length = 16;
+
+/*
+    The free search functions (boyer_moore_search, etc) are usually called once
+    for each pattern, so the cost of building a searcher is not spread over
+    several searches. For short patterns over contiguous bytes, the vector
+    kernel needs no tables at all, so use it instead.
+*/
+    template <typename Searcher, typename patIter, typename corpusIter>
+    corpusIter one_shot_search ( corpusIter corpus_first, corpusIter corpus_last,
+                                 patIter pat_first, patIter pat_last, boost::false_type ) {
+        Searcher s ( pat_first, pat_last );
+        return s ( corpus_first, corpus_last );
+        }
+
+    template <typename Searcher, typename patIter, typename corpusIter>
+    corpusIter one_shot_search ( corpusIter corpus_first, corpusIter corpus_last,
+                                 patIter pat_first, patIter pat_last, boost::true_type ) {
+        BOOST_STATIC_ASSERT (( boost::is_same<
+            typename std::iterator_traits<patIter>::value_type,
+            typename std::iterator_traits<corpusIter>::value_type>::value ));
+
+        const std::size_t m = std::distance ( pat_first, pat_last );
+        const std::size_t n = std::distance ( corpus_first, corpus_last );
+        if ( m == 0 || m > k_short_pattern_length || n < m )
+            return one_shot_search<Searcher> ( corpus_first, corpus_last, pat_first, pat_last, boost::false_type ());
+
+        const unsigned char *first = as_bytes ( corpus_first );
+        return corpus_first + ( simd_search ( first, first + n, pat_first, m ) - first );
+        }
+
+    template <typename Searcher, typename patIter, typename corpusIter>
+    corpusIter one_shot_search ( corpusIter corpus_first, corpusIter corpus_last,
+                                 patIter pat_first, patIter pat_last, simd_wide_tag ) {
+        BOOST_STATIC_ASSERT (( boost::is_same<
+            typename std::iterator_traits<patIter>::value_type,
+            typename std::iterator_traits<corpusIter>::value_type>::value ));
+
+        const std::size_t m = std::distance ( pat_first, pat_last );
+        const std::size_t n = std::distance ( corpus_first, corpus_last );
+        if ( m == 0 || m > k_short_pattern_length || n < m )
+            return one_shot_search<Searcher> ( corpus_first, corpus_last, pat_first, pat_last, boost::false_type ());
+
+#if defined(BOOST_ALGORITHM_SEARCH_SSE2)
+        const typename simd_element<corpusIter>::type *first = as_elements ( corpus_first );
+        return corpus_first + ( simd_search_wide ( first, first + n, pat_first, m ) - first );
+#else
+        return one_shot_search<Searcher> ( corpus_first, corpus_last, pat_first, pat_last, boost::false_type ());
+#endif
+        }
+
+}}} // namespaces
+
+/// \endcond
+
+#endif  //  BOOST_ALGORITHM_SEARCH_DETAIL_SIMD_HPP
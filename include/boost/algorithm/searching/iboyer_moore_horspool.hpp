@@ -0,0 +1,169 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+#ifndef BOOST_ALGORITHM_IBOYER_MOORE_HORSPOOL_SEARCH_HPP
+#define BOOST_ALGORITHM_IBOYER_MOORE_HORSPOOL_SEARCH_HPP
+
+#include <locale>
+#include <iterator>     // for std::iterator_traits
+
+#include <boost/static_assert.hpp>
+
+#include <boost/range/begin.hpp>
+#include <boost/range/end.hpp>
+
+#include <boost/type_traits/is_same.hpp>
+
+#include <boost/algorithm/searching/boyer_moore_horspool.hpp>
+#include <boost/algorithm/searching/detail/case_fold.hpp>
+#include <boost/algorithm/searching/detail/match_counter.hpp>
+#include <boost/algorithm/searching/match_mode.hpp>
+
+namespace boost { namespace algorithm {
+
+/*
+    A case-insensitive version of the Boyer-Moore-Horspool searcher.
+
+    Characters are compared the same way as is_iequal does, by converting
+    both to upper case in a locale. The pattern is converted once, in the
+    constructor, and the tables are built from that; the corpus is converted
+    a character at a time as the search reads it, using a table of the
+    conversions for the first 256 characters (and just for ASCII, in the
+    "C" locale).
+
+    Requirements:
+        * Random access iterators
+        * The two iterator types (patIter and corpusIter) must
+            "point to" the same underlying type, which must be a
+            character type with a std::ctype facet (char or wchar_t)
+*/
+
+    template <typename patIter>
+    class iboyer_moore_horspool {
+        typedef detail::case_insensitive_searcher<patIter, boyer_moore_horspool> searcher_type;
+    public:
+        iboyer_moore_horspool ( patIter first, patIter last, const std::locale &loc = std::locale ())
+                : searcher_ ( first, last, loc ) {}
+
+        ~iboyer_moore_horspool () {}
+
+        /// \fn operator ( corpusIter corpus_first, corpusIter corpus_last )
+        /// \brief Searches the corpus for the pattern that was passed into the constructor, ignoring case
+        ///
+        /// \param corpus_first The start of the data to search (Random Access Iterator)
+        /// \param corpus_last  One past the end of the data to search
+        ///
+        template <typename corpusIter>
+        corpusIter operator () ( corpusIter corpus_first, corpusIter corpus_last ) const {
+            BOOST_STATIC_ASSERT (( boost::is_same<
+                typename std::iterator_traits<patIter>::value_type,
+                typename std::iterator_traits<corpusIter>::value_type>::value ));
+            return searcher_ ( corpus_first, corpus_last );
+            }
+
+        template <typename Range>
+        typename boost::range_iterator<Range>::type operator () ( Range &r ) const {
+            return (*this) (boost::begin(r), boost::end(r));
+            }
+
+        /// \fn find_all ( corpusIter corpus_first, corpusIter corpus_last, OutputIterator out, match_mode_type mode )
+        /// \brief Finds every occurrence of the pattern in the corpus, ignoring case
+        ///
+        /// \param corpus_first The start of the data to search (Random Access Iterator)
+        /// \param corpus_last  One past the end of the data to search
+        /// \param out          An output iterator which receives the start of each match
+        /// \param mode         Whether matches may overlap
+        ///
+        template <typename corpusIter, typename OutputIterator>
+        OutputIterator find_all ( corpusIter corpus_first, corpusIter corpus_last,
+                                  OutputIterator out, match_mode_type mode = match_overlapping ) const {
+            BOOST_STATIC_ASSERT (( boost::is_same<
+                typename std::iterator_traits<patIter>::value_type,
+                typename std::iterator_traits<corpusIter>::value_type>::value ));
+            return searcher_.find_all ( corpus_first, corpus_last, out, mode );
+            }
+
+        template <typename Range, typename OutputIterator>
+        OutputIterator find_all ( Range &r, OutputIterator out, match_mode_type mode = match_overlapping ) const {
+            return this->find_all (boost::begin(r), boost::end(r), out, mode);
+            }
+
+        /// \fn count ( corpusIter corpus_first, corpusIter corpus_last, match_mode_type mode )
+        /// \brief Counts the occurrences of the pattern in the corpus, ignoring case
+        ///
+        /// \param corpus_first The start of the data to search (Random Access Iterator)
+        /// \param corpus_last  One past the end of the data to search
+        /// \param mode         Whether or not to count overlapping matches
+        ///
+        template <typename corpusIter>
+        std::size_t count ( corpusIter corpus_first, corpusIter corpus_last, match_mode_type mode = match_overlapping ) const {
+            return detail::count_matches ( *this, corpus_first, corpus_last, mode );
+            }
+
+        template <typename Range>
+        std::size_t count ( Range &r, match_mode_type mode = match_overlapping ) const {
+            return this->count (boost::begin(r), boost::end(r), mode);
+            }
+
+    //  The length of the pattern that was passed into the constructor
+        std::size_t pattern_length () const { return searcher_.pattern_length (); }
+
+    private:
+/// \cond DOXYGEN_HIDE
+        searcher_type searcher_;
+/// \endcond
+        };
+
+/// \fn iboyer_moore_horspool_search ( corpusIter corpus_first, corpusIter corpus_last,
+///       patIter pat_first, patIter pat_last, const std::locale &loc )
+/// \brief Searches the corpus for the pattern, ignoring case
+///
+/// \param corpus_first The start of the data to search (Random Access Iterator)
+/// \param corpus_last  One past the end of the data to search
+/// \param pat_first    The start of the pattern to search for (Random Access Iterator)
+/// \param pat_last     One past the end of the data to search for
+/// \param loc          The locale used to compare characters
+///
+    template <typename patIter, typename corpusIter>
+    corpusIter iboyer_moore_horspool_search (
+                  corpusIter corpus_first, corpusIter corpus_last,
+                  patIter pat_first, patIter pat_last, const std::locale &loc = std::locale ())
+    {
+        iboyer_moore_horspool<patIter> s ( pat_first, pat_last, loc );
+        return s ( corpus_first, corpus_last );
+    }
+
+    template <typename PatternRange, typename CorpusRange>
+    typename boost::range_iterator<CorpusRange>::type
+    iboyer_moore_horspool_search ( CorpusRange &corpus, const PatternRange &pattern, const std::locale &loc = std::locale ())
+    {
+        typedef typename boost::range_iterator<const PatternRange>::type pattern_iterator;
+        iboyer_moore_horspool<pattern_iterator> s ( boost::begin(pattern), boost::end (pattern), loc );
+        return s (boost::begin (corpus), boost::end (corpus));
+    }
+
+
+    //  Creator functions -- take a pattern range, return an object
+    template <typename Range>
+    boost::algorithm::iboyer_moore_horspool<typename boost::range_iterator<const Range>::type>
+    make_iboyer_moore_horspool ( const Range &r, const std::locale &loc = std::locale ()) {
+        return boost::algorithm::iboyer_moore_horspool
+            <typename boost::range_iterator<const Range>::type> (boost::begin(r), boost::end(r), loc);
+        }
+
+    template <typename Range>
+    boost::algorithm::iboyer_moore_horspool<typename boost::range_iterator<Range>::type>
+    make_iboyer_moore_horspool ( Range &r, const std::locale &loc = std::locale ()) {
+        return boost::algorithm::iboyer_moore_horspool
+            <typename boost::range_iterator<Range>::type> (boost::begin(r), boost::end(r), loc);
+        }
+
+}}
+
+#endif  //  BOOST_ALGORITHM_IBOYER_MOORE_HORSPOOL_SEARCH_HPP
@@ -0,0 +1,125 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+#ifndef BOOST_ALGORITHM_SEARCH_INSTRUMENTATION_HPP
+#define BOOST_ALGORITHM_SEARCH_INSTRUMENTATION_HPP
+
+#include <cstddef>      // for std::size_t
+
+#include <boost/config.hpp>
+#include <boost/cstdint.hpp>
+
+#ifndef BOOST_NO_CXX11_HDR_ATOMIC
+#include <atomic>
+#endif
+
+/*! \file
+    Instrumentation policies for boyer_moore, boyer_moore_horspool and
+    knuth_morris_pratt.
+
+    A searcher calls its policy as it works:
+        compare ()      for each comparison of a pattern element with a corpus element
+        shift ( n )     each time the pattern moves n places along the corpus
+        verify ()       each time it starts comparing the pattern with the corpus
+                        at a new alignment (Boyer-Moore and Horspool)
+        match ()        for each match it reports
+
+    The functions are const, since searching is; a policy that records
+    anything keeps its counts in mutable members. The policy object lives in
+    the searcher, and is reached through its instrumentation () member.
+*/
+
+namespace boost { namespace algorithm {
+
+//! The default policy: records nothing, and compiles away completely
+    struct no_instrumentation {
+        void compare () const {}
+        void shift ( std::size_t ) const {}
+        void verify () const {}
+        void match () const {}
+        };
+
+//! Counts everything, with plain integers; not safe to share between threads
+    class search_counters {
+    public:
+        search_counters () { reset (); }
+
+        void compare () const { ++comparisons_; }
+        void shift ( std::size_t n ) const { ++shifts_; shift_total_ += n; }
+        void verify () const { ++verifications_; }
+        void match () const { ++matches_; }
+
+        boost::uintmax_t comparisons ()   const { return comparisons_; }
+        boost::uintmax_t shifts ()        const { return shifts_; }
+        boost::uintmax_t shift_total ()   const { return shift_total_; }
+        boost::uintmax_t verifications () const { return verifications_; }
+        boost::uintmax_t matches ()       const { return matches_; }
+
+    //  The mean distance the pattern moved on each shift
+        double average_shift () const { return shifts_ == 0 ? 0.0 : static_cast<double> ( shift_total_ ) / shifts_; }
+
+        void reset () { comparisons_ = shifts_ = shift_total_ = verifications_ = matches_ = 0; }
+
+    private:
+        mutable boost::uintmax_t comparisons_;
+        mutable boost::uintmax_t shifts_;
+        mutable boost::uintmax_t shift_total_;
+        mutable boost::uintmax_t verifications_;
+        mutable boost::uintmax_t matches_;
+        };
+
+#ifndef BOOST_NO_CXX11_HDR_ATOMIC
+//! Counts everything, with relaxed atomic increments, so that one searcher
+//! can be shared between threads
+    class atomic_search_counters {
+    public:
+        atomic_search_counters () { reset (); }
+        atomic_search_counters ( const atomic_search_counters &rhs ) { *this = rhs; }
+        atomic_search_counters &operator = ( const atomic_search_counters &rhs ) {
+            comparisons_   = rhs.comparisons ();
+            shifts_        = rhs.shifts ();
+            shift_total_   = rhs.shift_total ();
+            verifications_ = rhs.verifications ();
+            matches_       = rhs.matches ();
+            return *this;
+            }
+
+        void compare () const { comparisons_.fetch_add ( 1, std::memory_order_relaxed ); }
+        void shift ( std::size_t n ) const {
+            shifts_.fetch_add ( 1, std::memory_order_relaxed );
+            shift_total_.fetch_add ( n, std::memory_order_relaxed );
+            }
+        void verify () const { verifications_.fetch_add ( 1, std::memory_order_relaxed ); }
+        void match () const { matches_.fetch_add ( 1, std::memory_order_relaxed ); }
+
+        boost::uintmax_t comparisons ()   const { return comparisons_.load ( std::memory_order_relaxed ); }
+        boost::uintmax_t shifts ()        const { return shifts_.load ( std::memory_order_relaxed ); }
+        boost::uintmax_t shift_total ()   const { return shift_total_.load ( std::memory_order_relaxed ); }
+        boost::uintmax_t verifications () const { return verifications_.load ( std::memory_order_relaxed ); }
+        boost::uintmax_t matches ()       const { return matches_.load ( std::memory_order_relaxed ); }
+
+        double average_shift () const {
+            const boost::uintmax_t n = shifts ();
+            return n == 0 ? 0.0 : static_cast<double> ( shift_total ()) / n;
+            }
+
+        void reset () { comparisons_ = 0; shifts_ = 0; shift_total_ = 0; verifications_ = 0; matches_ = 0; }
+
+    private:
+        mutable std::atomic<boost::uintmax_t> comparisons_;
+        mutable std::atomic<boost::uintmax_t> shifts_;
+        mutable std::atomic<boost::uintmax_t> shift_total_;
+        mutable std::atomic<boost::uintmax_t> verifications_;
+        mutable std::atomic<boost::uintmax_t> matches_;
+        };
+#endif
+
+}}
+
+#endif  //  BOOST_ALGORITHM_SEARCH_INSTRUMENTATION_HPP
@@ -11,10 +11,15 @@
 #define BOOST_ALGORITHM_KNUTH_MORRIS_PRATT_SEARCH_HPP
 
 #include <vector>
-#include <iterator>     // for std::iterator_traits
+#include <memory>       // for std::allocator
+#include <iosfwd>       // for std::basic_istream
+#include <iterator>     // for std::iterator_traits, std::istreambuf_iterator
 
 #include <boost/assert.hpp>
 #include <boost/static_assert.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/optional.hpp>
+#include <boost/core/allocator_access.hpp>
 
 #include <boost/range/begin.hpp>
 #include <boost/range/end.hpp>
@@ -23,6 +28,11 @@
 #include <boost/type_traits/is_same.hpp>
 
 #include <boost/algorithm/searching/detail/debugging.hpp>
+#include <boost/algorithm/searching/detail/match_counter.hpp>
+#include <boost/algorithm/searching/detail/simd.hpp>
+#include <boost/algorithm/searching/instrumentation.hpp>
+#include <boost/algorithm/searching/match_mode.hpp>
+#include <boost/algorithm/searching/segmented_iterator.hpp>
 
 // #define  BOOST_ALGORITHM_KNUTH_MORRIS_PRATT_DEBUG
 
@@ -37,18 +47,28 @@ namespace boost { namespace algorithm {
         * Random-access iterators
         * The two iterator types (I1 and I2) must "point to" the same underlying type.
 
+    The skip table is allocated with Alloc (rebound to difference_type).
+
+    The Instrumentation policy (see instrumentation.hpp) is told about each
+    comparison, shift and match; the default does nothing. The matcher never
+    goes back to re-examine the corpus, so there are no verifications.
+
     http://en.wikipedia.org/wiki/Knuth-Morris-Pratt_algorithm
     http://www.inf.fh-flensburg.de/lang/algorithmen/pattern/kmpen.htm
 */
 
-    template <typename patIter>
+    template <typename patIter, typename Alloc = std::allocator<char>,
+              typename Instrumentation = no_instrumentation>
     class knuth_morris_pratt {
         typedef typename std::iterator_traits<patIter>::difference_type difference_type;
+        typedef typename boost::allocator_rebind<Alloc, difference_type>::type difference_allocator;
     public:
-        knuth_morris_pratt ( patIter first, patIter last ) 
+        typedef Alloc allocator_type;
+
+        knuth_morris_pratt ( patIter first, patIter last, const allocator_type &alloc = allocator_type ())
                 : pat_first ( first ), pat_last ( last ), 
                   k_pattern_length ( std::distance ( pat_first, pat_last )),
-                  skip_ ( k_pattern_length + 1 ) {
+                  skip_ ( k_pattern_length + 1, 0, difference_allocator ( alloc )) {
 #ifdef NEW_KMP
             preKmp ( pat_first, pat_last );
 #else
@@ -81,7 +101,8 @@ namespace boost { namespace algorithm {
             if ( k_corpus_length < k_pattern_length ) 
                 return corpus_last;
 
-            return do_search   ( corpus_first, corpus_last, k_corpus_length );
+            return do_search   ( corpus_first, corpus_last, k_corpus_length,
+                                 typename detail::segmented_dispatch<corpusIter>::type ());
             }
     
         template <typename Range>
@@ -89,11 +110,192 @@ namespace boost { namespace algorithm {
             return (*this) (boost::begin(r), boost::end(r));
             }
 
+        /// \fn find_all ( corpusIter corpus_first, corpusIter corpus_last, OutputIterator out, match_mode_type mode )
+        /// \brief Finds every occurrence of the pattern in the corpus
+        /// 
+        /// \param corpus_first The start of the data to search (Random Access Iterator)
+        /// \param corpus_last  One past the end of the data to search
+        /// \param out          An output iterator which receives the start of each match
+        /// \param mode         Whether or not to report overlapping matches
+        ///
+        template <typename corpusIter, typename OutputIterator>
+        OutputIterator find_all ( corpusIter corpus_first, corpusIter corpus_last, 
+                        OutputIterator out, match_mode_type mode = match_overlapping ) const {
+            BOOST_STATIC_ASSERT (( boost::is_same<
+                typename std::iterator_traits<patIter>::value_type, 
+                typename std::iterator_traits<corpusIter>::value_type>::value ));
+            if ( corpus_first == corpus_last ) return out;  // if nothing to search, we didn't find it!
+            if ( pat_first == pat_last )       return out;  // empty pattern matches nothing here
+
+            const difference_type k_corpus_length = std::distance ( corpus_first, corpus_last );
+        //  If the pattern is larger than the corpus, we can't find it!
+            if ( k_corpus_length < k_pattern_length ) 
+                return out;
+
+            return do_find_all ( corpus_first, out, k_corpus_length, mode,
+                                 typename detail::segmented_dispatch<corpusIter>::type ());
+            }
+
+        template <typename Range, typename OutputIterator>
+        OutputIterator find_all ( Range &r, OutputIterator out, match_mode_type mode = match_overlapping ) const {
+            return this->find_all (boost::begin(r), boost::end(r), out, mode);
+            }
+
+        /// \fn count ( corpusIter corpus_first, corpusIter corpus_last, match_mode_type mode )
+        /// \brief Counts the occurrences of the pattern in the corpus
+        ///
+        /// \param corpus_first The start of the data to search (Random Access Iterator)
+        /// \param corpus_last  One past the end of the data to search
+        /// \param mode         Whether or not to count overlapping matches
+        ///
+        template <typename corpusIter>
+        std::size_t count ( corpusIter corpus_first, corpusIter corpus_last, match_mode_type mode = match_overlapping ) const {
+            return detail::count_matches ( *this, pat_first, corpus_first, corpus_last, mode,
+                        boost::integral_constant<bool, detail::use_simd_search<corpusIter>::value &&
+                            boost::is_same<Instrumentation, no_instrumentation>::value> ());
+            }
+
+        template <typename Range>
+        std::size_t count ( Range &r, match_mode_type mode = match_overlapping ) const {
+            return this->count (boost::begin(r), boost::end(r), mode);
+            }
+
+        /// \fn feed ( Iter first, Iter last, difference_type &matched )
+        /// \brief Runs the matcher over [first, last), stopping after the first match
+        /// 
+        /// \param first    The start of the data to search (Input Iterator)
+        /// \param last     One past the end of the data to search
+        /// \param matched  On entry, how many elements of the pattern were matched by
+        ///                 the data before 'first' (zero for a fresh search); on exit,
+        ///                 how many are matched by the data before the returned iterator.
+        ///
+        /// \return One past the end of the first match (in which case 'matched' is the
+        ///         pattern length), or 'last'.
+        ///
+        /// The corpus is never re-read, so the search can be carried across
+        /// buffers, or fed from a single-pass iterator. Passing the pattern
+        /// length back in as 'matched' continues with overlapping matches;
+        /// resetting it to zero continues with non-overlapping ones.
+        ///
+        template <typename Iter>
+        Iter feed ( Iter first, Iter last, difference_type &matched ) const {
+            BOOST_STATIC_ASSERT (( boost::is_same<
+                typename std::iterator_traits<patIter>::value_type, 
+                typename std::iterator_traits<Iter>::value_type>::value ));
+            BOOST_ASSERT ( matched >= 0 && matched <= k_pattern_length );
+            if ( pat_first == pat_last ) return last;       // empty pattern matches nothing here
+
+            difference_type idx = matched == k_pattern_length ? skip_ [ k_pattern_length ] : matched;
+            while ( first != last ) {
+                idx = next_state ( idx, *first );
+                ++first;
+                if ( idx == k_pattern_length ) {
+                    instr_.match ();
+                    break;
+                    }
+                }
+
+            matched = idx;
+            return first;
+            }
+
+        /// \fn search_stream ( InputIter first, InputIter last )
+        /// \brief Searches a single-pass sequence for the pattern
+        /// 
+        /// \param first    The start of the data to search (Input Iterator)
+        /// \param last     One past the end of the data to search
+        ///
+        /// \return The offset of the first match from 'first', or an empty
+        ///         optional if there is none.
+        ///
+        /// Each element is read exactly once, and nothing is buffered, so
+        /// this can search an istreambuf_iterator or a pipe as the data
+        /// arrives. The search stops as soon as the last element of the
+        /// first match has been consumed; a stream read through an
+        /// istreambuf_iterator is left positioned just after the match.
+        ///
+        template <typename InputIter>
+        boost::optional<boost::uintmax_t> search_stream ( InputIter first, InputIter last ) const {
+            BOOST_STATIC_ASSERT (( boost::is_same<
+                typename std::iterator_traits<patIter>::value_type, 
+                typename std::iterator_traits<InputIter>::value_type>::value ));
+            if ( pat_first == pat_last )        // empty pattern matches at start
+                return boost::optional<boost::uintmax_t> ( 0 );
+
+            difference_type idx = 0;
+            for ( boost::uintmax_t offset = 1; first != last; ++offset ) {
+                idx = next_state ( idx, *first );
+                ++first;
+                if ( idx == k_pattern_length ) {
+                    instr_.match ();
+                    return boost::optional<boost::uintmax_t> ( offset - k_pattern_length );
+                    }
+                }
+            return boost::optional<boost::uintmax_t> ();
+            }
+
+        /// \fn find_all_stream ( InputIter first, InputIter last, OutputIterator out, match_mode_type mode )
+        /// \brief Finds every occurrence of the pattern in a single-pass sequence
+        /// 
+        /// \param first    The start of the data to search (Input Iterator)
+        /// \param last     One past the end of the data to search
+        /// \param out      Receives the offset (as a boost::uintmax_t) of each match,
+        ///                 as soon as the last element of the match has been read
+        /// \param mode     Whether or not to report overlapping matches
+        ///
+        template <typename InputIter, typename OutputIterator>
+        OutputIterator find_all_stream ( InputIter first, InputIter last,
+                        OutputIterator out, match_mode_type mode = match_overlapping ) const {
+            BOOST_STATIC_ASSERT (( boost::is_same<
+                typename std::iterator_traits<patIter>::value_type, 
+                typename std::iterator_traits<InputIter>::value_type>::value ));
+            if ( pat_first == pat_last )        // empty pattern matches nothing here
+                return out;
+
+            difference_type idx = 0;
+            for ( boost::uintmax_t offset = 1; first != last; ++first, ++offset ) {
+                idx = next_state ( idx, *first );
+                if ( idx == k_pattern_length ) {
+                    instr_.match ();
+                    *out++ = offset - k_pattern_length;
+                    idx = mode == match_overlapping ? skip_ [ k_pattern_length ] : 0;
+                    instr_.shift ( k_pattern_length - idx );
+                    }
+                }
+            return out;
+            }
+
+    //  The length of the pattern that was passed into the constructor
+        std::size_t pattern_length () const { return k_pattern_length; }
+
+    //  The instrumentation policy object
+        const Instrumentation &instrumentation () const { return instr_; }
+        Instrumentation &instrumentation () { return instr_; }
+
     private:
 /// \cond DOXYGEN_HIDE
         patIter pat_first, pat_last;
         const difference_type k_pattern_length;
-        std::vector <difference_type> skip_;
+        std::vector <difference_type, difference_allocator> skip_;
+        Instrumentation instr_;
+
+    //  Compare a pattern element with a corpus element, and tell the instrumentation
+        template <typename T, typename U>
+        bool compare ( const T &lhs, const U &rhs ) const {
+            instr_.compare ();
+            return lhs == rhs;
+            }
+
+    //  The number of elements of the pattern that are matched after reading 'c',
+    //  when 'idx' were matched before it (idx < k_pattern_length)
+        template <typename T>
+        difference_type next_state ( difference_type idx, const T &c ) const {
+            while ( idx >= 0 && !this->compare ( pat_first [ idx ], c )) {
+                instr_.shift ( idx - skip_ [ idx ] );
+                idx = skip_ [ idx ];
+                }
+            return idx + 1;
+            }
 
         /// \fn operator ( corpusIter corpus_first, corpusIter corpus_last, Pred p )
         /// \brief Searches the corpus for the pattern that was passed into the constructor
@@ -104,11 +306,11 @@ namespace boost { namespace algorithm {
         ///
         template <typename corpusIter>
         corpusIter do_search ( corpusIter corpus_first, corpusIter corpus_last, 
-                                                difference_type k_corpus_length ) const {
+                                                difference_type k_corpus_length, boost::false_type ) const {
             difference_type match_start = 0;  // position in the corpus that we're matching
             
 #ifdef NEW_KMP
-            int patternIdx = 0;
+            difference_type patternIdx = 0;
             while ( match_start < k_corpus_length ) {
                 while ( patternIdx > -1 && pat_first[patternIdx] != corpus_first [match_start] )
                     patternIdx = skip_ [patternIdx]; //<--- Shifting the pattern on mismatch
@@ -116,7 +318,7 @@ namespace boost { namespace algorithm {
                 patternIdx++;
                 match_start++; //<--- corpus is always increased by 1
 
-                if ( patternIdx >= (int) k_pattern_length )
+                if ( patternIdx >= k_pattern_length )
                     return corpus_first + match_start - patternIdx;
                 }
             
@@ -133,12 +335,15 @@ namespace boost { namespace algorithm {
             difference_type idx = 0;          // position in the pattern we're comparing
 
             while ( match_start <= last_match ) {
-                while ( pat_first [ idx ] == corpus_first [ match_start + idx ] ) {
-                    if ( ++idx == k_pattern_length )
+                while ( this->compare ( pat_first [ idx ], corpus_first [ match_start + idx ] )) {
+                    if ( ++idx == k_pattern_length ) {
+                        instr_.match ();
                         return corpus_first + match_start;
+                        }
                     }
             //  Figure out where to start searching again
            //   assert ( idx - skip_ [ idx ] > 0 ); // we're always moving forward
+                instr_.shift ( idx - skip_ [ idx ] );
                 match_start += idx - skip_ [ idx ];
                 idx = skip_ [ idx ] >= 0 ? skip_ [ idx ] : 0;
            //   assert ( idx >= 0 && idx < k_pattern_length );
@@ -148,12 +353,57 @@ namespace boost { namespace algorithm {
         //  We didn't find anything
             return corpus_last;
             }
+
+        template <typename corpusIter, typename OutputIterator>
+        OutputIterator do_find_all ( corpusIter corpus_first, OutputIterator out,
+                    difference_type k_corpus_length, match_mode_type mode, boost::false_type ) const {
+        //  The same loop as do_search, but after each match we carry on from the
+        //  longest border of the pattern (or from scratch, if not overlapping)
+            const difference_type last_match = k_corpus_length - k_pattern_length;
+            difference_type match_start = 0;
+            difference_type idx = 0;
+
+            while ( match_start <= last_match ) {
+                while ( this->compare ( pat_first [ idx ], corpus_first [ match_start + idx ] )) {
+                    if ( ++idx == k_pattern_length ) {
+                        instr_.match ();
+                        *out++ = corpus_first + match_start;
+                        break;
+                        }
+                    }
+
+                if ( idx == k_pattern_length && mode == match_non_overlapping ) {
+                    instr_.shift ( k_pattern_length );
+                    match_start += k_pattern_length;
+                    idx = 0;
+                    }
+                else {
+                    instr_.shift ( idx - skip_ [ idx ] );
+                    match_start += idx - skip_ [ idx ];
+                    idx = skip_ [ idx ] >= 0 ? skip_ [ idx ] : 0;
+                    }
+                }
+
+            return out;
+            }
+
+        template <typename corpusIter>
+        corpusIter do_search ( corpusIter corpus_first, corpusIter corpus_last,
+                                                difference_type, detail::segmented_iterator_tag ) const {
+            return detail::segmented_search ( *this, corpus_first, corpus_last );
+            }
+
+        template <typename corpusIter, typename OutputIterator>
+        OutputIterator do_find_all ( corpusIter corpus_first, OutputIterator out,
+                    difference_type k_corpus_length, match_mode_type mode, detail::segmented_iterator_tag ) const {
+            return detail::segmented_find_all ( *this, corpus_first, corpus_first + k_corpus_length, out, mode );
+            }
     
 
         void preKmp ( patIter first, patIter last ) {
-           const /*std::size_t*/ int count = std::distance ( first, last );
+           const difference_type count = std::distance ( first, last );
         
-           int i, j;
+           difference_type i, j;
         
            i = 0;
            j = skip_[0] = -1;
@@ -173,9 +423,9 @@ namespace boost { namespace algorithm {
         void init_skip_table ( patIter first, patIter last ) {
             const difference_type count = std::distance ( first, last );
     
-            int j;
+            difference_type j;
             skip_ [ 0 ] = -1;
-            for ( int i = 1; i <= count; ++i ) {
+            for ( difference_type i = 1; i <= count; ++i ) {
                 j = skip_ [ i - 1 ];
                 while ( j >= 0 ) {
                     if ( first [ j ] == first [ i - 1 ] )
@@ -206,8 +456,8 @@ namespace boost { namespace algorithm {
                   corpusIter corpus_first, corpusIter corpus_last, 
                   patIter pat_first, patIter pat_last )
     {
-        knuth_morris_pratt<patIter> kmp ( pat_first, pat_last );
-        return kmp ( corpus_first, corpus_last );
+        return detail::one_shot_search<knuth_morris_pratt<patIter> > ( corpus_first, corpus_last,
+                    pat_first, pat_last, typename detail::simd_search_kind<corpusIter>::type ());
     }
 
     template <typename PatternRange, typename corpusIter>
@@ -215,8 +465,8 @@ namespace boost { namespace algorithm {
         corpusIter corpus_first, corpusIter corpus_last, const PatternRange &pattern )
     {
         typedef typename boost::range_iterator<const PatternRange>::type pattern_iterator;
-        knuth_morris_pratt<pattern_iterator> kmp ( boost::begin(pattern), boost::end (pattern));
-        return kmp ( corpus_first, corpus_last );
+        return detail::one_shot_search<knuth_morris_pratt<pattern_iterator> > ( corpus_first, corpus_last,
+                    boost::begin(pattern), boost::end (pattern), typename detail::simd_search_kind<corpusIter>::type ());
     }
     
     template <typename patIter, typename CorpusRange>
@@ -225,17 +475,57 @@ namespace boost { namespace algorithm {
     ::type
     knuth_morris_pratt_search ( CorpusRange &corpus, patIter pat_first, patIter pat_last )
     {
-        knuth_morris_pratt<patIter> kmp ( pat_first, pat_last );
-        return kmp (boost::begin (corpus), boost::end (corpus));
+        typedef typename boost::range_iterator<CorpusRange>::type corpus_iterator;
+        return detail::one_shot_search<knuth_morris_pratt<patIter> > ( boost::begin (corpus), boost::end (corpus),
+                    pat_first, pat_last, typename detail::simd_search_kind<corpus_iterator>::type ());
     }
     
     template <typename PatternRange, typename CorpusRange>
     typename boost::range_iterator<CorpusRange>::type
     knuth_morris_pratt_search ( CorpusRange &corpus, const PatternRange &pattern )
+    {
+        typedef typename boost::range_iterator<const PatternRange>::type pattern_iterator;
+        typedef typename boost::range_iterator<CorpusRange>::type corpus_iterator;
+        return detail::one_shot_search<knuth_morris_pratt<pattern_iterator> > ( boost::begin (corpus), boost::end (corpus),
+                    boost::begin(pattern), boost::end (pattern), typename detail::simd_search_kind<corpus_iterator>::type ());
+    }
+
+
+/// \fn knuth_morris_pratt_search_stream ( InputIter corpus_first, InputIter corpus_last, 
+///       patIter pat_first, patIter pat_last )
+/// \brief Searches a single-pass sequence for the pattern.
+/// 
+/// \param corpus_first The start of the data to search (Input Iterator)
+/// \param corpus_last  One past the end of the data to search
+/// \param pat_first    The start of the pattern to search for (Random Access Iterator)
+/// \param pat_last     One past the end of the data to search for
+/// \return             The offset of the first match, or an empty optional
+///
+    template <typename patIter, typename InputIter>
+    boost::optional<boost::uintmax_t> knuth_morris_pratt_search_stream ( 
+                  InputIter corpus_first, InputIter corpus_last, 
+                  patIter pat_first, patIter pat_last )
+    {
+        knuth_morris_pratt<patIter> kmp ( pat_first, pat_last );
+        return kmp.search_stream ( corpus_first, corpus_last );
+    }
+
+    template <typename PatternRange, typename InputIter>
+    boost::optional<boost::uintmax_t> knuth_morris_pratt_search_stream ( 
+        InputIter corpus_first, InputIter corpus_last, const PatternRange &pattern )
     {
         typedef typename boost::range_iterator<const PatternRange>::type pattern_iterator;
         knuth_morris_pratt<pattern_iterator> kmp ( boost::begin(pattern), boost::end (pattern));
-        return kmp (boost::begin (corpus), boost::end (corpus));
+        return kmp.search_stream ( corpus_first, corpus_last );
+    }
+
+//  Read the stream up to the end of the first match (or to the end)
+    template <typename charT, typename traits, typename PatternRange>
+    boost::optional<boost::uintmax_t> knuth_morris_pratt_search_stream ( 
+        std::basic_istream<charT, traits> &is, const PatternRange &pattern )
+    {
+        typedef std::istreambuf_iterator<charT, traits> stream_iterator;
+        return knuth_morris_pratt_search_stream ( stream_iterator ( is ), stream_iterator (), pattern );
     }
 
 
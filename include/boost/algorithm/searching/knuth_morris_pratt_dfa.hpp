@@ -0,0 +1,375 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+#ifndef BOOST_ALGORITHM_KNUTH_MORRIS_PRATT_DFA_SEARCH_HPP
+#define BOOST_ALGORITHM_KNUTH_MORRIS_PRATT_DFA_SEARCH_HPP
+
+#include <vector>
+#include <memory>       // for std::allocator
+#include <iterator>     // for std::iterator_traits
+#include <algorithm>    // for std::copy, std::min
+#include <stdexcept>    // for std::length_error
+
+#include <boost/assert.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/throw_exception.hpp>
+#include <boost/array.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/core/allocator_access.hpp>
+
+#include <boost/range/begin.hpp>
+#include <boost/range/end.hpp>
+
+#include <boost/utility/enable_if.hpp>
+#include <boost/type_traits/is_same.hpp>
+#include <boost/type_traits/is_integral.hpp>
+
+#include <boost/algorithm/searching/match_mode.hpp>
+
+namespace boost { namespace algorithm {
+
+/*
+    The Knuth-Morris-Pratt algorithm, compiled into a deterministic finite
+    automaton, for patterns of bytes.
+
+    knuth_morris_pratt follows the failure links on a mismatch, which takes a
+    data-dependent number of steps. Here the links are followed once, when
+    the searcher is built, to fill in a table with the next state for every
+    (state, byte) pair. The search is then one table load per byte of the
+    corpus, with no branches on mismatches, so the time per byte is the same
+    whatever the input.
+
+    The table has (pattern length + 1) rows. Its entries are one byte wide
+    for patterns of up to 255 bytes, two bytes up to 65535, and four beyond
+    that. When a row for every byte value would make the table bigger than
+    k_full_table_limit, the table is compacted: the bytes that do not occur
+    in the pattern all get the same column (they always go back to state 0),
+    and each byte is mapped to its column through a 256-entry array.
+
+    A long pattern with many distinct bytes still makes a big compact table
+    (about 100MB for 100000 bytes that use every byte value). So the table
+    never grows past k_table_limit: only the first rows that fit are built,
+    and from the deeper states the search follows the failure links, as
+    knuth_morris_pratt does, until it gets back to a state that has a row.
+    Those states are only reached after a long partial match, so on most
+    corpora nearly every byte is still a single table load.
+
+    Requirements:
+        * Random access iterators
+        * The two iterator types (patIter and corpusIter) must
+            "point to" the same underlying type, which must be a one-byte
+            integral type (char, signed char, unsigned char)
+*/
+
+    template <typename patIter, typename Alloc = std::allocator<char> >
+    class knuth_morris_pratt_dfa {
+        typedef typename std::iterator_traits<patIter>::value_type value_type;
+        typedef typename std::iterator_traits<patIter>::difference_type difference_type;
+        BOOST_STATIC_ASSERT_MSG (( sizeof ( value_type ) == 1 && boost::is_integral<value_type>::value ),
+                                    "knuth_morris_pratt_dfa needs a pattern of bytes" );
+
+        typedef typename boost::allocator_rebind<Alloc, boost::uint8_t>::type  narrow_allocator;
+        typedef typename boost::allocator_rebind<Alloc, boost::uint16_t>::type medium_allocator;
+        typedef typename boost::allocator_rebind<Alloc, boost::uint32_t>::type wide_allocator;
+    public:
+        typedef Alloc allocator_type;
+
+    //  Tables bigger than this (in bytes) are compacted
+        BOOST_STATIC_CONSTANT ( std::size_t, k_full_table_limit = 256 * 1024 );
+    //  ... and only the rows that fit in this many bytes are built
+        BOOST_STATIC_CONSTANT ( std::size_t, k_table_limit = 4 * 1024 * 1024 );
+
+        knuth_morris_pratt_dfa ( patIter first, patIter last, const allocator_type &alloc = allocator_type ())
+                : k_pattern_length ( std::distance ( first, last )),
+                  narrow_ ( narrow_allocator ( alloc )), medium_ ( medium_allocator ( alloc )), wide_ ( wide_allocator ( alloc )),
+                  pattern_ ( narrow_allocator ( alloc )), fail_ ( wide_allocator ( alloc )),
+                  width_ ( k_pattern_length <= 0xFF ? 1 : k_pattern_length <= 0xFFFF ? 2 : 4 ),
+                  columns_ ( 256 ), rows_ ( 0 ), compact_ ( false ) {
+            if ( static_cast<boost::uintmax_t> ( k_pattern_length ) >= 0xFFFFFFFFU )
+                boost::throw_exception ( std::length_error ( "boost::algorithm: pattern too long for knuth_morris_pratt_dfa" ));
+            if ( k_pattern_length == 0 )
+                return;
+
+            if ( static_cast<std::size_t> ( k_pattern_length + 1 ) * 256 * width_ > k_full_table_limit ) {
+            //  Give each byte that occurs in the pattern a column of its own
+                compact_ = true;
+                classes_.assign ( 0 );
+                columns_ = 1;
+                for ( patIter it = first; it != last; ++it ) {
+                    boost::uint16_t &c = classes_ [ static_cast<unsigned char> ( *it ) ];
+                    if ( c == 0 )
+                        c = static_cast<boost::uint16_t> ( columns_++ );
+                    }
+                }
+
+            rows_ = (std::min) ( static_cast<std::size_t> ( k_pattern_length + 1 ), k_table_limit / ( columns_ * width_ ));
+            if ( bounded ()) {
+            //  The pattern and its failure links, for the states without a row
+                pattern_.assign ( first, last );
+                fail_.assign ( k_pattern_length + 1, 0 );
+                for ( std::size_t i = 1; i < static_cast<std::size_t> ( k_pattern_length ); ++i ) {
+                    std::size_t k = fail_ [ i ];
+                    while ( k > 0 && pattern_ [ k ] != pattern_ [ i ] )
+                        k = fail_ [ k ];
+                    fail_ [ i + 1 ] = static_cast<boost::uint32_t> ( pattern_ [ k ] == pattern_ [ i ] ? k + 1 : k );
+                    }
+                }
+
+            if      ( width_ == 1 ) build ( narrow_, first );
+            else if ( width_ == 2 ) build ( medium_, first );
+            else                    build ( wide_,   first );
+            }
+
+        ~knuth_morris_pratt_dfa () {}
+
+        /// \fn operator ( corpusIter corpus_first, corpusIter corpus_last )
+        /// \brief Searches the corpus for the pattern that was passed into the constructor
+        ///
+        /// \param corpus_first The start of the data to search (Random Access Iterator)
+        /// \param corpus_last  One past the end of the data to search
+        ///
+        template <typename corpusIter>
+        corpusIter operator () ( corpusIter corpus_first, corpusIter corpus_last ) const {
+            BOOST_STATIC_ASSERT (( boost::is_same<value_type,
+                typename std::iterator_traits<corpusIter>::value_type>::value ));
+            if ( corpus_first == corpus_last ) return corpus_last;  // if nothing to search, we didn't find it!
+            if ( k_pattern_length == 0 )       return corpus_first; // empty pattern matches at start
+            if ( std::distance ( corpus_first, corpus_last ) < k_pattern_length )
+                return corpus_last;
+
+            if ( bounded ()) {
+                if ( width_ == 2 ) return do_search<true, true> ( &medium_ [ 0 ], corpus_first, corpus_last );
+                return                    do_search<true, true> ( &wide_   [ 0 ], corpus_first, corpus_last );
+                }
+            if ( compact_ ) {
+                if ( width_ == 1 ) return do_search<true, false> ( &narrow_ [ 0 ], corpus_first, corpus_last );
+                if ( width_ == 2 ) return do_search<true, false> ( &medium_ [ 0 ], corpus_first, corpus_last );
+                return                    do_search<true, false> ( &wide_   [ 0 ], corpus_first, corpus_last );
+                }
+            if ( width_ == 1 ) return do_search<false, false> ( &narrow_ [ 0 ], corpus_first, corpus_last );
+            return                    do_search<false, false> ( &medium_ [ 0 ], corpus_first, corpus_last );
+            }
+
+        template <typename Range>
+        typename boost::range_iterator<Range>::type operator () ( Range &r ) const {
+            return (*this) (boost::begin(r), boost::end(r));
+            }
+
+        /// \fn find_all ( corpusIter corpus_first, corpusIter corpus_last, OutputIterator out, match_mode_type mode )
+        /// \brief Finds every occurrence of the pattern in the corpus
+        ///
+        /// \param corpus_first The start of the data to search (Random Access Iterator)
+        /// \param corpus_last  One past the end of the data to search
+        /// \param out          An output iterator which receives the start of each match
+        /// \param mode         Whether or not to report overlapping matches
+        ///
+        template <typename corpusIter, typename OutputIterator>
+        OutputIterator find_all ( corpusIter corpus_first, corpusIter corpus_last,
+                        OutputIterator out, match_mode_type mode = match_overlapping ) const {
+            BOOST_STATIC_ASSERT (( boost::is_same<value_type,
+                typename std::iterator_traits<corpusIter>::value_type>::value ));
+            if ( corpus_first == corpus_last ) return out;  // if nothing to search, we didn't find it!
+            if ( k_pattern_length == 0 )       return out;  // empty pattern matches nothing here
+
+            if ( bounded ()) {
+                if ( width_ == 2 ) return do_find_all<true, true> ( &medium_ [ 0 ], corpus_first, corpus_last, out, mode );
+                return                    do_find_all<true, true> ( &wide_   [ 0 ], corpus_first, corpus_last, out, mode );
+                }
+            if ( compact_ ) {
+                if ( width_ == 1 ) return do_find_all<true, false> ( &narrow_ [ 0 ], corpus_first, corpus_last, out, mode );
+                if ( width_ == 2 ) return do_find_all<true, false> ( &medium_ [ 0 ], corpus_first, corpus_last, out, mode );
+                return                    do_find_all<true, false> ( &wide_   [ 0 ], corpus_first, corpus_last, out, mode );
+                }
+            if ( width_ == 1 ) return do_find_all<false, false> ( &narrow_ [ 0 ], corpus_first, corpus_last, out, mode );
+            return                    do_find_all<false, false> ( &medium_ [ 0 ], corpus_first, corpus_last, out, mode );
+            }
+
+        template <typename Range, typename OutputIterator>
+        OutputIterator find_all ( Range &r, OutputIterator out, match_mode_type mode = match_overlapping ) const {
+            return this->find_all (boost::begin(r), boost::end(r), out, mode);
+            }
+
+    //  The length of the pattern that was passed into the constructor
+        std::size_t pattern_length () const { return k_pattern_length; }
+
+    //  Whether the table has been compacted
+        bool compact () const { return compact_; }
+
+    //  Whether the table stops short of the deepest states, to stay within k_table_limit
+        bool bounded () const { return rows_ < static_cast<std::size_t> ( k_pattern_length + 1 ); }
+
+    private:
+/// \cond DOXYGEN_HIDE
+        const difference_type k_pattern_length;
+        std::vector<boost::uint8_t,  narrow_allocator> narrow_;    // used when width_ == 1
+        std::vector<boost::uint16_t, medium_allocator> medium_;    // used when width_ == 2
+        std::vector<boost::uint32_t, wide_allocator>   wide_;      // used when width_ == 4
+        std::vector<boost::uint8_t,  narrow_allocator> pattern_;   // the pattern, when bounded
+        std::vector<boost::uint32_t, wide_allocator>   fail_;      // longest proper border of each prefix, when bounded
+        int width_;
+        std::size_t columns_;
+        std::size_t rows_;
+        bool compact_;
+        boost::array<boost::uint16_t, 256> classes_;    // byte -> column, when compact_
+
+        std::size_t column ( value_type v ) const {
+            return compact_ ? classes_ [ static_cast<unsigned char> ( v ) ] : static_cast<unsigned char> ( v );
+            }
+
+    //  The usual construction: each row is a copy of the row for the longest
+    //  proper border of the pattern matched so far, except for the column of
+    //  the next element of the pattern, which moves on to the next state.
+    //  The last row (a complete match) is the row of the longest border of
+    //  the whole pattern, so the automaton carries on with overlapping matches.
+    //  When the table is bounded, it stops after rows_ rows.
+        template <typename Table>
+        void build ( Table &table, patIter first ) {
+            typedef typename Table::value_type entry_type;
+            const std::size_t k_columns = columns_;
+            const std::size_t k_length  = k_pattern_length;
+            table.assign ( rows_ * k_columns, 0 );
+            table [ column ( first [ 0 ] ) ] = 1;
+            std::size_t border = 0;
+            for ( std::size_t j = 1; j < rows_; ++j ) {
+                std::copy ( table.begin () + border * k_columns, table.begin () + ( border + 1 ) * k_columns,
+                            table.begin () + j * k_columns );
+                if ( j < k_length ) {
+                    const std::size_t c = column ( first [ j ] );
+                    table [ j * k_columns + c ] = static_cast<entry_type> ( j + 1 );
+                    border = table [ border * k_columns + c ];
+                    }
+                }
+            }
+
+    //  The next state from one that has no row in the table: follow the
+    //  failure links until the byte extends the match, or there is a row
+        template <typename Entry>
+        std::size_t deep_step ( const Entry *table, std::size_t state, unsigned char c ) const {
+            while ( state >= rows_ ) {
+                if ( state < static_cast<std::size_t> ( k_pattern_length ) && pattern_ [ state ] == c )
+                    return state + 1;
+                state = fail_ [ state ];
+                }
+            return table [ state * columns_ + classes_ [ c ] ];
+            }
+
+        template <bool Compact, bool Bounded, typename Entry, typename corpusIter>
+        corpusIter do_search ( const Entry *table, corpusIter corpus_first, corpusIter corpus_last ) const {
+            const std::size_t k_columns = Compact ? columns_ : 256;
+            const std::size_t k_length  = k_pattern_length;
+            std::size_t state = 0;
+            for ( corpusIter it = corpus_first; it != corpus_last; ++it ) {
+                const unsigned char c = static_cast<unsigned char> ( *it );
+                if ( Bounded && state >= rows_ )
+                    state = deep_step ( table, state, c );
+                else
+                    state = table [ state * k_columns + ( Compact ? classes_ [ c ] : c ) ];
+                if ( state == k_length )
+                    return it - ( k_length - 1 );
+                }
+            return corpus_last;
+            }
+
+        template <bool Compact, bool Bounded, typename Entry, typename corpusIter, typename OutputIterator>
+        OutputIterator do_find_all ( const Entry *table, corpusIter corpus_first, corpusIter corpus_last,
+                                        OutputIterator out, match_mode_type mode ) const {
+            const std::size_t k_columns = Compact ? columns_ : 256;
+            const std::size_t k_length  = k_pattern_length;
+            std::size_t state = 0;
+            for ( corpusIter it = corpus_first; it != corpus_last; ++it ) {
+                const unsigned char c = static_cast<unsigned char> ( *it );
+                if ( Bounded && state >= rows_ )
+                    state = deep_step ( table, state, c );
+                else
+                    state = table [ state * k_columns + ( Compact ? classes_ [ c ] : c ) ];
+                if ( state == k_length ) {
+                    *out++ = it - ( k_length - 1 );
+                    if ( mode == match_non_overlapping )
+                        state = 0;
+                    }
+                }
+            return out;
+            }
+/// \endcond
+        };
+
+    template <typename patIter, typename Alloc>
+    const std::size_t knuth_morris_pratt_dfa<patIter, Alloc>::k_full_table_limit;
+
+    template <typename patIter, typename Alloc>
+    const std::size_t knuth_morris_pratt_dfa<patIter, Alloc>::k_table_limit;
+
+
+/*  Two ranges as inputs gives us four possibilities; with 2,3,3,4 parameters
+    Use a bit of TMP to disambiguate the 3-argument templates */
+
+/// \fn knuth_morris_pratt_dfa_search ( corpusIter corpus_first, corpusIter corpus_last,
+///       patIter pat_first, patIter pat_last )
+/// \brief Searches the corpus for the pattern.
+///
+/// \param corpus_first The start of the data to search (Random Access Iterator)
+/// \param corpus_last  One past the end of the data to search
+/// \param pat_first    The start of the pattern to search for (Random Access Iterator)
+/// \param pat_last     One past the end of the data to search for
+///
+    template <typename patIter, typename corpusIter>
+    corpusIter knuth_morris_pratt_dfa_search (
+                  corpusIter corpus_first, corpusIter corpus_last,
+                  patIter pat_first, patIter pat_last )
+    {
+        knuth_morris_pratt_dfa<patIter> kmp ( pat_first, pat_last );
+        return kmp ( corpus_first, corpus_last );
+    }
+
+    template <typename PatternRange, typename corpusIter>
+    corpusIter knuth_morris_pratt_dfa_search (
+        corpusIter corpus_first, corpusIter corpus_last, const PatternRange &pattern )
+    {
+        typedef typename boost::range_iterator<const PatternRange>::type pattern_iterator;
+        knuth_morris_pratt_dfa<pattern_iterator> kmp ( boost::begin(pattern), boost::end (pattern));
+        return kmp ( corpus_first, corpus_last );
+    }
+
+    template <typename patIter, typename CorpusRange>
+    typename boost::lazy_disable_if_c<
+        boost::is_same<CorpusRange, patIter>::value, typename boost::range_iterator<CorpusRange> >
+    ::type
+    knuth_morris_pratt_dfa_search ( CorpusRange &corpus, patIter pat_first, patIter pat_last )
+    {
+        knuth_morris_pratt_dfa<patIter> kmp ( pat_first, pat_last );
+        return kmp (boost::begin (corpus), boost::end (corpus));
+    }
+
+    template <typename PatternRange, typename CorpusRange>
+    typename boost::range_iterator<CorpusRange>::type
+    knuth_morris_pratt_dfa_search ( CorpusRange &corpus, const PatternRange &pattern )
+    {
+        typedef typename boost::range_iterator<const PatternRange>::type pattern_iterator;
+        knuth_morris_pratt_dfa<pattern_iterator> kmp ( boost::begin(pattern), boost::end (pattern));
+        return kmp (boost::begin (corpus), boost::end (corpus));
+    }
+
+
+    //  Creator functions -- take a pattern range, return an object
+    template <typename Range>
+    boost::algorithm::knuth_morris_pratt_dfa<typename boost::range_iterator<const Range>::type>
+    make_knuth_morris_pratt_dfa ( const Range &r ) {
+        return boost::algorithm::knuth_morris_pratt_dfa
+            <typename boost::range_iterator<const Range>::type> (boost::begin(r), boost::end(r));
+        }
+
+    template <typename Range>
+    boost::algorithm::knuth_morris_pratt_dfa<typename boost::range_iterator<Range>::type>
+    make_knuth_morris_pratt_dfa ( Range &r ) {
+        return boost::algorithm::knuth_morris_pratt_dfa
+            <typename boost::range_iterator<Range>::type> (boost::begin(r), boost::end(r));
+        }
+}}
+
+#endif  //  BOOST_ALGORITHM_KNUTH_MORRIS_PRATT_DFA_SEARCH_HPP
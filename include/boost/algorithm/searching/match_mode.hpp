@@ -0,0 +1,32 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+#ifndef BOOST_ALGORITHM_SEARCH_MATCH_MODE_HPP
+#define BOOST_ALGORITHM_SEARCH_MATCH_MODE_HPP
+
+/*! \file
+    Defines how the searchers' find_all functions treat matches that overlap.
+*/
+
+namespace boost { namespace algorithm {
+
+//! Overlapping mode type
+/*!
+    In overlapping mode, every occurrence of the pattern is reported, so "aa"
+    is found three times in "aaaa". In non-overlapping mode, the search resumes
+    after the end of each match, so it is found twice.
+*/
+    enum match_mode_type {
+        match_overlapping,      //!< Report every occurrence
+        match_non_overlapping   //!< Resume the search after the end of each match
+    };
+
+}}
+
+#endif  //  BOOST_ALGORITHM_SEARCH_MATCH_MODE_HPP
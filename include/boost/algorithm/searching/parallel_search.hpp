@@ -0,0 +1,429 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+#ifndef BOOST_ALGORITHM_PARALLEL_SEARCH_HPP
+#define BOOST_ALGORITHM_PARALLEL_SEARCH_HPP
+
+#include <vector>
+#include <iterator>     // for std::iterator_traits, std::back_inserter
+#include <algorithm>    // for std::min, std::max
+
+#include <boost/config.hpp>
+#include <boost/range/begin.hpp>
+#include <boost/range/end.hpp>
+#include <boost/range/iterator.hpp>
+
+#include <boost/algorithm/searching/match_mode.hpp>
+
+#if !defined(BOOST_NO_CXX11_HDR_THREAD) && !defined(BOOST_NO_CXX11_HDR_ATOMIC) \
+ && !defined(BOOST_NO_CXX11_HDR_EXCEPTION) && !defined(BOOST_NO_CXX11_LAMBDAS)
+#define BOOST_ALGORITHM_HAS_PARALLEL_SEARCH
+#include <thread>
+#include <atomic>
+#include <exception>
+#endif
+
+namespace boost { namespace algorithm {
+
+/*
+    Searching a large corpus with several threads.
+
+    The corpus is split into chunks, each of which is extended by
+    (pattern length - 1) elements into the next one, so that every match
+    starts in exactly one chunk. The chunks are handed out to the threads in
+    order, and all of them share the one (immutable) searcher.
+
+    parallel_search stops handing out chunks once a match has been found to
+    the left of them, and returns the leftmost match. parallel_find_all
+    searches every chunk, and writes the matches in order. parallel_count
+    counts the matches in each chunk, and keeps only a few numbers for each
+    chunk, never the matches themselves.
+
+    Requirements:
+        * A searcher with a pattern_length () member: boyer_moore,
+            boyer_moore_horspool or knuth_morris_pratt (and, for
+            parallel_count, a count member)
+        * Random access iterators for the corpus
+
+    If the compiler or standard library does not support <thread> and
+    <atomic>, the searches are done on the calling thread.
+*/
+
+/// \cond DOXYGEN_HIDE
+namespace detail {
+
+//  Don't bother splitting the corpus into pieces smaller than this
+    static const std::size_t k_min_parallel_chunk = 64 * 1024;
+
+    struct parallel_plan {
+        parallel_plan ( std::size_t corpus_length, std::size_t pattern_length, unsigned threads ) {
+#if defined(BOOST_ALGORITHM_HAS_PARALLEL_SEARCH)
+            if ( threads == 0 )
+                threads = std::max ( 1U, std::thread::hardware_concurrency ());
+#else
+            threads = 1;
+#endif
+        //  Several chunks per thread, so that one slow chunk doesn't hold
+        //  everyone up, and so that a match cancels as much work as possible.
+            const std::size_t k_wanted = threads == 1 ? 1 : 8 * threads;
+            chunk_size = std::max ( std::max ( k_min_parallel_chunk, 4 * pattern_length ),
+                                    corpus_length / k_wanted + 1 );
+            chunks = corpus_length == 0 ? 0 : ( corpus_length + chunk_size - 1 ) / chunk_size;
+            this->threads = static_cast<unsigned> ( std::min<std::size_t> ( threads, chunks ));
+            }
+
+        std::size_t chunk_size;
+        std::size_t chunks;
+        unsigned threads;
+        };
+
+//  Run f(chunk) for every chunk in [0, chunks), on 'threads' threads.
+//  f returns false to stop any more chunks being started.
+    template <typename Func>
+    void run_chunks ( std::size_t chunks, unsigned threads, Func &f ) {
+#if defined(BOOST_ALGORITHM_HAS_PARALLEL_SEARCH)
+        if ( threads > 1 ) {
+            std::atomic<std::size_t> next ( 0 );
+            std::vector<std::exception_ptr> errors ( threads );
+            std::vector<std::thread> workers;
+            workers.reserve ( threads );
+            try {
+                for ( unsigned t = 0; t < threads; ++t )
+                    workers.push_back ( std::thread ( [&, t] () {
+                        try {
+                            for ( std::size_t c = next++; c < chunks; c = next++ )
+                                if ( !f ( c ))
+                                    break;
+                            }
+                        catch ( ... ) {
+                            errors [ t ] = std::current_exception ();
+                            next = chunks;
+                            }
+                        }));
+                }
+        //  A thread could not be started; stop the ones that were, and
+        //  wait for them before reporting it
+            catch ( ... ) {
+                next = chunks;
+                for ( std::size_t t = 0; t < workers.size (); ++t )
+                    workers [ t ].join ();
+                throw;
+                }
+            for ( unsigned t = 0; t < threads; ++t )
+                workers [ t ].join ();
+            for ( unsigned t = 0; t < threads; ++t )
+                if ( errors [ t ] )
+                    std::rethrow_exception ( errors [ t ] );
+            return;
+            }
+#else
+        (void) threads;
+#endif
+        for ( std::size_t c = 0; c < chunks; ++c )
+            if ( !f ( c ))
+                break;
+        }
+
+    template <typename Searcher, typename corpusIter>
+    class parallel_first {
+    public:
+        parallel_first ( const Searcher &searcher, corpusIter first, corpusIter last,
+                         const parallel_plan &plan )
+            : searcher_ ( searcher ), first_ ( first ), last_ ( last ),
+              chunk_size_ ( plan.chunk_size ), overlap_ ( searcher.pattern_length () - 1 ),
+              found_ ( plan.chunks, last ), best_ ( plan.chunks ) {}
+
+        bool operator () ( std::size_t c ) {
+        //  There's a match to the left of this chunk already
+            if ( c > best_ )
+                return false;
+            const std::size_t k_length = std::distance ( first_, last_ );
+            const std::size_t k_start = c * chunk_size_;
+            const std::size_t k_end = std::min ( k_length, k_start + chunk_size_ + overlap_ );
+            const corpusIter chunk_last = first_ + k_end;
+            const corpusIter found = searcher_ ( first_ + k_start, chunk_last );
+            if ( found != chunk_last ) {
+                found_ [ c ] = found;
+                lower_best ( c );
+                return false;
+                }
+            return true;
+            }
+
+        corpusIter result () const {
+            std::size_t best = best_;
+            return best < found_.size () ? found_ [ best ] : last_;
+            }
+
+    private:
+#if defined(BOOST_ALGORITHM_HAS_PARALLEL_SEARCH)
+        void lower_best ( std::size_t c ) {
+            std::size_t best = best_;
+            while ( c < best && !best_.compare_exchange_weak ( best, c ))
+                ;
+            }
+#else
+        void lower_best ( std::size_t c ) { if ( c < best_ ) best_ = c; }
+#endif
+
+        const Searcher &searcher_;
+        corpusIter first_, last_;
+        const std::size_t chunk_size_;
+        const std::size_t overlap_;
+        std::vector<corpusIter> found_;
+#if defined(BOOST_ALGORITHM_HAS_PARALLEL_SEARCH)
+        std::atomic<std::size_t> best_;     // the leftmost chunk with a match
+#else
+        std::size_t best_;
+#endif
+        };
+
+    template <typename Searcher, typename corpusIter>
+    class parallel_all {
+    public:
+        parallel_all ( const Searcher &searcher, corpusIter first, corpusIter last,
+                       const parallel_plan &plan )
+            : searcher_ ( searcher ), first_ ( first ), last_ ( last ),
+              chunk_size_ ( plan.chunk_size ), overlap_ ( searcher.pattern_length () - 1 ),
+              found_ ( plan.chunks ) {}
+
+        bool operator () ( std::size_t c ) {
+            const std::size_t k_length = std::distance ( first_, last_ );
+            const std::size_t k_start = c * chunk_size_;
+            const std::size_t k_end = std::min ( k_length, k_start + chunk_size_ + overlap_ );
+            searcher_.find_all ( first_ + k_start, first_ + k_end, std::back_inserter ( found_ [ c ] ));
+            return true;
+            }
+
+    //  Write the matches in order. Overlapping matches were found in each
+    //  chunk, so the non-overlapping ones are picked out here.
+        template <typename OutputIterator>
+        OutputIterator merge ( OutputIterator out, match_mode_type mode ) const {
+            const std::size_t k_step = mode == match_overlapping ? 1 : overlap_ + 1;
+            corpusIter next = first_;
+            for ( std::size_t c = 0; c < found_.size (); ++c )
+                for ( typename std::vector<corpusIter>::const_iterator it = found_ [ c ].begin ();
+                                                                it != found_ [ c ].end (); ++it )
+                    if ( *it >= next ) {
+                        *out++ = *it;
+                        next = *it + k_step;
+                        }
+            return out;
+            }
+
+    private:
+        const Searcher &searcher_;
+        corpusIter first_, last_;
+        const std::size_t chunk_size_;
+        const std::size_t overlap_;
+        std::vector<std::vector<corpusIter> > found_;
+        };
+
+//  An output iterator that keeps the number of matches written to it, and
+//  the first and last of them
+    template <typename corpusIter>
+    class match_tally {
+    public:
+        typedef std::output_iterator_tag iterator_category;
+        typedef void value_type;
+        typedef void difference_type;
+        typedef void pointer;
+        typedef void reference;
+
+        match_tally () : count ( 0 ) {}
+
+        match_tally &operator = ( corpusIter it ) {
+            if ( count++ == 0 )
+                first = it;
+            last = it;
+            return *this;
+            }
+        match_tally &operator *  ()    { return *this; }
+        match_tally &operator ++ ()    { return *this; }
+        match_tally &operator ++ ( int ) { return *this; }
+
+        std::size_t count;
+        corpusIter first, last;     // only meaningful if count != 0
+        };
+
+    template <typename Searcher, typename corpusIter>
+    class parallel_counter {
+    public:
+        parallel_counter ( const Searcher &searcher, corpusIter first, corpusIter last,
+                           const parallel_plan &plan, match_mode_type mode )
+            : searcher_ ( searcher ), first_ ( first ), last_ ( last ),
+              chunk_size_ ( plan.chunk_size ), overlap_ ( searcher.pattern_length () - 1 ),
+              mode_ ( overlap_ == 0 ? match_overlapping : mode ), tallies_ ( plan.chunks ) {}
+
+        bool operator () ( std::size_t c ) {
+            if ( mode_ == match_overlapping )
+                tallies_ [ c ].count = searcher_.count ( first_ + chunk_start ( c ), first_ + chunk_end ( c ));
+            else
+                tallies_ [ c ] = searcher_.find_all ( first_ + chunk_start ( c ), first_ + chunk_end ( c ),
+                                                      match_tally<corpusIter> (), match_non_overlapping );
+            return true;
+            }
+
+    //  Add up the counts. Without overlaps, each chunk was counted from its
+    //  start; if the last match in the previous chunk runs past the first
+    //  match in this one, count this one again from the end of that match.
+        std::size_t total () const {
+            std::size_t retVal = 0;
+            corpusIter next = first_;
+            for ( std::size_t c = 0; c < tallies_.size (); ++c ) {
+                const match_tally<corpusIter> &t = tallies_ [ c ];
+                if ( mode_ == match_overlapping || t.count == 0 )
+                    retVal += t.count;
+                else if ( t.first >= next ) {
+                    retVal += t.count;
+                    next = t.last + overlap_ + 1;
+                    }
+                else if ( next < first_ + chunk_end ( c )) {
+                    const match_tally<corpusIter> r = searcher_.find_all ( next, first_ + chunk_end ( c ),
+                                                           match_tally<corpusIter> (), match_non_overlapping );
+                    retVal += r.count;
+                    if ( r.count != 0 )
+                        next = r.last + overlap_ + 1;
+                    }
+                }
+            return retVal;
+            }
+
+    private:
+        std::size_t chunk_start ( std::size_t c ) const { return c * chunk_size_; }
+        std::size_t chunk_end   ( std::size_t c ) const {
+            return std::min<std::size_t> ( std::distance ( first_, last_ ), c * chunk_size_ + chunk_size_ + overlap_ );
+            }
+
+        const Searcher &searcher_;
+        corpusIter first_, last_;
+        const std::size_t chunk_size_;
+        const std::size_t overlap_;
+        const match_mode_type mode_;
+        std::vector<match_tally<corpusIter> > tallies_;
+        };
+
+}
+/// \endcond
+
+
+/// \fn parallel_search ( const Searcher &searcher, corpusIter corpus_first, corpusIter corpus_last, unsigned threads )
+/// \brief Searches the corpus for the searcher's pattern, using several threads
+///
+/// \param searcher     A boyer_moore, boyer_moore_horspool or knuth_morris_pratt object
+/// \param corpus_first The start of the data to search (Random Access Iterator)
+/// \param corpus_last  One past the end of the data to search
+/// \param threads      The number of threads to use; 0 means one per core
+/// \return             The start of the leftmost match, or corpus_last if there is none
+///
+template <typename Searcher, typename corpusIter>
+corpusIter parallel_search ( const Searcher &searcher,
+                             corpusIter corpus_first, corpusIter corpus_last, unsigned threads = 0 )
+{
+    const std::size_t k_corpus_length  = std::distance ( corpus_first, corpus_last );
+    const std::size_t k_pattern_length = searcher.pattern_length ();
+    if ( k_pattern_length == 0 || k_corpus_length < k_pattern_length )
+        return searcher ( corpus_first, corpus_last );
+
+    const detail::parallel_plan plan ( k_corpus_length, k_pattern_length, threads );
+    if ( plan.threads <= 1 )
+        return searcher ( corpus_first, corpus_last );
+
+    detail::parallel_first<Searcher, corpusIter> f ( searcher, corpus_first, corpus_last, plan );
+    detail::run_chunks ( plan.chunks, plan.threads, f );
+    return f.result ();
+}
+
+template <typename Searcher, typename Range>
+typename boost::range_iterator<Range>::type
+parallel_search ( const Searcher &searcher, Range &r, unsigned threads = 0 )
+{
+    return parallel_search ( searcher, boost::begin ( r ), boost::end ( r ), threads );
+}
+
+
+/// \fn parallel_find_all ( const Searcher &searcher, corpusIter corpus_first, corpusIter corpus_last, OutputIterator out, match_mode_type mode, unsigned threads )
+/// \brief Finds every occurrence of the searcher's pattern in the corpus, using several threads
+///
+/// \param searcher     A boyer_moore, boyer_moore_horspool or knuth_morris_pratt object
+/// \param corpus_first The start of the data to search (Random Access Iterator)
+/// \param corpus_last  One past the end of the data to search
+/// \param out          An output iterator which receives the start of each match, in order
+/// \param mode         Whether matches may overlap
+/// \param threads      The number of threads to use; 0 means one per core
+///
+template <typename Searcher, typename corpusIter, typename OutputIterator>
+OutputIterator parallel_find_all ( const Searcher &searcher,
+                                   corpusIter corpus_first, corpusIter corpus_last, OutputIterator out,
+                                   match_mode_type mode = match_overlapping, unsigned threads = 0 )
+{
+    const std::size_t k_corpus_length  = std::distance ( corpus_first, corpus_last );
+    const std::size_t k_pattern_length = searcher.pattern_length ();
+    if ( k_pattern_length == 0 || k_corpus_length < k_pattern_length )
+        return out;
+
+    const detail::parallel_plan plan ( k_corpus_length, k_pattern_length, threads );
+    if ( plan.threads <= 1 )
+        return searcher.find_all ( corpus_first, corpus_last, out, mode );
+
+    detail::parallel_all<Searcher, corpusIter> f ( searcher, corpus_first, corpus_last, plan );
+    detail::run_chunks ( plan.chunks, plan.threads, f );
+    return f.merge ( out, mode );
+}
+
+template <typename Searcher, typename Range, typename OutputIterator>
+OutputIterator parallel_find_all ( const Searcher &searcher, Range &r, OutputIterator out,
+                                   match_mode_type mode = match_overlapping, unsigned threads = 0 )
+{
+    return parallel_find_all ( searcher, boost::begin ( r ), boost::end ( r ), out, mode, threads );
+}
+
+
+/// \fn parallel_count ( const Searcher &searcher, corpusIter corpus_first, corpusIter corpus_last, match_mode_type mode, unsigned threads )
+/// \brief Counts the occurrences of the searcher's pattern in the corpus, using several threads
+///
+/// \param searcher     A boyer_moore, boyer_moore_horspool or knuth_morris_pratt object
+/// \param corpus_first The start of the data to search (Random Access Iterator)
+/// \param corpus_last  One past the end of the data to search
+/// \param mode         Whether or not to count overlapping matches
+/// \param threads      The number of threads to use; 0 means one per core
+///
+/// \note Unlike searcher.count, this allocates: one tally (a count and two
+///       iterators) per chunk, and the threads themselves. Only when the
+///       corpus is searched on the calling thread does it allocate nothing.
+///
+template <typename Searcher, typename corpusIter>
+std::size_t parallel_count ( const Searcher &searcher,
+                             corpusIter corpus_first, corpusIter corpus_last,
+                             match_mode_type mode = match_overlapping, unsigned threads = 0 )
+{
+    const std::size_t k_corpus_length  = std::distance ( corpus_first, corpus_last );
+    const std::size_t k_pattern_length = searcher.pattern_length ();
+    if ( k_pattern_length == 0 || k_corpus_length < k_pattern_length )
+        return 0;
+
+    const detail::parallel_plan plan ( k_corpus_length, k_pattern_length, threads );
+    if ( plan.threads <= 1 )
+        return searcher.count ( corpus_first, corpus_last, mode );
+
+    detail::parallel_counter<Searcher, corpusIter> f ( searcher, corpus_first, corpus_last, plan, mode );
+    detail::run_chunks ( plan.chunks, plan.threads, f );
+    return f.total ();
+}
+
+template <typename Searcher, typename Range>
+std::size_t parallel_count ( const Searcher &searcher, Range &r,
+                             match_mode_type mode = match_overlapping, unsigned threads = 0 )
+{
+    return parallel_count ( searcher, boost::begin ( r ), boost::end ( r ), mode, threads );
+}
+
+}}
+
+#endif  //  BOOST_ALGORITHM_PARALLEL_SEARCH_HPP
@@ -0,0 +1,279 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+#ifndef BOOST_ALGORITHM_REVERSE_SEARCH_HPP
+#define BOOST_ALGORITHM_REVERSE_SEARCH_HPP
+
+#include <iterator>     // for std::iterator_traits, std::reverse_iterator
+
+#include <boost/static_assert.hpp>
+
+#include <boost/range/begin.hpp>
+#include <boost/range/end.hpp>
+
+#include <boost/utility/enable_if.hpp>
+#include <boost/type_traits/is_same.hpp>
+
+#include <boost/algorithm/searching/boyer_moore.hpp>
+#include <boost/algorithm/searching/boyer_moore_horspool.hpp>
+
+namespace boost { namespace algorithm {
+
+/*
+    Right-to-left versions of the Boyer-Moore and Boyer-Moore-Horspool
+    searchers, which find the last (rightmost) occurrence of the pattern.
+
+    The tables are built from the reversed pattern, and the corpus is scanned
+    backwards from its end, through std::reverse_iterator; so the search does
+    exactly the work that the forward searcher does on the reversed corpus,
+    and stops at the first match it finds from the right.
+
+    The result is an iterator to the start of the last match, or corpus_last
+    if there isn't one. As with the forward searchers, an empty pattern
+    matches at the end.
+
+    Requirements:
+        * Random access iterators
+        * The two iterator types (patIter and corpusIter) must
+            "point to" the same underlying type.
+        * Additional requirements may be imposed by the skip table.
+*/
+
+/// \cond DOXYGEN_HIDE
+namespace detail {
+
+//  Turn the result of a search of the reversed corpus into an iterator to
+//  the start of the match in the corpus.
+    template <typename corpusIter>
+    corpusIter reverse_search_result ( corpusIter corpus_first, corpusIter corpus_last,
+                                       std::reverse_iterator<corpusIter> found, std::size_t pattern_length ) {
+        if ( pattern_length != 0 && found.base () == corpus_first )    // not found
+            return corpus_last;
+        return found.base () - pattern_length;
+        }
+
+    }
+/// \endcond
+
+    template <typename patIter, typename traits = detail::BM_traits<std::reverse_iterator<patIter> > >
+    class reverse_boyer_moore {
+        typedef std::reverse_iterator<patIter> reverse_pattern_iterator;
+        typedef boyer_moore<reverse_pattern_iterator, traits> searcher_type;
+    public:
+        typedef typename searcher_type::allocator_type allocator_type;
+
+        reverse_boyer_moore ( patIter first, patIter last, const allocator_type &alloc = allocator_type ())
+                : searcher_ ( reverse_pattern_iterator ( last ), reverse_pattern_iterator ( first ), alloc ) {}
+
+        ~reverse_boyer_moore () {}
+
+        /// \fn operator ( corpusIter corpus_first, corpusIter corpus_last )
+        /// \brief Searches the corpus for the last occurrence of the pattern that was passed into the constructor
+        ///
+        /// \param corpus_first The start of the data to search (Random Access Iterator)
+        /// \param corpus_last  One past the end of the data to search
+        ///
+        template <typename corpusIter>
+        corpusIter operator () ( corpusIter corpus_first, corpusIter corpus_last ) const {
+            BOOST_STATIC_ASSERT (( boost::is_same<
+                typename std::iterator_traits<patIter>::value_type,
+                typename std::iterator_traits<corpusIter>::value_type>::value ));
+            typedef std::reverse_iterator<corpusIter> reverse_corpus_iterator;
+            return detail::reverse_search_result ( corpus_first, corpus_last,
+                    searcher_ ( reverse_corpus_iterator ( corpus_last ), reverse_corpus_iterator ( corpus_first )),
+                    searcher_.pattern_length ());
+            }
+
+        template <typename Range>
+        typename boost::range_iterator<Range>::type operator () ( Range &r ) const {
+            return (*this) (boost::begin(r), boost::end(r));
+            }
+
+    //  The length of the pattern that was passed into the constructor
+        std::size_t pattern_length () const { return searcher_.pattern_length (); }
+
+    private:
+/// \cond DOXYGEN_HIDE
+        searcher_type searcher_;
+/// \endcond
+        };
+
+
+    template <typename patIter, typename traits = detail::BM_traits<std::reverse_iterator<patIter> > >
+    class reverse_boyer_moore_horspool {
+        typedef std::reverse_iterator<patIter> reverse_pattern_iterator;
+        typedef boyer_moore_horspool<reverse_pattern_iterator, traits> searcher_type;
+    public:
+        typedef typename searcher_type::allocator_type allocator_type;
+
+        reverse_boyer_moore_horspool ( patIter first, patIter last, const allocator_type &alloc = allocator_type ())
+                : searcher_ ( reverse_pattern_iterator ( last ), reverse_pattern_iterator ( first ), alloc ) {}
+
+        ~reverse_boyer_moore_horspool () {}
+
+        /// \fn operator ( corpusIter corpus_first, corpusIter corpus_last )
+        /// \brief Searches the corpus for the last occurrence of the pattern that was passed into the constructor
+        ///
+        /// \param corpus_first The start of the data to search (Random Access Iterator)
+        /// \param corpus_last  One past the end of the data to search
+        ///
+        template <typename corpusIter>
+        corpusIter operator () ( corpusIter corpus_first, corpusIter corpus_last ) const {
+            BOOST_STATIC_ASSERT (( boost::is_same<
+                typename std::iterator_traits<patIter>::value_type,
+                typename std::iterator_traits<corpusIter>::value_type>::value ));
+            typedef std::reverse_iterator<corpusIter> reverse_corpus_iterator;
+            return detail::reverse_search_result ( corpus_first, corpus_last,
+                    searcher_ ( reverse_corpus_iterator ( corpus_last ), reverse_corpus_iterator ( corpus_first )),
+                    searcher_.pattern_length ());
+            }
+
+        template <typename Range>
+        typename boost::range_iterator<Range>::type operator () ( Range &r ) const {
+            return (*this) (boost::begin(r), boost::end(r));
+            }
+
+    //  The length of the pattern that was passed into the constructor
+        std::size_t pattern_length () const { return searcher_.pattern_length (); }
+
+    private:
+/// \cond DOXYGEN_HIDE
+        searcher_type searcher_;
+/// \endcond
+        };
+
+/*  Two ranges as inputs gives us four possibilities; with 2,3,3,4 parameters
+    Use a bit of TMP to disambiguate the 3-argument templates */
+
+/// \fn reverse_boyer_moore_search ( corpusIter corpus_first, corpusIter corpus_last,
+///       patIter pat_first, patIter pat_last )
+/// \brief Searches the corpus for the last occurrence of the pattern.
+///
+/// \param corpus_first The start of the data to search (Random Access Iterator)
+/// \param corpus_last  One past the end of the data to search
+/// \param pat_first    The start of the pattern to search for (Random Access Iterator)
+/// \param pat_last     One past the end of the data to search for
+///
+    template <typename patIter, typename corpusIter>
+    corpusIter reverse_boyer_moore_search (
+                  corpusIter corpus_first, corpusIter corpus_last,
+                  patIter pat_first, patIter pat_last )
+    {
+        reverse_boyer_moore<patIter> rbm ( pat_first, pat_last );
+        return rbm ( corpus_first, corpus_last );
+    }
+
+    template <typename PatternRange, typename corpusIter>
+    corpusIter reverse_boyer_moore_search (
+        corpusIter corpus_first, corpusIter corpus_last, const PatternRange &pattern )
+    {
+        typedef typename boost::range_iterator<const PatternRange>::type pattern_iterator;
+        reverse_boyer_moore<pattern_iterator> rbm ( boost::begin(pattern), boost::end (pattern));
+        return rbm ( corpus_first, corpus_last );
+    }
+
+    template <typename patIter, typename CorpusRange>
+    typename boost::lazy_disable_if_c<
+        boost::is_same<CorpusRange, patIter>::value, typename boost::range_iterator<CorpusRange> >
+    ::type
+    reverse_boyer_moore_search ( CorpusRange &corpus, patIter pat_first, patIter pat_last )
+    {
+        reverse_boyer_moore<patIter> rbm ( pat_first, pat_last );
+        return rbm (boost::begin (corpus), boost::end (corpus));
+    }
+
+    template <typename PatternRange, typename CorpusRange>
+    typename boost::range_iterator<CorpusRange>::type
+    reverse_boyer_moore_search ( CorpusRange &corpus, const PatternRange &pattern )
+    {
+        typedef typename boost::range_iterator<const PatternRange>::type pattern_iterator;
+        reverse_boyer_moore<pattern_iterator> rbm ( boost::begin(pattern), boost::end (pattern));
+        return rbm (boost::begin (corpus), boost::end (corpus));
+    }
+
+
+/// \fn reverse_boyer_moore_horspool_search ( corpusIter corpus_first, corpusIter corpus_last,
+///       patIter pat_first, patIter pat_last )
+/// \brief Searches the corpus for the last occurrence of the pattern.
+///
+/// \param corpus_first The start of the data to search (Random Access Iterator)
+/// \param corpus_last  One past the end of the data to search
+/// \param pat_first    The start of the pattern to search for (Random Access Iterator)
+/// \param pat_last     One past the end of the data to search for
+///
+    template <typename patIter, typename corpusIter>
+    corpusIter reverse_boyer_moore_horspool_search (
+                  corpusIter corpus_first, corpusIter corpus_last,
+                  patIter pat_first, patIter pat_last )
+    {
+        reverse_boyer_moore_horspool<patIter> rbmh ( pat_first, pat_last );
+        return rbmh ( corpus_first, corpus_last );
+    }
+
+    template <typename PatternRange, typename corpusIter>
+    corpusIter reverse_boyer_moore_horspool_search (
+        corpusIter corpus_first, corpusIter corpus_last, const PatternRange &pattern )
+    {
+        typedef typename boost::range_iterator<const PatternRange>::type pattern_iterator;
+        reverse_boyer_moore_horspool<pattern_iterator> rbmh ( boost::begin(pattern), boost::end (pattern));
+        return rbmh ( corpus_first, corpus_last );
+    }
+
+    template <typename patIter, typename CorpusRange>
+    typename boost::lazy_disable_if_c<
+        boost::is_same<CorpusRange, patIter>::value, typename boost::range_iterator<CorpusRange> >
+    ::type
+    reverse_boyer_moore_horspool_search ( CorpusRange &corpus, patIter pat_first, patIter pat_last )
+    {
+        reverse_boyer_moore_horspool<patIter> rbmh ( pat_first, pat_last );
+        return rbmh (boost::begin (corpus), boost::end (corpus));
+    }
+
+    template <typename PatternRange, typename CorpusRange>
+    typename boost::range_iterator<CorpusRange>::type
+    reverse_boyer_moore_horspool_search ( CorpusRange &corpus, const PatternRange &pattern )
+    {
+        typedef typename boost::range_iterator<const PatternRange>::type pattern_iterator;
+        reverse_boyer_moore_horspool<pattern_iterator> rbmh ( boost::begin(pattern), boost::end (pattern));
+        return rbmh (boost::begin (corpus), boost::end (corpus));
+    }
+
+
+    //  Creator functions -- take a pattern range, return an object
+    template <typename Range>
+    boost::algorithm::reverse_boyer_moore<typename boost::range_iterator<const Range>::type>
+    make_reverse_boyer_moore ( const Range &r ) {
+        return boost::algorithm::reverse_boyer_moore
+            <typename boost::range_iterator<const Range>::type> (boost::begin(r), boost::end(r));
+        }
+
+    template <typename Range>
+    boost::algorithm::reverse_boyer_moore<typename boost::range_iterator<Range>::type>
+    make_reverse_boyer_moore ( Range &r ) {
+        return boost::algorithm::reverse_boyer_moore
+            <typename boost::range_iterator<Range>::type> (boost::begin(r), boost::end(r));
+        }
+
+    template <typename Range>
+    boost::algorithm::reverse_boyer_moore_horspool<typename boost::range_iterator<const Range>::type>
+    make_reverse_boyer_moore_horspool ( const Range &r ) {
+        return boost::algorithm::reverse_boyer_moore_horspool
+            <typename boost::range_iterator<const Range>::type> (boost::begin(r), boost::end(r));
+        }
+
+    template <typename Range>
+    boost::algorithm::reverse_boyer_moore_horspool<typename boost::range_iterator<Range>::type>
+    make_reverse_boyer_moore_horspool ( Range &r ) {
+        return boost::algorithm::reverse_boyer_moore_horspool
+            <typename boost::range_iterator<Range>::type> (boost::begin(r), boost::end(r));
+        }
+
+}}
+
+#endif  //  BOOST_ALGORITHM_REVERSE_SEARCH_HPP
@@ -0,0 +1,359 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+#ifndef BOOST_ALGORITHM_SEARCH_FILE_HPP
+#define BOOST_ALGORITHM_SEARCH_FILE_HPP
+
+#include <string>
+#include <vector>
+#include <exception>
+#include <iterator>     // for std::output_iterator_tag
+#include <cerrno>
+
+#include <boost/config.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/optional.hpp>
+#include <boost/throw_exception.hpp>
+#include <boost/exception/exception.hpp>
+#include <boost/exception/info.hpp>
+#include <boost/exception/errinfo_errno.hpp>
+#include <boost/exception/errinfo_file_name.hpp>
+
+#include <boost/algorithm/searching/boyer_moore.hpp>
+#include <boost/algorithm/searching/boyer_moore_horspool.hpp>
+#include <boost/algorithm/searching/knuth_morris_pratt.hpp>
+#include <boost/algorithm/searching/stream_searcher.hpp>
+#include <boost/algorithm/searching/match_mode.hpp>
+#include <boost/algorithm/searching/detail/offset_iterator.hpp>
+
+#if defined(BOOST_HAS_UNISTD_H)
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#else
+#include <cstdio>
+#endif
+
+namespace boost { namespace algorithm {
+
+/*
+    Searching the contents of a file.
+
+    Regular files are mapped read-only into memory, and the searcher is run
+    directly over the mapping; nothing is copied. Anything that cannot be
+    mapped (pipes, character devices, files in /proc) is read 64 KiB at a
+    time with pread/read, and the blocks are searched with a stream_searcher
+    as they arrive, so the memory used does not grow with the file.
+
+    The searchers are passed in already constructed, so the same one can be
+    used for many files. The pattern they were built from must have 'char'
+    elements.
+
+    Matches are reported as offsets from the start of the file.
+*/
+
+/*!
+    \struct search_file_error
+    \brief  Thrown when a file cannot be opened, mapped or read.
+                Contains the name of the file and the value of errno
+*/
+struct search_file_error : virtual boost::exception, virtual std::exception {};
+
+/// \cond DOXYGEN_HIDE
+namespace detail {
+
+//  The contents of a file. Regular files are mapped read-only, and can be
+//  used as one range; unless they are going to be read from front to back
+//  ('sequential'), no read-ahead is asked for. Anything that cannot be
+//  mapped stays open, and is read a block at a time with 'read', or all at
+//  once with 'load'.
+    class file_view : private boost::noncopyable {
+    public:
+        explicit file_view ( const char *path, bool sequential = true )
+                : path_ ( path ), data_ ( NULL ), size_ ( 0 ), mapped_ ( false ), offset_ ( 0 ) {
+#if defined(BOOST_HAS_UNISTD_H)
+            do { fd_ = ::open ( path, O_RDONLY ); } while ( fd_ < 0 && errno == EINTR );
+            if ( fd_ < 0 )
+                fail ();
+
+            struct stat st;
+            if ( ::fstat ( fd_, &st ) != 0 )
+                close_and_fail ();
+            seekable_ = S_ISREG ( st.st_mode ) || S_ISBLK ( st.st_mode );
+
+        //  Only regular files with something in them can be mapped; /proc
+        //  files claim to be empty, and are read like pipes.
+            if ( S_ISREG ( st.st_mode ) && st.st_size > 0 ) {
+                if ( static_cast<boost::uintmax_t> ( st.st_size ) > static_cast<std::size_t> ( -1 )) {
+                    errno = EFBIG;
+                    close_and_fail ();
+                    }
+                void *p = ::mmap ( NULL, static_cast<std::size_t> ( st.st_size ), PROT_READ, MAP_PRIVATE, fd_, 0 );
+                if ( p != MAP_FAILED ) {
+#if defined(MADV_SEQUENTIAL)
+                    if ( sequential )
+                        ::madvise ( p, static_cast<std::size_t> ( st.st_size ), MADV_SEQUENTIAL );
+#endif
+                    ::close ( fd_ );
+                    fd_     = -1;
+                    data_   = static_cast<const char *> ( p );
+                    size_   = static_cast<std::size_t> ( st.st_size );
+                    mapped_ = true;
+                    }
+                }
+#else
+            (void) sequential;
+            fp_ = std::fopen ( path, "rb" );
+            if ( fp_ == NULL )
+                fail ();
+#endif
+            }
+
+        ~file_view () {
+#if defined(BOOST_HAS_UNISTD_H)
+            if ( mapped_ )
+                ::munmap ( const_cast<char *> ( data_ ), size_ );
+            if ( fd_ >= 0 )
+                ::close ( fd_ );
+#else
+            std::fclose ( fp_ );
+#endif
+            }
+
+    //  The contents of a mapped (or loaded) file
+        const char *begin () const { return data_; }
+        const char *end   () const { return data_ + size_; }
+        std::size_t size  () const { return size_; }
+        bool mapped       () const { return mapped_; }
+
+    //  Read the next part of a file that is not mapped into 'buffer';
+    //  returns the number of bytes read, which is zero at the end
+        std::size_t read ( char *buffer, std::size_t buffer_size ) {
+#if defined(BOOST_HAS_UNISTD_H)
+            for (;;) {
+                const ssize_t n = seekable_
+                    ? ::pread ( fd_, buffer, buffer_size, static_cast<off_t> ( offset_ ))
+                    : ::read  ( fd_, buffer, buffer_size );
+                if ( n >= 0 ) {
+                    offset_ += n;
+                    return static_cast<std::size_t> ( n );
+                    }
+                if ( errno != EINTR )
+                    fail ();
+                }
+#else
+            const std::size_t n = std::fread ( buffer, 1, buffer_size, fp_ );
+            if ( n < buffer_size && std::ferror ( fp_ ))
+                fail ();
+            return n;
+#endif
+            }
+
+    //  Read the rest of a file that is not mapped into memory, so that
+    //  begin and end cover it
+        void load () {
+            if ( mapped_ )
+                return;
+            for (;;) {
+                const std::size_t k_old_size = buffer_.size ();
+                buffer_.resize ( k_old_size + k_block_size );
+                const std::size_t n = read ( &buffer_ [ k_old_size ], k_block_size );
+                buffer_.resize ( k_old_size + n );
+                if ( n == 0 )
+                    break;
+                }
+            size_ = buffer_.size ();
+            data_ = size_ == 0 ? NULL : &buffer_ [ 0 ];
+            }
+
+        static const std::size_t k_block_size = 64 * 1024;
+
+    private:
+        void fail () const {
+            boost::throw_exception ( search_file_error ()
+                << boost::errinfo_errno ( errno )
+                << boost::errinfo_file_name ( path_ ));
+            }
+
+#if defined(BOOST_HAS_UNISTD_H)
+        void close_and_fail () {
+            const int saved = errno;
+            ::close ( fd_ );
+            fd_ = -1;
+            errno = saved;
+            fail ();
+            }
+
+        int fd_;
+        bool seekable_;
+#else
+        std::FILE *fp_;
+#endif
+        std::string path_;
+        const char *data_;
+        std::size_t size_;
+        bool mapped_;
+        boost::uintmax_t offset_;
+        std::vector<char> buffer_;
+        };
+
+//  The searcher types that search_file accepts, and their pattern iterators
+    template <typename Searcher> struct file_searcher_traits;
+
+    template <typename patIter, typename traits, typename Instrumentation>
+    struct file_searcher_traits<boyer_moore<patIter, traits, Instrumentation> > {
+        typedef patIter pattern_iterator;
+        };
+
+    template <typename patIter, typename traits, typename Instrumentation>
+    struct file_searcher_traits<boyer_moore_horspool<patIter, traits, Instrumentation> > {
+        typedef patIter pattern_iterator;
+        };
+
+    template <typename patIter, typename Alloc, typename Instrumentation>
+    struct file_searcher_traits<knuth_morris_pratt<patIter, Alloc, Instrumentation> > {
+        typedef patIter pattern_iterator;
+        };
+
+//  An output iterator that remembers the first offset written to it
+    class first_offset_iterator {
+    public:
+        typedef std::output_iterator_tag iterator_category;
+        typedef void value_type;
+        typedef void difference_type;
+        typedef void pointer;
+        typedef void reference;
+
+        explicit first_offset_iterator ( boost::optional<boost::uintmax_t> *first ) : first_ ( first ) {}
+
+        first_offset_iterator &operator = ( boost::uintmax_t offset ) {
+            if ( !*first_ )
+                *first_ = offset;
+            return *this;
+            }
+        first_offset_iterator &operator *  ()    { return *this; }
+        first_offset_iterator &operator ++ ()    { return *this; }
+        first_offset_iterator &operator ++ (int) { return *this; }
+
+    private:
+        boost::optional<boost::uintmax_t> *first_;
+        };
+
+/*
+    Search a file that could not be mapped, a block at a time, with a
+    stream_searcher built from 'searcher'. Only one block (and the end of the
+    one before it) is held in memory; matches are written to 'out' as each
+    block is searched, and the search stops early if 'done' says so.
+*/
+    template <typename Searcher, typename OutputIterator, typename Done>
+    OutputIterator stream_file ( file_view &file, const Searcher &searcher,
+                                 OutputIterator out, match_mode_type mode, Done done ) {
+        typedef typename file_searcher_traits<Searcher>::pattern_iterator pattern_iterator;
+        stream_searcher<pattern_iterator, Searcher> stream ( searcher, mode );
+        std::vector<char> block ( file_view::k_block_size );
+        for (;;) {
+            const std::size_t n = file.read ( &block [ 0 ], block.size ());
+            if ( n == 0 )
+                break;
+            const std::vector<char> &b = block;
+            out = stream ( b.begin (), b.begin () + n, out );
+            if ( done ())
+                break;
+            }
+        return out;
+        }
+
+    struct never_done {
+        bool operator () () const { return false; }
+        };
+
+    struct found_one {
+        explicit found_one ( const boost::optional<boost::uintmax_t> &found ) : found_ ( found ) {}
+        bool operator () () const { return static_cast<bool> ( found_ ); }
+        const boost::optional<boost::uintmax_t> &found_;
+        };
+
+}
+/// \endcond
+
+
+/// \fn search_file ( const char *path, const Searcher &searcher )
+/// \brief Searches the contents of a file for the searcher's pattern
+///
+/// \param path         The name of the file to search
+/// \param searcher     A boyer_moore, boyer_moore_horspool or knuth_morris_pratt object
+/// \return             The offset of the first match, or an empty optional if there is none
+///
+/// \throw search_file_error if the file cannot be opened or read
+///
+template <typename Searcher>
+boost::optional<boost::uintmax_t> search_file ( const char *path, const Searcher &searcher )
+{
+    detail::file_view file ( path );
+    if ( file.mapped ()) {
+        const char *found = searcher ( file.begin (), file.end ());
+        if ( found == file.end ())
+            return boost::optional<boost::uintmax_t> ();
+        return boost::optional<boost::uintmax_t> ( found - file.begin ());
+        }
+
+//  An empty pattern matches at the start of anything that isn't empty
+    if ( searcher.pattern_length () == 0 ) {
+        char c;
+        return file.read ( &c, 1 ) == 0 ? boost::optional<boost::uintmax_t> () : boost::optional<boost::uintmax_t> ( 0 );
+        }
+
+    boost::optional<boost::uintmax_t> retVal;
+    detail::stream_file ( file, searcher, detail::first_offset_iterator ( &retVal ),
+                          match_non_overlapping, detail::found_one ( retVal ));
+    return retVal;
+}
+
+template <typename Searcher>
+boost::optional<boost::uintmax_t> search_file ( const std::string &path, const Searcher &searcher )
+{
+    return search_file ( path.c_str (), searcher );
+}
+
+
+/// \fn find_all_in_file ( const char *path, const Searcher &searcher, OutputIterator out, match_mode_type mode )
+/// \brief Writes the offset of every occurrence of the searcher's pattern in a file
+///
+/// \param path         The name of the file to search
+/// \param searcher     A boyer_moore, boyer_moore_horspool or knuth_morris_pratt object
+/// \param out          Receives the offset (as a boost::uintmax_t) of each match
+/// \param mode         Whether matches may overlap
+///
+/// \throw search_file_error if the file cannot be opened or read
+///
+template <typename Searcher, typename OutputIterator>
+OutputIterator find_all_in_file ( const char *path, const Searcher &searcher,
+                                  OutputIterator out, match_mode_type mode = match_overlapping )
+{
+    detail::file_view file ( path );
+    if ( !file.mapped ())
+        return detail::stream_file ( file, searcher, out, mode, detail::never_done ());
+    return searcher.find_all ( file.begin (), file.end (),
+        detail::offset_output_iterator<const char *, OutputIterator> ( file.begin (), 0, out ),
+        mode ).base ();
+}
+
+template <typename Searcher, typename OutputIterator>
+OutputIterator find_all_in_file ( const std::string &path, const Searcher &searcher,
+                                  OutputIterator out, match_mode_type mode = match_overlapping )
+{
+    return find_all_in_file ( path.c_str (), searcher, out, mode );
+}
+
+}}
+
+#endif  //  BOOST_ALGORITHM_SEARCH_FILE_HPP
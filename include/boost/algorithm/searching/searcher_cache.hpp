@@ -0,0 +1,373 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+#ifndef BOOST_ALGORITHM_SEARCHER_CACHE_HPP
+#define BOOST_ALGORITHM_SEARCHER_CACHE_HPP
+
+#include <boost/config.hpp>
+
+#if !defined(BOOST_NO_CXX11_HDR_MUTEX)
+
+#include <list>
+#include <vector>
+#include <utility>      // for std::pair
+#include <iterator>     // for std::iterator_traits
+#include <algorithm>    // for std::equal
+#include <unordered_map>
+#include <mutex>
+
+#include <boost/cstdint.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/functional/hash.hpp>
+
+#include <boost/range/begin.hpp>
+#include <boost/range/end.hpp>
+#include <boost/range/iterator.hpp>
+
+#include <boost/algorithm/searching/boyer_moore.hpp>
+#include <boost/algorithm/searching/boyer_moore_horspool.hpp>
+#include <boost/algorithm/searching/knuth_morris_pratt.hpp>
+#include <boost/algorithm/searching/match_mode.hpp>
+
+namespace boost { namespace algorithm {
+
+/*
+    A bounded cache of searchers, keyed by their patterns.
+
+    The free search functions build the searcher's tables every time they
+    are called. When the same patterns come up again and again, the tables
+    can be built once and kept in a searcher_cache instead:
+
+        searcher_cache<char> cache ( 500 );
+        ...
+        cached_search ( cache, request, keyword );
+
+    Each cached searcher owns a copy of its pattern, so the pattern that was
+    passed in doesn't need to outlive the call. Once the cache is full, the
+    searcher that was used least recently is dropped.
+
+    The cache may be used by several threads at once. The lookups are done
+    under a lock, but the tables are built outside it, and get() hands out
+    shared pointers, so a searcher that is dropped from the cache stays alive
+    until the last thread using it is done.
+
+    Requirements:
+        * Forward iterators for the pattern
+        * The pattern's elements must be hashable with boost::hash
+        * Searcher must be constructible from two 'const charT *'
+*/
+
+/*!
+    \struct searcher_cache_stats
+    \brief  The number of lookups that found a searcher in the cache (hits),
+                that had to build one (misses), and the number of searchers
+                that have been dropped to make room (evictions)
+*/
+struct searcher_cache_stats {
+    searcher_cache_stats () : hits ( 0 ), misses ( 0 ), evictions ( 0 ) {}
+
+    boost::uintmax_t hits;
+    boost::uintmax_t misses;
+    boost::uintmax_t evictions;
+    };
+
+
+//  A searcher together with the pattern that it searches for
+    template <typename charT, typename Searcher = boyer_moore<const charT *> >
+    class cached_searcher : private boost::noncopyable {
+    public:
+        template <typename patIter>
+        cached_searcher ( patIter first, patIter last )
+                : pattern_ ( first, last ),
+                  searcher_ ( pattern_begin (), pattern_begin () + pattern_.size ()) {}
+
+        template <typename corpusIter>
+        corpusIter operator () ( corpusIter corpus_first, corpusIter corpus_last ) const {
+            return searcher_ ( corpus_first, corpus_last );
+            }
+
+        template <typename Range>
+        typename boost::range_iterator<Range>::type operator () ( Range &r ) const {
+            return (*this) (boost::begin(r), boost::end(r));
+            }
+
+        template <typename corpusIter, typename OutputIterator>
+        OutputIterator find_all ( corpusIter corpus_first, corpusIter corpus_last,
+                                  OutputIterator out, match_mode_type mode = match_overlapping ) const {
+            return searcher_.find_all ( corpus_first, corpus_last, out, mode );
+            }
+
+        std::size_t pattern_length () const { return pattern_.size (); }
+        const std::vector<charT> &pattern () const { return pattern_; }
+
+    private:
+        const charT *pattern_begin () const { return pattern_.empty () ? NULL : &pattern_ [ 0 ]; }
+
+        const std::vector<charT> pattern_;
+        const Searcher searcher_;           // refers to pattern_
+        };
+
+
+    template <typename charT, typename Searcher = boyer_moore<const charT *> >
+    class searcher_cache : private boost::noncopyable {
+    public:
+        typedef cached_searcher<charT, Searcher> value_type;
+        typedef boost::shared_ptr<const value_type> pointer;
+
+        explicit searcher_cache ( std::size_t capacity ) : capacity_ ( capacity == 0 ? 1 : capacity ) {}
+
+        ~searcher_cache () {}
+
+        /// \fn get ( patIter pat_first, patIter pat_last )
+        /// \brief Returns the searcher for a pattern, building it if it is not in the cache
+        ///
+        /// \param pat_first    The start of the pattern to search for
+        /// \param pat_last     One past the end of the pattern
+        ///
+        template <typename patIter>
+        pointer get ( patIter pat_first, patIter pat_last ) {
+            const std::size_t k_hash = boost::hash_range ( pat_first, pat_last );
+            {
+                std::lock_guard<std::mutex> lock ( mutex_ );
+                pointer p = find ( k_hash, pat_first, pat_last );
+                if ( p ) {
+                    ++stats_.hits;
+                    return p;
+                    }
+                ++stats_.misses;
+            }
+
+        //  Build the tables without holding the lock
+            pointer p = boost::make_shared<const value_type> ( pat_first, pat_last );
+
+            std::lock_guard<std::mutex> lock ( mutex_ );
+        //  Someone else may have built it in the meantime
+            pointer q = find ( k_hash, pat_first, pat_last );
+            if ( q )
+                return q;
+            lru_.push_front ( std::make_pair ( k_hash, p ));
+            index_.insert ( std::make_pair ( k_hash, lru_.begin ()));
+            while ( lru_.size () > capacity_ )
+                evict ();
+            return p;
+            }
+
+        template <typename PatternRange>
+        pointer get ( const PatternRange &pattern ) {
+            return get ( boost::begin ( pattern ), boost::end ( pattern ));
+            }
+
+        searcher_cache_stats stats () const {
+            std::lock_guard<std::mutex> lock ( mutex_ );
+            return stats_;
+            }
+
+        std::size_t size () const {
+            std::lock_guard<std::mutex> lock ( mutex_ );
+            return lru_.size ();
+            }
+
+        std::size_t capacity () const { return capacity_; }
+
+    //  Drop all the searchers; the statistics are kept
+        void clear () {
+            std::lock_guard<std::mutex> lock ( mutex_ );
+            index_.clear ();
+            lru_.clear ();
+            }
+
+    private:
+/// \cond DOXYGEN_HIDE
+        typedef std::list<std::pair<std::size_t, pointer> > lru_list;      // most recently used first
+        typedef std::unordered_multimap<std::size_t, typename lru_list::iterator> index_type;
+
+    //  Called with the lock held. Hashes can collide, so the patterns are compared, too.
+        template <typename patIter>
+        pointer find ( std::size_t hash, patIter pat_first, patIter pat_last ) {
+            const std::size_t k_length = std::distance ( pat_first, pat_last );
+            std::pair<typename index_type::iterator, typename index_type::iterator> r = index_.equal_range ( hash );
+            for ( ; r.first != r.second; ++r.first ) {
+                const typename lru_list::iterator it = r.first->second;
+                const std::vector<charT> &pattern = it->second->pattern ();
+                if ( pattern.size () == k_length && std::equal ( pattern.begin (), pattern.end (), pat_first )) {
+                    lru_.splice ( lru_.begin (), lru_, it );
+                    return it->second;
+                    }
+                }
+            return pointer ();
+            }
+
+    //  Called with the lock held
+        void evict () {
+            const typename lru_list::iterator victim = --lru_.end ();
+            std::pair<typename index_type::iterator, typename index_type::iterator> r = index_.equal_range ( victim->first );
+            for ( ; r.first != r.second; ++r.first )
+                if ( r.first->second == victim ) {
+                    index_.erase ( r.first );
+                    break;
+                    }
+            lru_.erase ( victim );
+            ++stats_.evictions;
+            }
+
+        const std::size_t capacity_;
+        mutable std::mutex mutex_;
+        lru_list lru_;
+        index_type index_;
+        searcher_cache_stats stats_;
+/// \endcond
+        };
+
+
+/// \fn cached_search ( searcher_cache<charT, Searcher> &cache, corpusIter corpus_first, corpusIter corpus_last, patIter pat_first, patIter pat_last )
+/// \brief Searches the corpus for the pattern, using (and filling) a cache of searchers
+///
+/// \param cache        The cache to look the pattern up in
+/// \param corpus_first The start of the data to search (Random Access Iterator)
+/// \param corpus_last  One past the end of the data to search
+/// \param pat_first    The start of the pattern to search for
+/// \param pat_last     One past the end of the pattern
+///
+    template <typename charT, typename Searcher, typename corpusIter, typename patIter>
+    corpusIter cached_search ( searcher_cache<charT, Searcher> &cache,
+                  corpusIter corpus_first, corpusIter corpus_last,
+                  patIter pat_first, patIter pat_last )
+    {
+        return (*cache.get ( pat_first, pat_last )) ( corpus_first, corpus_last );
+    }
+
+    template <typename charT, typename Searcher, typename CorpusRange, typename PatternRange>
+    typename boost::range_iterator<CorpusRange>::type
+    cached_search ( searcher_cache<charT, Searcher> &cache, CorpusRange &corpus, const PatternRange &pattern )
+    {
+        return (*cache.get ( pattern )) ( boost::begin ( corpus ), boost::end ( corpus ));
+    }
+
+
+/// \fn cached_find_all ( searcher_cache<charT, Searcher> &cache, corpusIter corpus_first, corpusIter corpus_last, patIter pat_first, patIter pat_last, OutputIterator out, match_mode_type mode )
+/// \brief Finds every occurrence of the pattern in the corpus, using (and filling) a cache of searchers
+///
+    template <typename charT, typename Searcher, typename corpusIter, typename patIter, typename OutputIterator>
+    OutputIterator cached_find_all ( searcher_cache<charT, Searcher> &cache,
+                  corpusIter corpus_first, corpusIter corpus_last,
+                  patIter pat_first, patIter pat_last,
+                  OutputIterator out, match_mode_type mode = match_overlapping )
+    {
+        return cache.get ( pat_first, pat_last )->find_all ( corpus_first, corpus_last, out, mode );
+    }
+
+    template <typename charT, typename Searcher, typename CorpusRange, typename PatternRange, typename OutputIterator>
+    OutputIterator cached_find_all ( searcher_cache<charT, Searcher> &cache,
+                  CorpusRange &corpus, const PatternRange &pattern,
+                  OutputIterator out, match_mode_type mode = match_overlapping )
+    {
+        return cache.get ( pattern )->find_all ( boost::begin ( corpus ), boost::end ( corpus ), out, mode );
+    }
+
+
+/// \cond DOXYGEN_HIDE
+namespace detail {
+
+    static const std::size_t k_default_searcher_cache_size = 256;
+
+//  One cache for each kind of searcher, shared by the whole program
+    template <typename charT, typename Searcher>
+    searcher_cache<charT, Searcher> &default_searcher_cache () {
+        static searcher_cache<charT, Searcher> cache ( k_default_searcher_cache_size );
+        return cache;
+        }
+
+    template <typename patIter>
+    struct cache_char {
+        typedef typename std::iterator_traits<patIter>::value_type type;
+        };
+
+    template <typename PatternRange>
+    struct range_cache_char {
+        typedef typename std::iterator_traits<
+                    typename boost::range_iterator<const PatternRange>::type>::value_type type;
+        };
+}
+/// \endcond
+
+
+//  The free search functions, with the searchers kept in a cache
+//  that is shared by the whole program.
+
+    template <typename corpusIter, typename patIter>
+    corpusIter boyer_moore_search_cached (
+                  corpusIter corpus_first, corpusIter corpus_last,
+                  patIter pat_first, patIter pat_last )
+    {
+        typedef typename detail::cache_char<patIter>::type char_type;
+        return cached_search ( detail::default_searcher_cache<char_type, boyer_moore<const char_type *> > (),
+                    corpus_first, corpus_last, pat_first, pat_last );
+    }
+
+    template <typename CorpusRange, typename PatternRange>
+    typename boost::range_iterator<CorpusRange>::type
+    boyer_moore_search_cached ( CorpusRange &corpus, const PatternRange &pattern )
+    {
+        typedef typename detail::range_cache_char<PatternRange>::type char_type;
+        return cached_search ( detail::default_searcher_cache<char_type, boyer_moore<const char_type *> > (),
+                    corpus, pattern );
+    }
+
+    template <typename corpusIter, typename patIter>
+    corpusIter boyer_moore_horspool_search_cached (
+                  corpusIter corpus_first, corpusIter corpus_last,
+                  patIter pat_first, patIter pat_last )
+    {
+        typedef typename detail::cache_char<patIter>::type char_type;
+        return cached_search ( detail::default_searcher_cache<char_type, boyer_moore_horspool<const char_type *> > (),
+                    corpus_first, corpus_last, pat_first, pat_last );
+    }
+
+    template <typename CorpusRange, typename PatternRange>
+    typename boost::range_iterator<CorpusRange>::type
+    boyer_moore_horspool_search_cached ( CorpusRange &corpus, const PatternRange &pattern )
+    {
+        typedef typename detail::range_cache_char<PatternRange>::type char_type;
+        return cached_search ( detail::default_searcher_cache<char_type, boyer_moore_horspool<const char_type *> > (),
+                    corpus, pattern );
+    }
+
+    template <typename corpusIter, typename patIter>
+    corpusIter knuth_morris_pratt_search_cached (
+                  corpusIter corpus_first, corpusIter corpus_last,
+                  patIter pat_first, patIter pat_last )
+    {
+        typedef typename detail::cache_char<patIter>::type char_type;
+        return cached_search ( detail::default_searcher_cache<char_type, knuth_morris_pratt<const char_type *> > (),
+                    corpus_first, corpus_last, pat_first, pat_last );
+    }
+
+    template <typename CorpusRange, typename PatternRange>
+    typename boost::range_iterator<CorpusRange>::type
+    knuth_morris_pratt_search_cached ( CorpusRange &corpus, const PatternRange &pattern )
+    {
+        typedef typename detail::range_cache_char<PatternRange>::type char_type;
+        return cached_search ( detail::default_searcher_cache<char_type, knuth_morris_pratt<const char_type *> > (),
+                    corpus, pattern );
+    }
+
+//  The statistics for the caches used by the functions above
+    template <typename charT, typename Searcher>
+    searcher_cache_stats default_searcher_cache_stats ()
+    {
+        return detail::default_searcher_cache<charT, Searcher> ().stats ();
+    }
+
+}}
+
+#endif  //  !BOOST_NO_CXX11_HDR_MUTEX
+
+#endif  //  BOOST_ALGORITHM_SEARCHER_CACHE_HPP
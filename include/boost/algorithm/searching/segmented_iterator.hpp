@@ -0,0 +1,223 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+#ifndef BOOST_ALGORITHM_SEARCH_SEGMENTED_ITERATOR_HPP
+#define BOOST_ALGORITHM_SEARCH_SEGMENTED_ITERATOR_HPP
+
+#include <deque>
+#include <cstddef>      // for std::ptrdiff_t
+#include <iterator>     // for std::iterator_traits, std::output_iterator_tag
+#include <algorithm>    // for std::min, std::max
+
+#include <boost/type_traits/integral_constant.hpp>
+#include <boost/mpl/if.hpp>
+#include <boost/iterator/iterator_adaptor.hpp>
+
+#include <boost/algorithm/searching/match_mode.hpp>
+
+/*! \file
+    Defines segmented_iterator_traits, which tells the searchers how to get
+    at the contiguous blocks underneath an iterator, such as the one of a
+    std::deque.
+*/
+
+namespace boost { namespace algorithm {
+
+//! Segmented iterator traits
+/*!
+    A segmented iterator walks over a sequence that is stored as a series of
+    contiguous blocks. boyer_moore, boyer_moore_horspool and
+    knuth_morris_pratt search each block through plain pointers, and only
+    go through the iterator for the matches that cross from one block into
+    the next.
+
+    To make an iterator type segmented, specialize this template with:
+    \code
+        typedef boost::true_type is_segmented;
+        typedef const value_type *pointer;
+    //  Points 'p' at the contiguous block that starts at 'it', and returns
+    //  the number of elements in it. 'p' may point into 'it' itself, so it
+    //  is only used while 'it' is unchanged.
+        static difference_type segment ( iterator &it, pointer &p );
+    \endcode
+
+    Iterators of std::deque are segmented when the standard library is
+    libstdc++ (outside its debug mode);
+    'boost/algorithm/string/std/rope_traits.hpp' does the same for the
+    iterators of libstdc++'s __gnu_cxx::rope.
+*/
+    template <typename Iter>
+    struct segmented_iterator_traits {
+        typedef boost::false_type is_segmented;
+        };
+
+#if defined(__GLIBCXX__) && !defined(_GLIBCXX_DEBUG)
+    template <typename T, typename Ref, typename Ptr>
+    struct segmented_iterator_traits<std::_Deque_iterator<T, Ref, Ptr> > {
+        typedef boost::true_type is_segmented;
+        typedef const T *pointer;
+
+        static std::ptrdiff_t segment ( const std::_Deque_iterator<T, Ref, Ptr> &it, pointer &p ) {
+            p = it._M_cur;
+            return it._M_last - it._M_cur;
+            }
+        };
+#endif
+
+/// \cond DOXYGEN_HIDE
+namespace detail {
+
+    struct segmented_iterator_tag {};
+
+//  The tag a searcher dispatches on: segmented_iterator_tag for segmented
+//  iterators, and 'Otherwise' for everything else
+    template <typename Iter, typename Otherwise = boost::false_type>
+    struct segmented_dispatch : public boost::mpl::if_<
+        typename segmented_iterator_traits<Iter>::is_segmented,
+        segmented_iterator_tag, Otherwise> {};
+
+//  The same iterator, but not segmented, so that the searchers can look
+//  across the boundary between two blocks the ordinary way
+    template <typename Iter>
+    class unsegmented_iterator
+        : public boost::iterator_adaptor<unsegmented_iterator<Iter>, Iter> {
+    public:
+        unsegmented_iterator () {}
+        explicit unsegmented_iterator ( Iter it ) : unsegmented_iterator::iterator_adaptor_ ( it ) {}
+        };
+
+//  An output iterator that turns matches found in a block (written as
+//  'Origin's) back into iterators into the corpus, and remembers the last one
+    template <typename Origin, typename corpusIter, typename OutputIterator>
+    class rebase_output_iterator {
+    public:
+        typedef std::output_iterator_tag iterator_category;
+        typedef void value_type;
+        typedef void difference_type;
+        typedef void pointer;
+        typedef void reference;
+
+        rebase_output_iterator ( Origin origin, corpusIter base, OutputIterator out, corpusIter *last_match )
+            : origin_ ( origin ), base_ ( base ), out_ ( out ), last_match_ ( last_match ) {}
+
+        rebase_output_iterator &operator = ( Origin match ) {
+            *last_match_ = base_ + ( match - origin_ );
+            *out_++ = *last_match_;
+            return *this;
+            }
+        rebase_output_iterator &operator *  ()    { return *this; }
+        rebase_output_iterator &operator ++ ()    { return *this; }
+        rebase_output_iterator &operator ++ (int) { return *this; }
+
+        OutputIterator base () const { return out_; }
+
+    private:
+        Origin origin_;
+        corpusIter base_;
+        OutputIterator out_;
+        corpusIter *last_match_;
+        };
+
+/*
+    Searching a segmented corpus.
+
+    Each block is searched through its pointers. A match that starts in a
+    block and ends in a later one starts in the last (m-1) elements of the
+    block, so those, and the (m-1) elements after them, are searched through
+    the corpus iterator. Every match starts in exactly one block, and is
+    found by exactly one of the two searches. Nothing is copied.
+
+    The caller has already dealt with empty patterns, and with corpora that
+    are shorter than the pattern.
+*/
+    template <typename Searcher, typename corpusIter>
+    corpusIter segmented_search ( const Searcher &searcher, corpusIter corpus_first, corpusIter corpus_last ) {
+        typedef segmented_iterator_traits<corpusIter> traits;
+        typedef typename traits::pointer pointer;
+        typedef typename std::iterator_traits<corpusIter>::difference_type difference_type;
+        typedef unsegmented_iterator<corpusIter> window_iterator;
+        const difference_type k_overlap = searcher.pattern_length () - 1;
+
+        corpusIter curPos = corpus_first;
+        while ( curPos != corpus_last ) {
+            pointer p;
+            const difference_type n = (std::min) ( static_cast<difference_type> ( traits::segment ( curPos, p )),
+                                                   corpus_last - curPos );
+            const corpusIter block_last = curPos + n;
+
+            const pointer found = searcher ( p, p + n );
+            if ( found != p + n )
+                return curPos + ( found - p );
+
+            if ( k_overlap > 0 && block_last != corpus_last ) {
+                const corpusIter w_first = n > k_overlap ? block_last - k_overlap : curPos;
+                const corpusIter w_last  = corpus_last - block_last > k_overlap ? block_last + k_overlap : corpus_last;
+                const window_iterator w_found = searcher ( window_iterator ( w_first ), window_iterator ( w_last ));
+                if ( w_found.base () != w_last )
+                    return w_found.base ();
+                }
+            curPos = block_last;
+            }
+        return corpus_last;
+        }
+
+    template <typename Searcher, typename corpusIter, typename OutputIterator>
+    OutputIterator segmented_find_all ( const Searcher &searcher, corpusIter corpus_first, corpusIter corpus_last,
+                                        OutputIterator out, match_mode_type mode ) {
+        typedef segmented_iterator_traits<corpusIter> traits;
+        typedef typename traits::pointer pointer;
+        typedef typename std::iterator_traits<corpusIter>::difference_type difference_type;
+        typedef unsegmented_iterator<corpusIter> window_iterator;
+        const difference_type k_overlap = searcher.pattern_length () - 1;
+        const difference_type k_step = mode == match_overlapping ? 1 : k_overlap + 1;
+
+        corpusIter next = corpus_first;     // where the next match may start
+        corpusIter curPos = corpus_first;
+        while ( curPos != corpus_last ) {
+            pointer p;
+            const difference_type n = (std::min) ( static_cast<difference_type> ( traits::segment ( curPos, p )),
+                                                   corpus_last - curPos );
+            const corpusIter block_last = curPos + n;
+            corpusIter last_match = corpus_last;
+
+        //  Matches that lie in this block
+            if ( next < block_last ) {
+                const difference_type skip = next > curPos ? next - curPos : 0;
+                out = searcher.find_all ( p + skip, p + n,
+                        rebase_output_iterator<pointer, corpusIter, OutputIterator> ( p, curPos, out, &last_match ),
+                        mode ).base ();
+                if ( last_match != corpus_last )
+                    next = last_match + k_step;
+                }
+
+        //  Matches that start in this block, and end in a later one
+            if ( k_overlap > 0 && block_last != corpus_last ) {
+                const corpusIter w_first = (std::max) ( next, n > k_overlap ? block_last - k_overlap : curPos );
+                const corpusIter w_last  = corpus_last - block_last > k_overlap ? block_last + k_overlap : corpus_last;
+                if ( w_first < block_last ) {
+                    last_match = corpus_last;
+                    out = searcher.find_all ( window_iterator ( w_first ), window_iterator ( w_last ),
+                            rebase_output_iterator<window_iterator, corpusIter, OutputIterator> (
+                                window_iterator ( w_first ), w_first, out, &last_match ),
+                            mode ).base ();
+                    if ( last_match != corpus_last )
+                        next = last_match + k_step;
+                    }
+                }
+            curPos = block_last;
+            }
+        return out;
+        }
+
+}
+/// \endcond
+
+}}
+
+#endif  //  BOOST_ALGORITHM_SEARCH_SEGMENTED_ITERATOR_HPP
@@ -0,0 +1,344 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+#ifndef BOOST_ALGORITHM_STATIC_SEARCH_HPP
+#define BOOST_ALGORITHM_STATIC_SEARCH_HPP
+
+#include <boost/config.hpp>
+
+#if !defined(BOOST_NO_CXX14_CONSTEXPR) && !defined(BOOST_NO_CXX11_VARIADIC_TEMPLATES)
+
+#include <cstddef>      // for std::size_t
+#include <iterator>     // for std::iterator_traits
+
+#include <boost/static_assert.hpp>
+#include <boost/cstdint.hpp>
+
+#include <boost/range/begin.hpp>
+#include <boost/range/end.hpp>
+#include <boost/range/iterator.hpp>
+
+#include <boost/type_traits/is_same.hpp>
+#include <boost/type_traits/conditional.hpp>
+
+#include <boost/algorithm/searching/detail/simd.hpp>
+
+namespace boost { namespace algorithm {
+
+/*
+    Boyer-Moore and Boyer-Moore-Horspool searchers for patterns that are
+    known at compile time.
+
+    The pattern is given as template arguments:
+
+        static_horspool<char, 'G', 'E', 'T', ' '> get;
+        const char *p = get ( first, last );
+
+    and all the tables are computed by constexpr functions, so they live in
+    read-only data; constructing a searcher costs nothing and allocates
+    nothing. The entries of the tables are as small as the pattern length
+    allows, and the pattern length is a constant the compiler can see.
+
+    These need C++14 (relaxed constexpr) and variadic templates.
+
+    Requirements:
+        * Random access iterators for the corpus
+        * The corpus must "point to" the pattern's character type
+*/
+
+/// \cond DOXYGEN_HIDE
+namespace detail {
+
+//  The smallest unsigned type that holds [0, M+1]
+    template <std::size_t M>
+    struct static_entry {
+        typedef typename boost::conditional<( M < 0xFFU ), boost::uint8_t,
+                typename boost::conditional<( M < 0xFFFFU ), boost::uint16_t, std::size_t>::type>::type type;
+        };
+
+//  An array that can be filled in by a constexpr function
+//  (std::array's non-const operator [] isn't constexpr until C++17)
+    template <typename T, std::size_t N>
+    struct static_array {
+        T elems_ [ N ];
+        constexpr const T &operator [] ( std::size_t i ) const { return elems_ [ i ]; }
+        constexpr       T &operator [] ( std::size_t i )       { return elems_ [ i ]; }
+        };
+
+//  The value stored in the skip table for position 'i' of the pattern:
+//  for Horspool, the shift that lines that position up with the end of the
+//  window; for Boyer-Moore, the position, plus one (so that zero means 'not
+//  in the pattern').
+    template <typename Entry>
+    constexpr Entry static_skip_value ( bool horspool, std::size_t m, std::size_t i ) {
+        return static_cast<Entry> ( horspool ? m - 1 - i : i + 1 );
+        }
+
+//  Skip tables. For bytes, one entry for each value ...
+    template <typename charT, typename Entry, std::size_t M, bool isByte = sizeof(charT) == 1>
+    struct static_skip_table {
+        Entry table_ [ 256 ];
+
+        constexpr Entry operator [] ( charT c ) const {
+            return table_ [ static_cast<unsigned char> ( c ) ];
+            }
+
+        template <bool Horspool, charT... Chars>
+        static constexpr static_skip_table build () {
+            const charT pat [] = { Chars... };
+            static_skip_table t {};
+            for ( std::size_t i = 0; i < 256; ++i )
+                t.table_ [ i ] = static_cast<Entry> ( Horspool ? M : 0 );
+            for ( std::size_t i = 0; i < ( Horspool ? M - 1 : M ); ++i )
+                t.table_ [ static_cast<unsigned char> ( pat [ i ] ) ] = static_skip_value<Entry> ( Horspool, M, i );
+            return t;
+            }
+        };
+
+//  ... and for wider characters, the distinct characters of the pattern,
+//  sorted, with a binary search.
+    template <typename charT, typename Entry, std::size_t M>
+    struct static_skip_table<charT, Entry, M, false> {
+        charT keys_ [ M ];
+        Entry values_ [ M ];
+        std::size_t size_;
+        Entry default_;
+
+        constexpr Entry operator [] ( charT c ) const {
+            std::size_t lo = 0, hi = size_;
+            while ( lo < hi ) {
+                const std::size_t mid = lo + ( hi - lo ) / 2;
+                if ( keys_ [ mid ] < c )
+                    lo = mid + 1;
+                else
+                    hi = mid;
+                }
+            return lo < size_ && keys_ [ lo ] == c ? values_ [ lo ] : default_;
+            }
+
+        template <bool Horspool, charT... Chars>
+        static constexpr static_skip_table build () {
+            const charT pat [] = { Chars... };
+            static_skip_table t {};
+            t.default_ = static_cast<Entry> ( Horspool ? M : 0 );
+            for ( std::size_t i = 0; i < ( Horspool ? M - 1 : M ); ++i ) {
+                std::size_t j = 0;
+                while ( j < t.size_ && t.keys_ [ j ] < pat [ i ] )
+                    ++j;
+                if ( j == t.size_ || !( t.keys_ [ j ] == pat [ i ] )) {
+                    for ( std::size_t k = t.size_; k > j; --k ) {
+                        t.keys_   [ k ] = t.keys_   [ k - 1 ];
+                        t.values_ [ k ] = t.values_ [ k - 1 ];
+                        }
+                    t.keys_ [ j ] = pat [ i ];
+                    ++t.size_;
+                    }
+                t.values_ [ j ] = static_skip_value<Entry> ( Horspool, M, i );
+                }
+            return t;
+            }
+        };
+
+//  The length of the longest proper prefix of p[0..i] that is also a suffix of it
+    template <typename charT>
+    constexpr void static_bm_prefix ( const charT *p, std::size_t count, std::size_t *prefix ) {
+        prefix [ 0 ] = 0;
+        std::size_t k = 0;
+        for ( std::size_t i = 1; i < count; ++i ) {
+            while ( k > 0 && !( p [ k ] == p [ i ] ))
+                k = prefix [ k - 1 ];
+            if ( p [ k ] == p [ i ] )
+                k++;
+            prefix [ i ] = k;
+            }
+        }
+
+//  The good suffix table; the same computation as boyer_moore::build_suffix_table
+    template <typename Entry, typename charT, charT... Chars>
+    constexpr static_array<Entry, sizeof... ( Chars ) + 1> static_bm_suffix_table () {
+        const std::size_t count = sizeof... ( Chars );
+        const charT pat [] = { Chars... };
+        charT reversed [ count ] = {};
+        for ( std::size_t i = 0; i < count; ++i )
+            reversed [ i ] = pat [ count - 1 - i ];
+
+        std::size_t prefix [ count ] = {};
+        std::size_t prefix_reversed [ count ] = {};
+        static_bm_prefix ( pat, count, prefix );
+        static_bm_prefix ( reversed, count, prefix_reversed );
+
+        static_array<Entry, count + 1> suffix {};
+        for ( std::size_t i = 0; i <= count; ++i )
+            suffix [ i ] = static_cast<Entry> ( count - prefix [ count - 1 ] );
+        for ( std::size_t i = 0; i < count; ++i ) {
+            const std::size_t j = count - prefix_reversed [ i ];
+            const std::size_t k = i - prefix_reversed [ i ] + 1;
+            if ( suffix [ j ] > k )
+                suffix [ j ] = static_cast<Entry> ( k );
+            }
+        return suffix;
+        }
+
+}
+/// \endcond
+
+
+    template <typename charT, charT... Chars>
+    class static_horspool {
+        BOOST_STATIC_ASSERT_MSG ( sizeof... ( Chars ) > 0, "The pattern must not be empty" );
+        static constexpr std::size_t M = sizeof... ( Chars );
+        typedef typename detail::static_entry<M>::type entry_type;
+        typedef detail::static_skip_table<charT, entry_type, M> skip_table_type;
+    public:
+        constexpr static_horspool () {}
+
+        /// \fn operator ( corpusIter corpus_first, corpusIter corpus_last )
+        /// \brief Searches the corpus for the pattern
+        ///
+        /// \param corpus_first The start of the data to search (Random Access Iterator)
+        /// \param corpus_last  One past the end of the data to search
+        ///
+        template <typename corpusIter>
+        corpusIter operator () ( corpusIter corpus_first, corpusIter corpus_last ) const {
+            BOOST_STATIC_ASSERT (( boost::is_same<charT,
+                typename std::iterator_traits<corpusIter>::value_type>::value ));
+
+            if ( corpus_first == corpus_last ) return corpus_last;  // if nothing to search, we didn't find it!
+            if ( std::distance ( corpus_first, corpus_last ) < static_cast<std::ptrdiff_t> ( M ))
+                return corpus_last;
+            return do_search ( corpus_first, corpus_last, detail::use_simd_search<corpusIter> ());
+            }
+
+        template <typename Range>
+        typename boost::range_iterator<Range>::type operator () ( Range &r ) const {
+            return (*this) (boost::begin(r), boost::end(r));
+            }
+
+        static constexpr std::size_t pattern_length () { return M; }
+
+    private:
+/// \cond DOXYGEN_HIDE
+        static constexpr charT k_pattern [ M ] = { Chars... };
+        static constexpr skip_table_type k_skip = skip_table_type::template build<true, Chars...> ();
+
+        template <typename corpusIter>
+        corpusIter do_search ( corpusIter corpus_first, corpusIter corpus_last, boost::false_type ) const {
+            corpusIter curPos = corpus_first;
+            const corpusIter lastPos = corpus_last - M;
+            while ( curPos <= lastPos ) {
+            //  Do we match right where we are?
+                std::size_t j = M - 1;
+                while ( k_pattern [j] == curPos [j] ) {
+                //  We matched - we're done!
+                    if ( j == 0 )
+                        return curPos;
+                    j--;
+                    }
+
+                curPos += k_skip [ curPos [ M - 1 ]];
+                }
+
+            return corpus_last;
+            }
+
+    //  Contiguous bytes: the vectorized candidate filter, as boyer_moore_horspool uses
+        template <typename corpusIter>
+        corpusIter do_search ( corpusIter corpus_first, corpusIter corpus_last, boost::true_type ) const {
+            const unsigned char *first = detail::as_bytes ( corpus_first );
+            const unsigned char *last  = first + std::distance ( corpus_first, corpus_last );
+            return corpus_first + ( detail::simd_search ( first, last, &k_pattern [ 0 ], M ) - first );
+            }
+/// \endcond
+        };
+
+    template <typename charT, charT... Chars>
+    constexpr charT static_horspool<charT, Chars...>::k_pattern [];
+
+    template <typename charT, charT... Chars>
+    constexpr typename static_horspool<charT, Chars...>::skip_table_type static_horspool<charT, Chars...>::k_skip;
+
+
+    template <typename charT, charT... Chars>
+    class static_boyer_moore {
+        BOOST_STATIC_ASSERT_MSG ( sizeof... ( Chars ) > 0, "The pattern must not be empty" );
+        static constexpr std::size_t M = sizeof... ( Chars );
+        typedef typename detail::static_entry<M>::type entry_type;
+        typedef detail::static_skip_table<charT, entry_type, M> skip_table_type;
+        typedef detail::static_array<entry_type, M + 1> suffix_table_type;
+    public:
+        constexpr static_boyer_moore () {}
+
+        /// \fn operator ( corpusIter corpus_first, corpusIter corpus_last )
+        /// \brief Searches the corpus for the pattern
+        ///
+        /// \param corpus_first The start of the data to search (Random Access Iterator)
+        /// \param corpus_last  One past the end of the data to search
+        ///
+        template <typename corpusIter>
+        corpusIter operator () ( corpusIter corpus_first, corpusIter corpus_last ) const {
+            BOOST_STATIC_ASSERT (( boost::is_same<charT,
+                typename std::iterator_traits<corpusIter>::value_type>::value ));
+
+            if ( corpus_first == corpus_last ) return corpus_last;  // if nothing to search, we didn't find it!
+            if ( std::distance ( corpus_first, corpus_last ) < static_cast<std::ptrdiff_t> ( M ))
+                return corpus_last;
+
+            corpusIter curPos = corpus_first;
+            const corpusIter lastPos = corpus_last - M;
+            while ( curPos <= lastPos ) {
+            //  Do we match right where we are?
+                std::ptrdiff_t j = M;
+                while ( k_pattern [j-1] == curPos [j-1] ) {
+                    j--;
+                //  We matched - we're done!
+                    if ( j == 0 )
+                        return curPos;
+                    }
+
+            //  Since we didn't match, figure out how far to skip forward
+                const std::ptrdiff_t k = static_cast<std::ptrdiff_t> ( k_skip [ curPos [ j - 1 ]] ) - 1;
+                const std::ptrdiff_t m = j - k - 1;
+                if ( k < j && m > k_suffix [ j ] )
+                    curPos += m;
+                else
+                    curPos += k_suffix [ j ];
+                }
+
+            return corpus_last;     // We didn't find anything
+            }
+
+        template <typename Range>
+        typename boost::range_iterator<Range>::type operator () ( Range &r ) const {
+            return (*this) (boost::begin(r), boost::end(r));
+            }
+
+        static constexpr std::size_t pattern_length () { return M; }
+
+    private:
+/// \cond DOXYGEN_HIDE
+        static constexpr charT k_pattern [ M ] = { Chars... };
+        static constexpr skip_table_type   k_skip   = skip_table_type::template build<false, Chars...> ();
+        static constexpr suffix_table_type k_suffix = detail::static_bm_suffix_table<entry_type, charT, Chars...> ();
+/// \endcond
+        };
+
+    template <typename charT, charT... Chars>
+    constexpr charT static_boyer_moore<charT, Chars...>::k_pattern [];
+
+    template <typename charT, charT... Chars>
+    constexpr typename static_boyer_moore<charT, Chars...>::skip_table_type static_boyer_moore<charT, Chars...>::k_skip;
+
+    template <typename charT, charT... Chars>
+    constexpr typename static_boyer_moore<charT, Chars...>::suffix_table_type static_boyer_moore<charT, Chars...>::k_suffix;
+
+}}
+
+#endif  //  !BOOST_NO_CXX14_CONSTEXPR && !BOOST_NO_CXX11_VARIADIC_TEMPLATES
+
+#endif  //  BOOST_ALGORITHM_STATIC_SEARCH_HPP
@@ -0,0 +1,249 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+#ifndef BOOST_ALGORITHM_STREAM_SEARCHER_HPP
+#define BOOST_ALGORITHM_STREAM_SEARCHER_HPP
+
+#include <vector>
+#include <iterator>     // for std::iterator_traits
+#include <algorithm>    // for std::min
+
+#include <boost/assert.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/cstdint.hpp>
+
+#include <boost/range/begin.hpp>
+#include <boost/range/end.hpp>
+
+#include <boost/type_traits/is_same.hpp>
+
+#include <boost/algorithm/searching/boyer_moore_horspool.hpp>
+#include <boost/algorithm/searching/knuth_morris_pratt.hpp>
+#include <boost/algorithm/searching/match_mode.hpp>
+#include <boost/algorithm/searching/detail/offset_iterator.hpp>
+
+namespace boost { namespace algorithm {
+
+/*
+    Searching a corpus that arrives as a sequence of separate buffers.
+
+    Each chunk is searched in place with the underlying searcher. To find the
+    matches that straddle two chunks, the searcher keeps a copy of the last
+    (pattern length - 1) elements it has seen, and searches that joined to the
+    start of the next chunk. Nothing else is copied, so the memory used is
+    bounded by the pattern length, not the chunk size.
+
+    Matches are reported as offsets from the start of the stream.
+
+    Requirements:
+        * Random access iterators for the pattern
+        * Forward iterators for the chunks; random access ones if the
+            underlying searcher requires them
+        * The pattern and chunk iterators must "point to" the same type.
+*/
+
+    template <typename patIter, typename Searcher = boyer_moore_horspool<patIter> >
+    class stream_searcher {
+        typedef typename std::iterator_traits<patIter>::value_type      value_type;
+        typedef typename std::iterator_traits<patIter>::difference_type difference_type;
+        typedef typename std::vector<value_type>::const_iterator        join_iterator;
+    public:
+        typedef boost::uintmax_t offset_type;
+
+        stream_searcher ( patIter first, patIter last, match_mode_type mode = match_overlapping )
+                : searcher_ ( first, last ),
+                  k_pattern_length ( std::distance ( first, last )),
+                  mode_ ( mode ), offset_ ( 0 ), next_start_ ( 0 ) {}
+
+    //  Search with (a copy of) a searcher that has already been built
+        explicit stream_searcher ( const Searcher &searcher, match_mode_type mode = match_overlapping )
+                : searcher_ ( searcher ),
+                  k_pattern_length ( searcher.pattern_length ()),
+                  mode_ ( mode ), offset_ ( 0 ), next_start_ ( 0 ) {}
+
+        ~stream_searcher () {}
+
+        /// \fn operator ( corpusIter chunk_first, corpusIter chunk_last, OutputIterator out )
+        /// \brief Searches the next chunk of the stream
+        ///
+        /// \param chunk_first  The start of the chunk
+        /// \param chunk_last   One past the end of the chunk
+        /// \param out          Receives the stream offset of each match that ends in this chunk
+        ///
+        template <typename corpusIter, typename OutputIterator>
+        OutputIterator operator () ( corpusIter chunk_first, corpusIter chunk_last, OutputIterator out ) {
+            BOOST_STATIC_ASSERT (( boost::is_same<value_type,
+                typename std::iterator_traits<corpusIter>::value_type>::value ));
+
+            const offset_type k_chunk_length = std::distance ( chunk_first, chunk_last );
+            if ( k_pattern_length == 0 || k_chunk_length == 0 ) {
+                offset_ += k_chunk_length;
+                return out;
+                }
+
+        //  Matches that start in the saved tail, and end in this chunk
+            if ( !tail_.empty ()) {
+                const offset_type k_tail_offset = offset_ - tail_.size ();
+                corpusIter head_last = chunk_first;
+                std::advance ( head_last, std::min<offset_type> ( k_chunk_length, k_pattern_length - 1 ));
+                join_.assign ( tail_.begin (), tail_.end ());
+                join_.insert ( join_.end (), chunk_first, head_last );
+
+                const std::vector<value_type> &join = join_;
+                hits_.clear ();
+                searcher_.find_all ( join.begin (), join.end (), std::back_inserter ( hits_ ));
+                for ( typename std::vector<join_iterator>::const_iterator it = hits_.begin (); it != hits_.end (); ++it ) {
+                    const offset_type start = std::distance ( join.begin (), *it );
+                    if ( start >= tail_.size ())
+                        break;
+                    if ( k_tail_offset + start >= next_start_ ) {
+                        *out++ = k_tail_offset + start;
+                        next_start_ = k_tail_offset + start + ( mode_ == match_overlapping ? 1 : k_pattern_length );
+                        }
+                    }
+                }
+
+        //  Matches that lie entirely in this chunk
+            corpusIter body_first = chunk_first;
+            if ( next_start_ > offset_ )
+                std::advance ( body_first, std::min<offset_type> ( k_chunk_length, next_start_ - offset_ ));
+            const offset_type k_body_offset = offset_ + std::distance ( chunk_first, body_first );
+            offset_type last_match = k_no_match;
+            out = searcher_.find_all ( body_first, chunk_last,
+                    detail::offset_output_iterator<corpusIter, OutputIterator> ( body_first, k_body_offset, out, &last_match ),
+                    mode_ ).base ();
+            if ( last_match != k_no_match )
+                next_start_ = last_match + ( mode_ == match_overlapping ? 1 : k_pattern_length );
+
+        //  Save the end of what we've seen for the next chunk
+            const std::size_t k_keep = k_pattern_length - 1;
+            if ( k_chunk_length >= k_keep ) {
+                corpusIter keep_first = chunk_first;
+                std::advance ( keep_first, k_chunk_length - k_keep );
+                tail_.assign ( keep_first, chunk_last );
+                }
+            else {
+                tail_.insert ( tail_.end (), chunk_first, chunk_last );
+                if ( tail_.size () > k_keep )
+                    tail_.erase ( tail_.begin (), tail_.begin () + ( tail_.size () - k_keep ));
+                }
+
+            offset_ += k_chunk_length;
+            return out;
+            }
+
+        template <typename Range, typename OutputIterator>
+        OutputIterator operator () ( const Range &r, OutputIterator out ) {
+            return (*this) (boost::begin(r), boost::end(r), out);
+            }
+
+    //  The number of elements searched so far
+        offset_type offset () const { return offset_; }
+
+    //  Start again, at the beginning of a new stream
+        void reset () {
+            offset_ = next_start_ = 0;
+            tail_.clear ();
+            }
+
+    private:
+/// \cond DOXYGEN_HIDE
+        Searcher searcher_;
+        const difference_type k_pattern_length;
+        const match_mode_type mode_;
+        offset_type offset_;        // stream offset of the start of the next chunk
+        offset_type next_start_;    // the first offset where the next match may start
+        std::vector<value_type> tail_;
+        std::vector<value_type> join_;
+        std::vector<join_iterator> hits_;
+
+        static const offset_type k_no_match = ~offset_type ( 0 );
+/// \endcond
+        };
+
+
+    template <typename patIter, typename Searcher>
+    const typename stream_searcher<patIter, Searcher>::offset_type
+        stream_searcher<patIter, Searcher>::k_no_match;
+
+
+/*
+    The Knuth-Morris-Pratt matcher never looks back at the corpus, so instead
+    of saving a tail, this specialization just carries the matcher's state
+    from one chunk to the next.
+*/
+    template <typename patIter, typename Alloc, typename Instrumentation>
+    class stream_searcher<patIter, knuth_morris_pratt<patIter, Alloc, Instrumentation> > {
+        typedef typename std::iterator_traits<patIter>::value_type      value_type;
+        typedef typename std::iterator_traits<patIter>::difference_type difference_type;
+    public:
+        typedef boost::uintmax_t offset_type;
+
+        stream_searcher ( patIter first, patIter last, match_mode_type mode = match_overlapping )
+                : searcher_ ( first, last ),
+                  k_pattern_length ( std::distance ( first, last )),
+                  mode_ ( mode ), offset_ ( 0 ), matched_ ( 0 ) {}
+
+        explicit stream_searcher ( const knuth_morris_pratt<patIter, Alloc, Instrumentation> &searcher,
+                                   match_mode_type mode = match_overlapping )
+                : searcher_ ( searcher ),
+                  k_pattern_length ( searcher.pattern_length ()),
+                  mode_ ( mode ), offset_ ( 0 ), matched_ ( 0 ) {}
+
+        ~stream_searcher () {}
+
+        template <typename corpusIter, typename OutputIterator>
+        OutputIterator operator () ( corpusIter chunk_first, corpusIter chunk_last, OutputIterator out ) {
+            BOOST_STATIC_ASSERT (( boost::is_same<value_type,
+                typename std::iterator_traits<corpusIter>::value_type>::value ));
+
+            if ( k_pattern_length == 0 ) {
+                offset_ += std::distance ( chunk_first, chunk_last );
+                return out;
+                }
+
+            while ( chunk_first != chunk_last ) {
+                corpusIter next = searcher_.feed ( chunk_first, chunk_last, matched_ );
+                offset_ += std::distance ( chunk_first, next );
+                if ( matched_ == k_pattern_length ) {
+                    *out++ = offset_ - k_pattern_length;
+                    if ( mode_ == match_non_overlapping )
+                        matched_ = 0;
+                    }
+                chunk_first = next;
+                }
+
+            return out;
+            }
+
+        template <typename Range, typename OutputIterator>
+        OutputIterator operator () ( const Range &r, OutputIterator out ) {
+            return (*this) (boost::begin(r), boost::end(r), out);
+            }
+
+        offset_type offset () const { return offset_; }
+
+        void reset () {
+            offset_ = 0;
+            matched_ = 0;
+            }
+
+    private:
+/// \cond DOXYGEN_HIDE
+        knuth_morris_pratt<patIter, Alloc, Instrumentation> searcher_;
+        const difference_type k_pattern_length;
+        const match_mode_type mode_;
+        offset_type offset_;
+        difference_type matched_;
+/// \endcond
+        };
+
+}}
+
+#endif  //  BOOST_ALGORITHM_STREAM_SEARCHER_HPP
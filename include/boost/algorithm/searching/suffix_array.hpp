@@ -0,0 +1,562 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+#ifndef BOOST_ALGORITHM_SUFFIX_ARRAY_HPP
+#define BOOST_ALGORITHM_SUFFIX_ARRAY_HPP
+
+#include <cstddef>      // for std::size_t
+#include <cstring>      // for std::memcpy
+#include <string>
+#include <vector>
+#include <utility>      // for std::pair
+#include <iterator>     // for std::iterator_traits, std::distance
+#include <algorithm>    // for std::sort, std::unique, std::lower_bound, std::min
+#include <istream>
+#include <ostream>
+#include <limits>
+#include <stdexcept>    // for std::length_error, std::invalid_argument
+
+#include <boost/config.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/throw_exception.hpp>
+
+#include <boost/range/begin.hpp>
+#include <boost/range/end.hpp>
+#include <boost/range/iterator.hpp>
+
+#include <boost/type_traits/is_same.hpp>
+#include <boost/type_traits/is_integral.hpp>
+#include <boost/type_traits/is_signed.hpp>
+#include <boost/type_traits/is_unsigned.hpp>
+#include <boost/type_traits/integral_constant.hpp>
+#include <boost/type_traits/alignment_of.hpp>
+
+#include <boost/algorithm/searching/match_mode.hpp>
+#include <boost/algorithm/searching/search_file.hpp>
+#include <boost/algorithm/searching/detail/sais.hpp>
+
+namespace boost { namespace algorithm {
+
+/*
+    An index of a fixed corpus, for answering many searches for different
+    patterns.
+
+    The searchers in this library preprocess the pattern, so each search
+    costs time in proportion to the length of the corpus. A suffix array
+    preprocesses the corpus instead: it holds the start of every suffix of
+    the corpus, in lexicographic order. All the suffixes that start with a
+    pattern are next to each other in that order, and are found with two
+    binary searches, in O(m log n) time whatever the corpus looks like.
+
+    The array is built in linear time with SA-IS (see detail/sais.hpp),
+    together with the LCP array: lcp()[i] is the length of the longest
+    common prefix of the suffixes at suffixes()[i-1] and suffixes()[i].
+
+    To find the first match without looking at all of them, the index also
+    keeps the smallest start in each block of k_block suffixes, and the
+    smallest in each run of 2, 4, 8, ... of those blocks (a sparse table).
+    The smallest start in any range of suffixes is then the smaller of two
+    table entries and of the suffixes in two partial blocks at its ends.
+
+    The positions are stored as 'Index', which is boost::uint32_t by
+    default, so the index takes a little over 8 bytes per element of the
+    corpus (4 for the suffixes, 4 for the LCP, and about (log2 n)/k_block
+    entries for the block minima). Corpora of 4 GiB or more need a 64-bit
+    Index.
+
+    An index can be saved to a stream, and later read back or mapped from a
+    file, so that it need not be rebuilt every time a program starts.
+
+    The index refers to the corpus through its iterators, and does not copy
+    it; the corpus must not change, or go away, while the index is in use.
+
+    Requirements:
+        * Random access iterators
+        * The pattern iterators and the corpus iterators must
+            "point to" the same underlying type, which must be
+            LessThanComparable.
+        * Index must be an unsigned integral type.
+*/
+
+    template <typename corpusIter, typename Index = boost::uint32_t>
+    class suffix_array {
+        typedef typename std::iterator_traits<corpusIter>::value_type value_type;
+        BOOST_STATIC_ASSERT (( boost::is_integral<Index>::value && boost::is_unsigned<Index>::value ));
+
+    public:
+        typedef Index index_type;
+
+    //  The number of suffixes in each block of the range minimum table
+        BOOST_STATIC_CONSTANT ( std::size_t, k_block = 256 );
+
+        suffix_array ( corpusIter corpus_first, corpusIter corpus_last )
+                : corpus_first_ ( corpus_first ), corpus_last_ ( corpus_last ),
+                  size_ ( std::distance ( corpus_first, corpus_last )),
+                  sa_view_ ( NULL ), lcp_view_ ( NULL ), rmq_view_ ( NULL ) {
+            this->build ();
+            }
+
+        /// \fn suffix_array ( corpusIter corpus_first, corpusIter corpus_last, std::istream &in )
+        /// \brief Reads an index of the corpus that was written by save
+        ///
+        /// \throw std::invalid_argument if the stream does not hold an index of this corpus
+        ///
+        suffix_array ( corpusIter corpus_first, corpusIter corpus_last, std::istream &in )
+                : corpus_first_ ( corpus_first ), corpus_last_ ( corpus_last ),
+                  size_ ( std::distance ( corpus_first, corpus_last )),
+                  sa_view_ ( NULL ), lcp_view_ ( NULL ), rmq_view_ ( NULL ) {
+            header h;
+            if ( !in.read ( reinterpret_cast<char *> ( &h ), sizeof ( h )))
+                bad_index ();
+            this->check_header ( h );
+            this->layout_rmq ();
+            sa_.resize  ( size_ );
+            lcp_.resize ( size_ );
+            rmq_.resize ( rmq_levels_.empty () ? 0 : rmq_levels_.back ());
+            if ( size_ > 0 && !( in.read ( reinterpret_cast<char *> ( &sa_  [ 0 ] ), size_ * sizeof ( Index )) &&
+                                 in.read ( reinterpret_cast<char *> ( &lcp_ [ 0 ] ), size_ * sizeof ( Index ))))
+                bad_index ();
+            if ( !rmq_.empty () && !in.read ( reinterpret_cast<char *> ( &rmq_ [ 0 ] ), rmq_.size () * sizeof ( Index )))
+                bad_index ();
+            }
+
+        /// \fn suffix_array ( corpusIter corpus_first, corpusIter corpus_last, const void *image, std::size_t image_size )
+        /// \brief Uses an index of the corpus that was written by save, and is now
+        ///         in memory (mapped from a file, say). Nothing is copied; the memory
+        ///         must outlive the index.
+        ///
+        /// \throw std::invalid_argument if the memory does not hold an index of this
+        ///         corpus, or is not suitably aligned for Index
+        ///
+        suffix_array ( corpusIter corpus_first, corpusIter corpus_last, const void *image, std::size_t image_size )
+                : corpus_first_ ( corpus_first ), corpus_last_ ( corpus_last ),
+                  size_ ( std::distance ( corpus_first, corpus_last )),
+                  sa_view_ ( NULL ), lcp_view_ ( NULL ), rmq_view_ ( NULL ) {
+            this->attach ( static_cast<const char *> ( image ), image_size );
+            }
+
+        /// \fn suffix_array ( corpusIter corpus_first, corpusIter corpus_last, const char *path )
+        /// \brief Maps an index of the corpus that was saved to a file. On systems
+        ///         without mmap, the file is read into memory instead.
+        ///
+        /// \throw search_file_error if the file cannot be opened or read
+        /// \throw std::invalid_argument if the file does not hold an index of this corpus
+        ///
+        suffix_array ( corpusIter corpus_first, corpusIter corpus_last, const char *path )
+                : corpus_first_ ( corpus_first ), corpus_last_ ( corpus_last ),
+                  size_ ( std::distance ( corpus_first, corpus_last )),
+                  sa_view_ ( NULL ), lcp_view_ ( NULL ), rmq_view_ ( NULL ),
+                  file_ ( new detail::file_view ( path, false )) {
+            file_->load ();
+            this->attach ( file_->begin (), file_->size ());
+            }
+
+        suffix_array ( corpusIter corpus_first, corpusIter corpus_last, const std::string &path )
+                : corpus_first_ ( corpus_first ), corpus_last_ ( corpus_last ),
+                  size_ ( std::distance ( corpus_first, corpus_last )),
+                  sa_view_ ( NULL ), lcp_view_ ( NULL ), rmq_view_ ( NULL ),
+                  file_ ( new detail::file_view ( path.c_str (), false )) {
+            file_->load ();
+            this->attach ( file_->begin (), file_->size ());
+            }
+
+        ~suffix_array () {}
+
+    //  The length of the corpus
+        std::size_t size () const { return size_; }
+
+    //  The start of each suffix of the corpus, in order
+        const index_type *suffixes () const { return sa_.empty ()  ? sa_view_  : &sa_ [ 0 ]; }
+
+    //  The length of the prefix that each suffix shares with the one before it
+        const index_type *lcp () const      { return lcp_.empty () ? lcp_view_ : &lcp_ [ 0 ]; }
+
+        /// \fn equal_range ( patIter pat_first, patIter pat_last )
+        /// \brief Finds the suffixes that start with the pattern
+        ///
+        /// \param pat_first    The start of the pattern to search for (Random Access Iterator)
+        /// \param pat_last     One past the end of the pattern
+        ///
+        /// \return The range of suffixes(), in lexicographic order, that start with
+        ///         the pattern; empty if there are none.
+        ///
+        template <typename patIter>
+        std::pair<const index_type *, const index_type *> equal_range ( patIter pat_first, patIter pat_last ) const {
+            BOOST_STATIC_ASSERT (( boost::is_same<value_type,
+                typename std::iterator_traits<patIter>::value_type>::value ));
+
+            const std::size_t m = std::distance ( pat_first, pat_last );
+            const std::size_t lo = this->bound ( pat_first, m, 0, false );
+            const std::size_t hi = this->bound ( pat_first, m, lo, true );
+            return std::make_pair ( suffixes () + lo, suffixes () + hi );
+            }
+
+        template <typename Range>
+        std::pair<const index_type *, const index_type *> equal_range ( const Range &r ) const {
+            return this->equal_range (boost::begin(r), boost::end(r));
+            }
+
+        /// \fn find_first ( patIter pat_first, patIter pat_last )
+        /// \brief Finds the first occurrence of the pattern in the corpus
+        ///
+        /// \param pat_first    The start of the pattern to search for (Random Access Iterator)
+        /// \param pat_last     One past the end of the pattern
+        ///
+        /// \return The start of the first match, or the end of the corpus if there is
+        ///         none. An empty pattern matches at the start of the corpus.
+        ///
+        /// Takes O(m log n) time, however many matches there are.
+        ///
+        template <typename patIter>
+        corpusIter find_first ( patIter pat_first, patIter pat_last ) const {
+            if ( pat_first == pat_last ) return corpus_first_;
+
+            const std::pair<const index_type *, const index_type *> r = this->equal_range ( pat_first, pat_last );
+            if ( r.first == r.second ) return corpus_last_;
+            return corpus_first_ + this->range_min ( r.first - suffixes (), r.second - suffixes ());
+            }
+
+        template <typename Range>
+        corpusIter find_first ( const Range &r ) const {
+            return this->find_first (boost::begin(r), boost::end(r));
+            }
+
+        /// \fn find_all ( patIter pat_first, patIter pat_last, OutputIterator out, match_mode_type mode )
+        /// \brief Finds every occurrence of the pattern in the corpus
+        ///
+        /// \param pat_first    The start of the pattern to search for (Random Access Iterator)
+        /// \param pat_last     One past the end of the pattern
+        /// \param out          An output iterator which receives the start of each match,
+        ///                     in the order they occur in the corpus
+        /// \param mode         Whether or not to report overlapping matches
+        ///
+        /// The matches are found in lexicographic order, so they are copied into a
+        /// temporary vector and sorted: this takes O(m log n + k log k) time and
+        /// allocates k Index values, where k is the number of overlapping matches.
+        ///
+        template <typename patIter, typename OutputIterator>
+        OutputIterator find_all ( patIter pat_first, patIter pat_last,
+                        OutputIterator out, match_mode_type mode = match_overlapping ) const {
+            if ( pat_first == pat_last ) return out;    // empty pattern matches nothing here
+
+            const std::vector<index_type> starts = this->sorted_matches ( pat_first, pat_last );
+            const std::size_t m = std::distance ( pat_first, pat_last );
+            std::size_t next = 0;   // where the next match may start
+            for ( typename std::vector<index_type>::const_iterator it = starts.begin (); it != starts.end (); ++it ) {
+                if ( *it < next ) continue;
+                *out++ = corpus_first_ + *it;
+                next = mode == match_overlapping ? 0 : *it + m;
+                }
+            return out;
+            }
+
+        template <typename Range, typename OutputIterator>
+        OutputIterator find_all ( const Range &r, OutputIterator out, match_mode_type mode = match_overlapping ) const {
+            return this->find_all (boost::begin(r), boost::end(r), out, mode);
+            }
+
+        /// \fn count ( patIter pat_first, patIter pat_last, match_mode_type mode )
+        /// \brief Counts the occurrences of the pattern in the corpus
+        ///
+        /// \param pat_first    The start of the pattern to search for (Random Access Iterator)
+        /// \param pat_last     One past the end of the pattern
+        /// \param mode         Whether or not to count overlapping matches
+        ///
+        /// Overlapping matches are counted in O(m log n) time, with no allocation.
+        /// Non-overlapping ones are counted as find_all finds them: the k overlapping
+        /// matches are copied and sorted, in O(m log n + k log k) time.
+        ///
+        template <typename patIter>
+        std::size_t count ( patIter pat_first, patIter pat_last, match_mode_type mode = match_overlapping ) const {
+            if ( pat_first == pat_last ) return 0;
+
+            if ( mode == match_overlapping ) {
+                const std::pair<const index_type *, const index_type *> r = this->equal_range ( pat_first, pat_last );
+                return r.second - r.first;
+                }
+
+            const std::vector<index_type> starts = this->sorted_matches ( pat_first, pat_last );
+            const std::size_t m = std::distance ( pat_first, pat_last );
+            std::size_t retVal = 0;
+            std::size_t next = 0;
+            for ( typename std::vector<index_type>::const_iterator it = starts.begin (); it != starts.end (); ++it )
+                if ( *it >= next ) {
+                    ++retVal;
+                    next = *it + m;
+                    }
+            return retVal;
+            }
+
+        template <typename Range>
+        std::size_t count ( const Range &r, match_mode_type mode = match_overlapping ) const {
+            return this->count (boost::begin(r), boost::end(r), mode);
+            }
+
+        /// \fn save ( std::ostream &out )
+        /// \brief Writes the index (but not the corpus) to a binary stream. The
+        ///         format is that of the machine: it can only be read back where
+        ///         Index has the same size and byte order.
+        ///
+        void save ( std::ostream &out ) const {
+            header h;
+            h.magic         = k_magic;
+            h.version       = k_version;
+            h.index_size    = sizeof ( Index );
+            h.reserved      = 0;
+            h.corpus_length = size_;
+            out.write ( reinterpret_cast<const char *> ( &h ), sizeof ( h ));
+            if ( size_ > 0 ) {
+                out.write ( reinterpret_cast<const char *> ( suffixes ()), size_ * sizeof ( Index ));
+                out.write ( reinterpret_cast<const char *> ( lcp ()),      size_ * sizeof ( Index ));
+                out.write ( reinterpret_cast<const char *> ( block_minima ()), rmq_levels_.back () * sizeof ( Index ));
+                }
+            }
+
+    private:
+/// \cond DOXYGEN_HIDE
+    //  What save writes before the arrays
+        struct header {
+            boost::uint32_t magic;
+            boost::uint32_t version;
+            boost::uint32_t index_size;
+            boost::uint32_t reserved;
+            boost::uint64_t corpus_length;
+            };
+
+        static const boost::uint32_t k_magic   = 0x41534142;   // "BASA", in little-endian order
+        static const boost::uint32_t k_version = 2;
+
+        corpusIter corpus_first_, corpus_last_;
+        std::size_t size_;
+        std::vector<index_type> sa_;            // the arrays, when the index owns them
+        std::vector<index_type> lcp_;
+        std::vector<index_type> rmq_;           // the block minima, level by level
+        const index_type *sa_view_;             // ... and when it does not
+        const index_type *lcp_view_;
+        const index_type *rmq_view_;
+        std::vector<std::size_t> rmq_levels_;   // where each level of rmq_ starts, and where the last one ends
+        boost::shared_ptr<detail::file_view> file_;
+
+        const index_type *block_minima () const { return rmq_.empty () ? rmq_view_ : &rmq_ [ 0 ]; }
+
+        static void bad_index () {
+            boost::throw_exception ( std::invalid_argument ( "boost::algorithm: not a suffix_array index of this corpus" ));
+            }
+
+        void check_header ( const header &h ) const {
+            if ( h.magic != k_magic || h.version != k_version || h.index_size != sizeof ( Index ) ||
+                    h.corpus_length != size_ )
+                bad_index ();
+            }
+
+        void attach ( const char *image, std::size_t image_size ) {
+            header h;
+            if ( image_size < sizeof ( h ))
+                bad_index ();
+            std::memcpy ( &h, image, sizeof ( h ));
+            this->check_header ( h );
+            this->layout_rmq ();
+            const std::size_t k_entries = 2 * size_ + ( rmq_levels_.empty () ? 0 : rmq_levels_.back ());
+            if ( image_size - sizeof ( h ) != k_entries * sizeof ( Index ) ||
+                    reinterpret_cast<boost::uintptr_t> ( image ) % boost::alignment_of<Index>::value != 0 )
+                bad_index ();
+            sa_view_  = reinterpret_cast<const index_type *> ( image + sizeof ( h ));
+            lcp_view_ = sa_view_ + size_;
+            rmq_view_ = lcp_view_ + size_;
+            }
+
+    //  Level 0 of the range minimum table has one entry for each block of
+    //  suffixes; level k has the minimum of each run of 2^k blocks. Nothing
+    //  is stored for an empty corpus.
+        void layout_rmq () {
+            rmq_levels_.clear ();
+            if ( size_ == 0 )
+                return;
+            const std::size_t k_blocks = ( size_ + k_block - 1 ) / k_block;
+            rmq_levels_.push_back ( 0 );
+            for ( std::size_t width = 1; width <= k_blocks; width *= 2 )
+                rmq_levels_.push_back ( rmq_levels_.back () + k_blocks - width + 1 );
+            }
+
+        void build_rmq () {
+            this->layout_rmq ();
+            rmq_.resize ( rmq_levels_.back ());
+            for ( std::size_t i = 0; i < size_; i += k_block )
+                rmq_ [ i / k_block ] = *std::min_element ( &sa_ [ i ], &sa_ [ 0 ] + (std::min) ( i + k_block, size_ ));
+            for ( std::size_t level = 1, half = 1; level + 1 < rmq_levels_.size (); ++level, half *= 2 ) {
+                index_type *dest = &rmq_ [ rmq_levels_ [ level ]];
+                const index_type *src = &rmq_ [ rmq_levels_ [ level - 1 ]];
+                const std::size_t k_count = rmq_levels_ [ level + 1 ] - rmq_levels_ [ level ];
+                for ( std::size_t i = 0; i < k_count; ++i )
+                    dest [ i ] = (std::min) ( src [ i ], src [ i + half ] );
+                }
+            }
+
+    //  The smallest start among suffixes()[lo, hi), which is not empty
+        std::size_t range_min ( std::size_t lo, std::size_t hi ) const {
+            const index_type *sa = suffixes ();
+            if ( hi - lo <= 2 * k_block )
+                return *std::min_element ( sa + lo, sa + hi );
+
+        //  The whole blocks in the middle, from the two runs of blocks that cover them
+            const std::size_t first_block = ( lo + k_block - 1 ) / k_block;
+            const std::size_t last_block  = hi / k_block;
+            std::size_t level = 0;
+            while (( static_cast<std::size_t> ( 2 ) << level ) <= last_block - first_block )
+                ++level;
+            const index_type *minima = block_minima () + rmq_levels_ [ level ];
+            index_type retVal = (std::min) ( minima [ first_block ], minima [ last_block - ( static_cast<std::size_t> ( 1 ) << level ) ] );
+
+        //  ... and the partial blocks at the ends
+            for ( std::size_t i = lo; i < first_block * k_block; ++i )
+                retVal = (std::min) ( retVal, sa [ i ] );
+            for ( std::size_t i = last_block * k_block; i < hi; ++i )
+                retVal = (std::min) ( retVal, sa [ i ] );
+            return retVal;
+            }
+
+    //  Replace each element of the corpus by its rank among the elements, plus
+    //  one; return the size of the alphabet, including the sentinel (0)
+        std::size_t rank_elements ( std::vector<index_type> &text, boost::true_type ) const {
+            const unsigned char k_flip = boost::is_signed<value_type>::value ? 0x80 : 0;
+            corpusIter it = corpus_first_;
+            for ( std::size_t i = 0; i < size_; ++i, ++it )
+                text [ i ] = 1 + static_cast<unsigned char> ( static_cast<unsigned char> ( *it ) ^ k_flip );
+            return 257;
+            }
+
+        std::size_t rank_elements ( std::vector<index_type> &text, boost::false_type ) const {
+            std::vector<value_type> alphabet ( corpus_first_, corpus_last_ );
+            std::sort ( alphabet.begin (), alphabet.end ());
+            alphabet.erase ( std::unique ( alphabet.begin (), alphabet.end ()), alphabet.end ());
+            corpusIter it = corpus_first_;
+            for ( std::size_t i = 0; i < size_; ++i, ++it )
+                text [ i ] = static_cast<index_type> ( 1 +
+                    ( std::lower_bound ( alphabet.begin (), alphabet.end (), *it ) - alphabet.begin ()));
+            return alphabet.size () + 1;
+            }
+
+        void build () {
+        //  The sentinel takes one more position, and the largest value marks empty slots
+            if ( size_ >= static_cast<std::size_t> ( std::numeric_limits<index_type>::max () - 1 ))
+                boost::throw_exception ( std::length_error ( "boost::algorithm: corpus too long for the suffix_array index type" ));
+            if ( size_ == 0 )
+                return;
+
+            std::vector<index_type> text ( size_ + 1 );
+            const std::size_t k_alphabet = this->rank_elements ( text, boost::integral_constant<bool,
+                boost::is_integral<value_type>::value && sizeof ( value_type ) == 1> ());
+            text [ size_ ] = 0;
+
+            sa_.resize ( size_ + 1 );
+            detail::suffix_sort ( &text [ 0 ], &sa_ [ 0 ], size_ + 1, k_alphabet );
+            sa_.erase ( sa_.begin ());      // the sentinel's suffix sorts first
+
+        //  The LCP array, by Kasai's method in its "permuted" form: going through
+        //  the suffixes in text order, each one shares at least one element less
+        //  with its predecessor (in sorted order) than the suffix before it did.
+            std::vector<index_type> plcp ( size_ );
+            plcp [ sa_ [ 0 ]] = static_cast<index_type> ( size_ );     // no predecessor
+            for ( std::size_t i = 1; i < size_; ++i )
+                plcp [ sa_ [ i ]] = sa_ [ i - 1 ];
+            std::size_t h = 0;
+            for ( std::size_t i = 0; i < size_; ++i ) {
+                const std::size_t j = plcp [ i ];
+                if ( j == size_ ) {
+                    plcp [ i ] = 0;
+                    h = 0;
+                    continue;
+                    }
+                while ( text [ i + h ] == text [ j + h ] )  // the sentinel stops this
+                    ++h;
+                plcp [ i ] = static_cast<index_type> ( h );
+                if ( h > 0 ) --h;
+                }
+
+            lcp_.resize ( size_ );
+            for ( std::size_t i = 0; i < size_; ++i )
+                lcp_ [ i ] = plcp [ sa_ [ i ]];
+
+            this->build_rmq ();
+            }
+
+    //  Compare the first 'm' elements of the suffix at 'pos' with the pattern,
+    //  knowing that the first 'matched' of them are equal; leaves the length of
+    //  the common prefix in 'matched'
+        template <typename patIter>
+        int compare_suffix ( std::size_t pos, patIter pat_first, std::size_t m, std::size_t &matched ) const {
+            const std::size_t k_limit = (std::min) ( m, size_ - pos );
+            std::size_t i = matched;
+            for ( ; i < k_limit; ++i ) {
+                const value_type &c = corpus_first_ [ pos + i ];
+                if ( c < pat_first [ i ] ) { matched = i; return -1; }
+                if ( pat_first [ i ] < c ) { matched = i; return 1; }
+                }
+            matched = i;
+            return i == m ? 0 : -1;     // a suffix shorter than the pattern comes first
+            }
+
+    //  The first suffix, starting at 'lo', whose first 'm' elements are not less
+    //  than the pattern ('upper' == false) or are greater than it ('upper' == true).
+    //  Every suffix between two others shares at least as long a prefix with the
+    //  pattern as both of them do, so the comparisons skip that much.
+        template <typename patIter>
+        std::size_t bound ( patIter pat_first, std::size_t m, std::size_t lo, bool upper ) const {
+            const index_type *sa = suffixes ();
+            std::size_t hi = size_;
+            std::size_t lo_match = 0, hi_match = 0;
+            while ( lo < hi ) {
+                const std::size_t mid = lo + ( hi - lo ) / 2;
+                std::size_t matched = (std::min) ( lo_match, hi_match );
+                const int c = this->compare_suffix ( sa [ mid ], pat_first, m, matched );
+                if ( c < 0 || ( upper && c == 0 )) {
+                    lo = mid + 1;
+                    lo_match = matched;
+                    }
+                else {
+                    hi = mid;
+                    hi_match = matched;
+                    }
+                }
+            return lo;
+            }
+
+    //  The starts of all the matches, in corpus order
+        template <typename patIter>
+        std::vector<index_type> sorted_matches ( patIter pat_first, patIter pat_last ) const {
+            const std::pair<const index_type *, const index_type *> r = this->equal_range ( pat_first, pat_last );
+            std::vector<index_type> retVal ( r.first, r.second );
+            std::sort ( retVal.begin (), retVal.end ());
+            return retVal;
+            }
+/// \endcond
+        };
+
+    template <typename corpusIter, typename Index>
+    const std::size_t suffix_array<corpusIter, Index>::k_block;
+
+    template <typename corpusIter, typename Index>
+    const boost::uint32_t suffix_array<corpusIter, Index>::k_magic;
+
+    template <typename corpusIter, typename Index>
+    const boost::uint32_t suffix_array<corpusIter, Index>::k_version;
+
+    //  Creator function -- takes a corpus range, returns an index of it
+    template <typename Range>
+    boost::algorithm::suffix_array<typename boost::range_iterator<const Range>::type>
+    make_suffix_array ( const Range &r ) {
+        return boost::algorithm::suffix_array
+            <typename boost::range_iterator<const Range>::type> (boost::begin(r), boost::end(r));
+        }
+
+}}
+
+#endif  //  BOOST_ALGORITHM_SUFFIX_ARRAY_HPP
@@ -0,0 +1,317 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+#ifndef BOOST_ALGORITHM_TWO_WAY_SEARCH_HPP
+#define BOOST_ALGORITHM_TWO_WAY_SEARCH_HPP
+
+#include <iterator>     // for std::iterator_traits
+#include <algorithm>    // for std::max, std::equal
+
+#include <boost/assert.hpp>
+#include <boost/static_assert.hpp>
+
+#include <boost/range/begin.hpp>
+#include <boost/range/end.hpp>
+
+#include <boost/utility/enable_if.hpp>
+#include <boost/type_traits/is_same.hpp>
+
+#include <boost/algorithm/searching/detail/match_counter.hpp>
+#include <boost/algorithm/searching/match_mode.hpp>
+
+namespace boost { namespace algorithm {
+
+/*
+    A templated version of the Two-Way searching algorithm of Crochemore and
+    Perrin, which is what glibc uses for memmem and strstr.
+
+    The pattern is split at a "critical factorization" into a left part and a
+    right part. The right part is matched left to right, then the left part
+    right to left; the shifts come from the period of the pattern, and, when
+    the pattern is periodic, the searcher remembers how much of the left part
+    is already known to match. The preprocessing finds the factorization with
+    two passes over the pattern, and needs only a few integers of state -
+    nothing is allocated, in the constructor or during the search - and the
+    search is linear in the worst case.
+
+Reference:
+    M. Crochemore and D. Perrin, "Two-way string-matching", JACM 38(3), 1991
+    http://www-igm.univ-mlv.fr/~lecroq/string/node26.html
+
+    Requirements:
+        * Random access iterators
+        * The two iterator types (patIter and corpusIter) must
+            "point to" the same underlying type.
+        * That type must be LessThan Comparable (for the preprocessing)
+            and Equality Comparable.
+*/
+
+    template <typename patIter>
+    class two_way {
+        typedef typename std::iterator_traits<patIter>::difference_type difference_type;
+    public:
+        two_way ( patIter first, patIter last )
+                : pat_first ( first ), pat_last ( last ),
+                  k_pattern_length ( std::distance ( pat_first, pat_last )),
+                  ell_ ( -1 ), period_ ( 1 ), periodic_ ( true ) {
+            if ( k_pattern_length > 0 ) {
+            //  The critical factorization is at the later of the two maximal
+            //  suffixes, one for each ordering of the alphabet
+                difference_type p, q;
+                const difference_type i = max_suffix ( false, p );
+                const difference_type j = max_suffix ( true,  q );
+                ell_    = i > j ? i : j;
+                period_ = i > j ? p : q;
+
+            //  Is the period of the right part a period of the whole pattern?
+                periodic_ = std::equal ( pat_first, pat_first + ell_ + 1, pat_first + period_ );
+                if ( !periodic_ )
+                    period_ = std::max ( ell_ + 1, k_pattern_length - ell_ - 1 ) + 1;
+                }
+            }
+
+        ~two_way () {}
+
+        /// \fn operator ( corpusIter corpus_first, corpusIter corpus_last )
+        /// \brief Searches the corpus for the pattern that was passed into the constructor
+        ///
+        /// \param corpus_first The start of the data to search (Random Access Iterator)
+        /// \param corpus_last  One past the end of the data to search
+        ///
+        template <typename corpusIter>
+        corpusIter operator () ( corpusIter corpus_first, corpusIter corpus_last ) const {
+            BOOST_STATIC_ASSERT (( boost::is_same<
+                typename std::iterator_traits<patIter>::value_type,
+                typename std::iterator_traits<corpusIter>::value_type>::value ));
+
+            if ( corpus_first == corpus_last ) return corpus_last;  // if nothing to search, we didn't find it!
+            if (    pat_first ==    pat_last ) return corpus_first; // empty pattern matches at start
+
+            const difference_type k_corpus_length  = std::distance ( corpus_first, corpus_last );
+        //  If the pattern is larger than the corpus, we can't find it!
+            if ( k_corpus_length < k_pattern_length )
+                return corpus_last;
+
+            difference_type memory = -1;
+            const difference_type found = this->find_from ( corpus_first, k_corpus_length, 0, memory );
+            return found < 0 ? corpus_last : corpus_first + found;
+            }
+
+        template <typename Range>
+        typename boost::range_iterator<Range>::type operator () ( Range &r ) const {
+            return (*this) (boost::begin(r), boost::end(r));
+            }
+
+        /// \fn find_all ( corpusIter corpus_first, corpusIter corpus_last, OutputIterator out, match_mode_type mode )
+        /// \brief Finds every occurrence of the pattern in the corpus
+        ///
+        /// \param corpus_first The start of the data to search (Random Access Iterator)
+        /// \param corpus_last  One past the end of the data to search
+        /// \param out          An output iterator which receives the start of each match
+        /// \param mode         Whether or not to report overlapping matches
+        ///
+        template <typename corpusIter, typename OutputIterator>
+        OutputIterator find_all ( corpusIter corpus_first, corpusIter corpus_last,
+                        OutputIterator out, match_mode_type mode = match_overlapping ) const {
+            BOOST_STATIC_ASSERT (( boost::is_same<
+                typename std::iterator_traits<patIter>::value_type,
+                typename std::iterator_traits<corpusIter>::value_type>::value ));
+            if ( corpus_first == corpus_last ) return out;  // if nothing to search, we didn't find it!
+            if ( pat_first == pat_last )       return out;  // empty pattern matches nothing here
+
+            const difference_type k_corpus_length = std::distance ( corpus_first, corpus_last );
+            difference_type memory = -1;
+            difference_type found = this->find_from ( corpus_first, k_corpus_length, 0, memory );
+            while ( found >= 0 ) {
+                *out++ = corpus_first + found;
+            //  After a match, shift by the period, and remember what of the
+            //  left part is still known to match (only for periodic patterns)
+                if ( mode == match_overlapping ) {
+                    memory = periodic_ ? k_pattern_length - period_ - 1 : -1;
+                    found = this->find_from ( corpus_first, k_corpus_length, found + period_, memory );
+                    }
+                else {
+                    memory = -1;
+                    found = this->find_from ( corpus_first, k_corpus_length, found + k_pattern_length, memory );
+                    }
+                }
+            return out;
+            }
+
+        template <typename Range, typename OutputIterator>
+        OutputIterator find_all ( Range &r, OutputIterator out, match_mode_type mode = match_overlapping ) const {
+            return this->find_all (boost::begin(r), boost::end(r), out, mode);
+            }
+
+        /// \fn count ( corpusIter corpus_first, corpusIter corpus_last, match_mode_type mode )
+        /// \brief Counts the occurrences of the pattern in the corpus
+        ///
+        /// \param corpus_first The start of the data to search (Random Access Iterator)
+        /// \param corpus_last  One past the end of the data to search
+        /// \param mode         Whether or not to count overlapping matches
+        ///
+        template <typename corpusIter>
+        std::size_t count ( corpusIter corpus_first, corpusIter corpus_last, match_mode_type mode = match_overlapping ) const {
+            return detail::count_matches ( *this, pat_first, corpus_first, corpus_last, mode, detail::use_simd_search<corpusIter> ());
+            }
+
+        template <typename Range>
+        std::size_t count ( Range &r, match_mode_type mode = match_overlapping ) const {
+            return this->count (boost::begin(r), boost::end(r), mode);
+            }
+
+    //  The length of the pattern that was passed into the constructor
+        std::size_t pattern_length () const { return k_pattern_length; }
+
+    private:
+/// \cond DOXYGEN_HIDE
+        patIter pat_first, pat_last;
+        const difference_type k_pattern_length;
+        difference_type ell_;       // the last position of the left part (may be -1)
+        difference_type period_;    // the shift after a match
+        bool periodic_;
+
+    //  Returns the start (minus one) of the lexicographically maximal suffix
+    //  of the pattern, and its period. If 'reversed', the ordering of the
+    //  alphabet is reversed.
+        difference_type max_suffix ( bool reversed, difference_type &period ) const {
+            difference_type ms = -1;    // the start of the suffix, minus one
+            difference_type j  = 0;     // the start of the candidate suffix, minus one
+            difference_type k  = 1;     // the offset being compared
+            period = 1;
+            while ( j + k < k_pattern_length ) {
+                const typename std::iterator_traits<patIter>::value_type &a = pat_first [ j + k ];
+                const typename std::iterator_traits<patIter>::value_type &b = pat_first [ ms + k ];
+                if ( reversed ? b < a : a < b ) {
+                //  The candidate is smaller; skip over it
+                    j += k;
+                    k = 1;
+                    period = j - ms;
+                    }
+                else if ( a == b ) {
+                //  Carry on matching, a period at a time
+                    if ( k != period )
+                        ++k;
+                    else {
+                        j += period;
+                        k = 1;
+                        }
+                    }
+                else {
+                //  The candidate is bigger; it becomes the new maximal suffix
+                    ms = j;
+                    j = ms + 1;
+                    k = period = 1;
+                    }
+                }
+            return ms;
+            }
+
+    //  Returns the first match at or after 'j', or -1 if there isn't one.
+    //  'memory' is the last position of the left part that is already known
+    //  to match, or -1.
+        template <typename corpusIter>
+        difference_type find_from ( corpusIter corpus_first, difference_type k_corpus_length,
+                                    difference_type j, difference_type &memory ) const {
+            const difference_type last_match = k_corpus_length - k_pattern_length;
+            while ( j <= last_match ) {
+            //  Match the right part, left to right
+                difference_type i = std::max ( ell_, memory ) + 1;
+                while ( i < k_pattern_length && pat_first [ i ] == corpus_first [ j + i ] )
+                    ++i;
+                if ( i < k_pattern_length ) {
+                    j += i - ell_;
+                    memory = -1;
+                    continue;
+                    }
+
+            //  Then the left part, right to left
+                i = ell_;
+                while ( i > memory && pat_first [ i ] == corpus_first [ j + i ] )
+                    --i;
+                if ( i <= memory )
+                    return j;
+
+                j += period_;
+                memory = periodic_ ? k_pattern_length - period_ - 1 : -1;
+                }
+            return -1;
+            }
+/// \endcond
+        };
+
+
+/*  Two ranges as inputs gives us four possibilities; with 2,3,3,4 parameters
+    Use a bit of TMP to disambiguate the 3-argument templates */
+
+/// \fn two_way_search ( corpusIter corpus_first, corpusIter corpus_last,
+///       patIter pat_first, patIter pat_last )
+/// \brief Searches the corpus for the pattern.
+///
+/// \param corpus_first The start of the data to search (Random Access Iterator)
+/// \param corpus_last  One past the end of the data to search
+/// \param pat_first    The start of the pattern to search for (Random Access Iterator)
+/// \param pat_last     One past the end of the data to search for
+///
+    template <typename patIter, typename corpusIter>
+    corpusIter two_way_search (
+                  corpusIter corpus_first, corpusIter corpus_last,
+                  patIter pat_first, patIter pat_last )
+    {
+        two_way<patIter> tw ( pat_first, pat_last );
+        return tw ( corpus_first, corpus_last );
+    }
+
+    template <typename PatternRange, typename corpusIter>
+    corpusIter two_way_search (
+        corpusIter corpus_first, corpusIter corpus_last, const PatternRange &pattern )
+    {
+        typedef typename boost::range_iterator<const PatternRange>::type pattern_iterator;
+        two_way<pattern_iterator> tw ( boost::begin(pattern), boost::end (pattern));
+        return tw ( corpus_first, corpus_last );
+    }
+
+    template <typename patIter, typename CorpusRange>
+    typename boost::lazy_disable_if_c<
+        boost::is_same<CorpusRange, patIter>::value, typename boost::range_iterator<CorpusRange> >
+    ::type
+    two_way_search ( CorpusRange &corpus, patIter pat_first, patIter pat_last )
+    {
+        two_way<patIter> tw ( pat_first, pat_last );
+        return tw (boost::begin (corpus), boost::end (corpus));
+    }
+
+    template <typename PatternRange, typename CorpusRange>
+    typename boost::range_iterator<CorpusRange>::type
+    two_way_search ( CorpusRange &corpus, const PatternRange &pattern )
+    {
+        typedef typename boost::range_iterator<const PatternRange>::type pattern_iterator;
+        two_way<pattern_iterator> tw ( boost::begin(pattern), boost::end (pattern));
+        return tw (boost::begin (corpus), boost::end (corpus));
+    }
+
+
+    //  Creator functions -- take a pattern range, return an object
+    template <typename Range>
+    boost::algorithm::two_way<typename boost::range_iterator<const Range>::type>
+    make_two_way ( const Range &r ) {
+        return boost::algorithm::two_way
+            <typename boost::range_iterator<const Range>::type> (boost::begin(r), boost::end(r));
+        }
+
+    template <typename Range>
+    boost::algorithm::two_way<typename boost::range_iterator<Range>::type>
+    make_two_way ( Range &r ) {
+        return boost::algorithm::two_way
+            <typename boost::range_iterator<Range>::type> (boost::begin(r), boost::end(r));
+        }
+
+}}
+
+#endif  //  BOOST_ALGORITHM_TWO_WAY_SEARCH_HPP
@@ -0,0 +1,366 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+#ifndef BOOST_ALGORITHM_WU_MANBER_SEARCH_HPP
+#define BOOST_ALGORITHM_WU_MANBER_SEARCH_HPP
+
+#include <cstddef>      // for std::size_t
+#include <vector>
+#include <utility>      // for std::pair
+#include <iterator>     // for std::iterator_traits
+#include <algorithm>    // for std::min, std::equal, std::sort
+#include <stdexcept>    // for std::length_error
+
+#include <boost/assert.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/throw_exception.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/functional/hash.hpp>
+
+#include <boost/range/begin.hpp>
+#include <boost/range/end.hpp>
+#include <boost/range/iterator.hpp>
+#include <boost/range/value_type.hpp>
+
+#include <boost/type_traits/is_same.hpp>
+
+namespace boost { namespace algorithm {
+
+/*
+    A templated version of the Wu-Manber multiple pattern searching algorithm.
+
+    This is Horspool's algorithm, generalised to a set of patterns. The
+    searcher slides a window as long as the shortest pattern (m) along the
+    corpus, and looks at the block of the last B elements in the window. The
+    shift table, indexed by a hash of the block, says how far the window can
+    move before that block could line up with the end of the first m elements
+    of some pattern. When the shift is zero, the patterns whose block hashes
+    to the same value are candidates; a hash of the first B elements of each
+    candidate weeds out most of them before the full comparison.
+
+    Most windows are skipped in one step, so the search gets faster as the
+    shortest pattern gets longer, and the tables are small compared with an
+    automaton: one byte per hash bucket for the shifts, and a few words per
+    pattern for the candidates.
+
+    The patterns are numbered by their position in the sequence passed to the
+    constructor, as for aho_corasick, and are copied into the searcher.
+
+    Requirements:
+        * Random access iterators
+        * The pattern iterators and the corpus iterators must
+            "point to" the same underlying type, which must be
+            Equality Comparable and hashable (with boost::hash).
+
+    Empty patterns are ignored; if the same pattern occurs more than once,
+    matches report the first id, as with aho_corasick.
+
+Reference:
+    S. Wu and U. Manber, "A fast algorithm for multi-pattern searching",
+    Technical Report TR-94-17, University of Arizona, 1994
+*/
+
+    template <typename patIter>
+    class wu_manber {
+        typedef typename std::iterator_traits<patIter>::value_type value_type;
+        typedef typename std::iterator_traits<patIter>::difference_type difference_type;
+
+    //  A pattern that might end at the current block
+        struct candidate {
+            boost::uint32_t prefix_hash;    // hash of the first block of the pattern
+            boost::uint32_t id;
+            };
+
+    public:
+    //  The pattern id reported when nothing was found
+        static const std::size_t npos = static_cast<std::size_t> ( -1 );
+
+        template <typename PatternsIter>
+        wu_manber ( PatternsIter first, PatternsIter last ) : min_length_ ( 0 ), block_ ( 1 ), mask_ ( 0 ) {
+            for ( ; first != last; ++first ) {
+                patIter pFirst = boost::begin ( *first );
+                patIter pLast  = boost::end   ( *first );
+                offsets_.push_back ( elements_.size ());
+                elements_.insert ( elements_.end (), pFirst, pLast );
+                const std::size_t len = std::distance ( pFirst, pLast );
+                if ( len > 0 && ( min_length_ == 0 || len < min_length_ ))
+                    min_length_ = len;
+                }
+            offsets_.push_back ( elements_.size ());
+            if ( min_length_ > 0 )
+                build ();
+            }
+
+        ~wu_manber () {}
+
+    //  The number of patterns the searcher was built with
+        std::size_t size () const { return offsets_.size () - 1; }
+
+    //  The length of the shortest (non-empty) pattern, which is the size of the window
+        std::size_t min_length () const { return min_length_; }
+
+    //  The number of elements hashed for each lookup in the shift table
+        std::size_t block_size () const { return block_; }
+
+        /// \fn operator ( corpusIter corpus_first, corpusIter corpus_last )
+        /// \brief Searches the corpus for the patterns that were passed into the constructor
+        ///
+        /// \param corpus_first The start of the data to search (Random Access Iterator)
+        /// \param corpus_last  One past the end of the data to search
+        ///
+        /// \return A pair: the start of the match that starts first in the corpus (the
+        ///         one with the lowest id, if several start there), and the id of its
+        ///         pattern. If nothing matches, returns (corpus_last, npos).
+        ///
+        template <typename corpusIter>
+        std::pair<corpusIter, std::size_t>
+        operator () ( corpusIter corpus_first, corpusIter corpus_last ) const {
+            BOOST_STATIC_ASSERT (( boost::is_same<value_type,
+                typename std::iterator_traits<corpusIter>::value_type>::value ));
+
+            std::pair<corpusIter, std::size_t> retVal ( corpus_last, npos );
+            do_search ( corpus_first, corpus_last, first_match_sink<corpusIter> ( retVal ));
+            return retVal;
+            }
+
+        template <typename Range>
+        std::pair<typename boost::range_iterator<Range>::type, std::size_t>
+        operator () ( Range &r ) const {
+            return (*this) (boost::begin(r), boost::end(r));
+            }
+
+        /// \fn find_all ( corpusIter corpus_first, corpusIter corpus_last, OutputIterator out )
+        /// \brief Finds every (possibly overlapping) occurrence of every pattern in the corpus
+        ///
+        /// \param corpus_first The start of the data to search (Random Access Iterator)
+        /// \param corpus_last  One past the end of the data to search
+        /// \param out          Receives a std::pair<corpusIter, std::size_t> of the start
+        ///                     of the match and the pattern id for each match, ordered by
+        ///                     where the matches start (lowest id first among equal starts).
+        ///
+        template <typename corpusIter, typename OutputIterator>
+        OutputIterator find_all ( corpusIter corpus_first, corpusIter corpus_last, OutputIterator out ) const {
+            BOOST_STATIC_ASSERT (( boost::is_same<value_type,
+                typename std::iterator_traits<corpusIter>::value_type>::value ));
+
+            return do_search ( corpus_first, corpus_last, all_matches_sink<corpusIter, OutputIterator> ( out )).out;
+            }
+
+        template <typename Range, typename OutputIterator>
+        OutputIterator find_all ( Range &r, OutputIterator out ) const {
+            return this->find_all (boost::begin(r), boost::end(r), out);
+            }
+
+    private:
+/// \cond DOXYGEN_HIDE
+        std::vector<value_type> elements_;          // the patterns, one after another
+        std::vector<std::size_t> offsets_;          // where each pattern starts in elements_, plus the end
+        std::size_t min_length_;
+        std::size_t block_;
+        std::size_t mask_;                          // table size - 1
+        std::vector<boost::uint8_t> shift_;         // block hash -> shift, capped at 255
+        std::vector<boost::uint32_t> bucket_start_; // block hash -> first entry of candidates_
+        std::vector<candidate> candidates_;         // grouped by the hash of their last block
+
+        template <typename Iter>
+        std::size_t hash_block ( Iter first ) const {
+            boost::hash<value_type> hasher;
+            std::size_t h = 0;
+            for ( std::size_t i = 0; i < block_; ++i )
+                h = ( h << 5 ) ^ hasher ( first [ i ] );
+            return h;
+            }
+
+        bool same_pattern ( std::size_t a, std::size_t b ) const {
+            return offsets_ [ a + 1 ] - offsets_ [ a ] == offsets_ [ b + 1 ] - offsets_ [ b ]
+                && std::equal ( elements_.begin () + offsets_ [ a ], elements_.begin () + offsets_ [ a + 1 ],
+                                elements_.begin () + offsets_ [ b ] );
+            }
+
+    //  Which patterns repeat one with a lower id? The elements need not be
+    //  ordered, so the patterns are grouped by a hash of the whole pattern.
+        std::vector<bool> find_repeats () const {
+            const std::size_t k_count = size ();
+            std::vector<std::pair<std::size_t, std::size_t> > keyed;  // (hash, id)
+            keyed.reserve ( k_count );
+            for ( std::size_t id = 0; id < k_count; ++id )
+                keyed.push_back ( std::make_pair ( boost::hash_range (
+                    elements_.begin () + offsets_ [ id ], elements_.begin () + offsets_ [ id + 1 ] ), id ));
+            std::sort ( keyed.begin (), keyed.end ());
+
+            std::vector<bool> retVal ( k_count, false );
+            for ( std::size_t i = 0; i < k_count; ) {
+                std::size_t j = i + 1;
+                while ( j < k_count && keyed [ j ].first == keyed [ i ].first )
+                    ++j;
+                for ( std::size_t a = i + 1; a < j; ++a )
+                    for ( std::size_t b = i; b < a; ++b )
+                        if ( !retVal [ keyed [ b ].second ] && same_pattern ( keyed [ a ].second, keyed [ b ].second )) {
+                            retVal [ keyed [ a ].second ] = true;
+                            break;
+                            }
+                i = j;
+                }
+            return retVal;
+            }
+
+        void build () {
+            const std::size_t k_count = size ();
+            if ( k_count > 0xFFFFFFFFU || elements_.size () > 0xFFFFFFFFU )
+                boost::throw_exception ( std::length_error ( "boost::algorithm: too many patterns for wu_manber" ));
+
+        //  Longer blocks make the shifts more selective for big dictionaries
+            block_ = std::min<std::size_t> ( min_length_, k_count > 256 ? 3 : 2 );
+            std::size_t table_size = 256;
+            while ( table_size < 4 * k_count * ( min_length_ - block_ + 1 ) && table_size < ( 1U << 20 ))
+                table_size *= 2;
+            mask_ = table_size - 1;
+
+        //  Only the first copy of a repeated pattern goes into the tables
+            const std::vector<bool> repeats = find_repeats ();
+
+            const std::size_t k_default_shift = std::min<std::size_t> ( min_length_ - block_ + 1, 0xFF );
+            shift_.assign ( table_size, static_cast<boost::uint8_t> ( k_default_shift ));
+
+        //  Count the candidates in each bucket, two places along, so that after
+        //  the partial sums bucket_start_ [ h + 1 ] is the start of bucket h
+            bucket_start_.assign ( table_size + 2, 0 );
+            for ( std::size_t id = 0; id < k_count; ++id ) {
+                if ( offsets_ [ id ] == offsets_ [ id + 1 ] || repeats [ id ] )
+                    continue;
+                const value_type *p = &elements_ [ offsets_ [ id ]];
+                for ( std::size_t j = block_ - 1; j < min_length_; ++j ) {
+                    const std::size_t h = hash_block ( p + j + 1 - block_ ) & mask_;
+                    const std::size_t s = min_length_ - 1 - j;
+                    if ( s < shift_ [ h ] )
+                        shift_ [ h ] = static_cast<boost::uint8_t> ( s );
+                    }
+                ++bucket_start_ [ ( hash_block ( p + min_length_ - block_ ) & mask_ ) + 2 ];
+                }
+            for ( std::size_t h = 2; h < table_size + 2; ++h )
+                bucket_start_ [ h ] += bucket_start_ [ h - 1 ];
+
+        //  Lay the candidates out bucket by bucket, in order of id; moving each
+        //  bucket's start along leaves it at the start of the next bucket
+            candidates_.resize ( bucket_start_ [ table_size + 1 ] );
+            for ( std::size_t id = 0; id < k_count; ++id ) {
+                if ( offsets_ [ id ] == offsets_ [ id + 1 ] || repeats [ id ] )
+                    continue;
+                const value_type *p = &elements_ [ offsets_ [ id ]];
+                candidate &c = candidates_ [ bucket_start_ [ ( hash_block ( p + min_length_ - block_ ) & mask_ ) + 1 ]++ ];
+                c.prefix_hash = static_cast<boost::uint32_t> ( hash_block ( p ));
+                c.id = static_cast<boost::uint32_t> ( id );
+                }
+            }
+
+    //  Where the matches go; the search stops when the sink says so
+        template <typename corpusIter>
+        struct first_match_sink {
+            first_match_sink ( std::pair<corpusIter, std::size_t> &r ) : result ( r ) {}
+            bool operator () ( corpusIter start, std::size_t id ) {
+                result = std::make_pair ( start, id );
+                return false;
+                }
+            std::pair<corpusIter, std::size_t> &result;
+            };
+
+        template <typename corpusIter, typename OutputIterator>
+        struct all_matches_sink {
+            all_matches_sink ( OutputIterator o ) : out ( o ) {}
+            bool operator () ( corpusIter start, std::size_t id ) {
+                *out++ = std::make_pair ( start, id );
+                return true;
+                }
+            OutputIterator out;
+            };
+
+        template <typename corpusIter, typename Sink>
+        Sink do_search ( corpusIter corpus_first, corpusIter corpus_last, Sink sink ) const {
+            if ( min_length_ == 0 )
+                return sink;
+            const difference_type k_corpus_length = std::distance ( corpus_first, corpus_last );
+            const difference_type k_window = min_length_;
+            const difference_type k_block = block_;
+
+        //  'pos' is the index of the last element of the window
+            for ( difference_type pos = k_window - 1; pos < k_corpus_length; ) {
+                const std::size_t h = hash_block ( corpus_first + ( pos + 1 - k_block )) & mask_;
+                const difference_type shift = shift_ [ h ];
+                if ( shift > 0 ) {
+                    pos += shift;
+                    continue;
+                    }
+
+                const corpusIter start = corpus_first + ( pos + 1 - k_window );
+                const boost::uint32_t k_prefix = static_cast<boost::uint32_t> ( hash_block ( start ));
+                for ( std::size_t i = bucket_start_ [ h ]; i < bucket_start_ [ h + 1 ]; ++i ) {
+                    const candidate &c = candidates_ [ i ];
+                    if ( c.prefix_hash != k_prefix )
+                        continue;
+                    const difference_type len = offsets_ [ c.id + 1 ] - offsets_ [ c.id ];
+                    if ( len > k_corpus_length - ( pos + 1 - k_window ))
+                        continue;
+                    if ( std::equal ( elements_.begin () + offsets_ [ c.id ], elements_.begin () + offsets_ [ c.id + 1 ], start ))
+                        if ( !sink ( start, c.id ))
+                            return sink;
+                    }
+                ++pos;
+                }
+            return sink;
+            }
+/// \endcond
+        };
+
+    template <typename patIter>
+    const std::size_t wu_manber<patIter>::npos;
+
+
+/// \fn wu_manber_search ( corpusIter corpus_first, corpusIter corpus_last,
+///       PatternsIter pats_first, PatternsIter pats_last )
+/// \brief Searches the corpus for any of the patterns.
+///
+/// \param corpus_first The start of the data to search (Random Access Iterator)
+/// \param corpus_last  One past the end of the data to search
+/// \param pats_first   The start of the sequence of patterns to search for
+/// \param pats_last    One past the end of the sequence of patterns
+///
+    template <typename PatternsIter, typename corpusIter>
+    std::pair<corpusIter, std::size_t> wu_manber_search (
+                  corpusIter corpus_first, corpusIter corpus_last,
+                  PatternsIter pats_first, PatternsIter pats_last )
+    {
+        typedef typename boost::range_iterator<const typename
+            std::iterator_traits<PatternsIter>::value_type>::type pattern_iterator;
+        wu_manber<pattern_iterator> wm ( pats_first, pats_last );
+        return wm ( corpus_first, corpus_last );
+    }
+
+    template <typename PatternsRange, typename CorpusRange>
+    std::pair<typename boost::range_iterator<CorpusRange>::type, std::size_t>
+    wu_manber_search ( CorpusRange &corpus, const PatternsRange &patterns )
+    {
+        typedef typename boost::range_iterator<const typename
+            boost::range_value<PatternsRange>::type>::type pattern_iterator;
+        wu_manber<pattern_iterator> wm ( boost::begin(patterns), boost::end (patterns));
+        return wm (boost::begin (corpus), boost::end (corpus));
+    }
+
+
+    //  Creator function -- take a range of patterns, return an object
+    template <typename PatternsRange>
+    boost::algorithm::wu_manber<typename boost::range_iterator<const typename
+        boost::range_value<PatternsRange>::type>::type>
+    make_wu_manber ( const PatternsRange &r ) {
+        return boost::algorithm::wu_manber<typename boost::range_iterator<const typename
+            boost::range_value<PatternsRange>::type>::type> (boost::begin(r), boost::end(r));
+        }
+
+}}
+
+#endif  //  BOOST_ALGORITHM_WU_MANBER_SEARCH_HPP
@@ -72,6 +72,9 @@ namespace boost {
                 #endif
             }
 
+            //! The locale used for comparison
+            const std::locale& getloc() const { return m_Loc; }
+
         private:
             std::locale m_Loc;
         };
@@ -0,0 +1,230 @@
+//  Boost string_algo library count.hpp header file  ---------------------------//
+
+//  Copyright Pavol Droba 2002-2003.
+//
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+//  See http://www.boost.org/ for updates, documentation, and revision history.
+
+#ifndef BOOST_STRING_COUNT_HPP
+#define BOOST_STRING_COUNT_HPP
+
+#include <boost/algorithm/string/config.hpp>
+
+#include <cstddef>
+#include <iterator>
+#include <locale>
+
+#include <boost/range/iterator_range_core.hpp>
+#include <boost/range/begin.hpp>
+#include <boost/range/end.hpp>
+#include <boost/range/iterator.hpp>
+#include <boost/range/as_literal.hpp>
+#include <boost/range/empty.hpp>
+#include <boost/next_prior.hpp>
+#include <boost/mpl/bool.hpp>
+#include <boost/type_traits/is_same.hpp>
+#include <boost/type_traits/is_convertible.hpp>
+
+#include <boost/algorithm/string/finder.hpp>
+#include <boost/algorithm/string/compare.hpp>
+#include <boost/algorithm/searching/boyer_moore_horspool.hpp>
+#include <boost/algorithm/searching/iboyer_moore_horspool.hpp>
+#include <boost/algorithm/searching/detail/case_fold.hpp>
+#include <boost/algorithm/searching/match_mode.hpp>
+
+/*! \file
+    Defines the count_all algorithm, which counts the occurrences of a
+    substring in the input without storing them.
+*/
+
+namespace boost {
+    namespace algorithm {
+
+        namespace detail {
+
+//  count all -----------------------------------------------//
+
+            // Can the input be counted with a Boyer-Moore-Horspool searcher?
+            // Both sequences must be random access, and hold the same
+            // characters, char or wchar_t
+            template<typename InputIteratorT, typename SearchIteratorT>
+            struct count_use_searcher : public mpl::bool_<
+                is_convertible<
+                    typename std::iterator_traits<InputIteratorT>::iterator_category,
+                    std::random_access_iterator_tag>::value &&
+                is_convertible<
+                    typename std::iterator_traits<SearchIteratorT>::iterator_category,
+                    std::random_access_iterator_tag>::value &&
+                is_same<
+                    typename std::iterator_traits<InputIteratorT>::value_type,
+                    typename std::iterator_traits<SearchIteratorT>::value_type>::value &&
+                ( is_same<typename std::iterator_traits<SearchIteratorT>::value_type, char>::value ||
+                  is_same<typename std::iterator_traits<SearchIteratorT>::value_type, wchar_t>::value ) > {};
+
+            // Generic version: restart a first_finder after each match
+            template<typename InputIteratorT, typename SearchIteratorT, typename PredicateT, typename UseSearcherT>
+            inline std::size_t count_all_impl(
+                InputIteratorT Begin, InputIteratorT End,
+                SearchIteratorT SearchBegin, SearchIteratorT SearchEnd,
+                PredicateT Comp, match_mode_type Mode, UseSearcherT )
+            {
+                const first_finderF<SearchIteratorT, PredicateT> Finder( SearchBegin, SearchEnd, Comp );
+                std::size_t Count=0;
+                for( iterator_range<InputIteratorT> M=Finder( Begin, End ); !M.empty(); M=Finder( Begin, End ) )
+                {
+                    ++Count;
+                    Begin = Mode==match_overlapping ? ::boost::next( M.begin() ) : M.end();
+                }
+                return Count;
+            }
+
+            template<typename InputIteratorT, typename SearchIteratorT>
+            inline std::size_t count_all_impl(
+                InputIteratorT Begin, InputIteratorT End,
+                SearchIteratorT SearchBegin, SearchIteratorT SearchEnd,
+                is_equal, match_mode_type Mode, mpl::true_ )
+            {
+                const ::boost::algorithm::boyer_moore_horspool<SearchIteratorT> Searcher( SearchBegin, SearchEnd );
+                return Searcher.count( Begin, End, Mode );
+            }
+
+            // Case insensitive char patterns up to this long are folded into
+            // a buffer on the stack; longer ones are folded onto the heap
+            const std::size_t icount_buffer_size = 64;
+
+            template<typename InputIteratorT, typename SearchIteratorT>
+            inline std::size_t icount_all_impl(
+                InputIteratorT Begin, InputIteratorT End,
+                SearchIteratorT SearchBegin, SearchIteratorT SearchEnd,
+                const std::locale& Loc, match_mode_type Mode, mpl::false_ )
+            {
+                const ::boost::algorithm::iboyer_moore_horspool<SearchIteratorT> Searcher( SearchBegin, SearchEnd, Loc );
+                return Searcher.count( Begin, End, Mode );
+            }
+
+            // Short char patterns: nothing is allocated. The byte skip table
+            // of a pattern this short is an array inside the searcher.
+            template<typename InputIteratorT, typename SearchIteratorT>
+            inline std::size_t icount_all_impl(
+                InputIteratorT Begin, InputIteratorT End,
+                SearchIteratorT SearchBegin, SearchIteratorT SearchEnd,
+                const std::locale& Loc, match_mode_type Mode, mpl::true_ )
+            {
+                if( static_cast<std::size_t>( SearchEnd-SearchBegin ) > icount_buffer_size )
+                    return icount_all_impl( Begin, End, SearchBegin, SearchEnd, Loc, Mode, mpl::false_() );
+
+                typedef case_folder<char> folder_type;
+                typedef case_fold_iterator<InputIteratorT, folder_type> fold_iterator;
+                const folder_type Folder( Loc );
+                char Buffer[icount_buffer_size];
+                char* BufferEnd=Buffer;
+                for( ; SearchBegin!=SearchEnd; ++SearchBegin )
+                    *BufferEnd++ = Folder( *SearchBegin );
+
+                const ::boost::algorithm::boyer_moore_horspool<const char*> Searcher( Buffer, BufferEnd );
+                return Searcher.count( fold_iterator( Begin, Folder ), fold_iterator( End, Folder ), Mode );
+            }
+
+            template<typename InputIteratorT, typename SearchIteratorT>
+            inline std::size_t count_all_impl(
+                InputIteratorT Begin, InputIteratorT End,
+                SearchIteratorT SearchBegin, SearchIteratorT SearchEnd,
+                const is_iequal& Comp, match_mode_type Mode, mpl::true_ )
+            {
+                return icount_all_impl( Begin, End, SearchBegin, SearchEnd, Comp.getloc(), Mode,
+                    mpl::bool_<is_same<typename std::iterator_traits<SearchIteratorT>::value_type, char>::value>() );
+            }
+
+        } // namespace detail
+
+        //! Count all algorithm
+        /*!
+            Count the occurrences of the substring in the input. The matches
+            are not stored; when both are random access sequences of \c char
+            or \c wchar_t, they are counted with a Boyer-Moore-Horspool searcher.
+            Its skip table is allocated on the heap when the substring holds
+            \c wchar_t, or 255 or more \c char; otherwise nothing is allocated.
+
+            \param Input A string which will be searched.
+            \param Search A substring to be searched for.
+            \param Mode Whether overlapping occurrences are counted. By default,
+                they are not, as with \c find_all.
+            \return The number of occurrences. An empty substring occurs nowhere.
+
+            \note This function provides the strong exception-safety guarantee
+        */
+        template<typename Range1T, typename Range2T>
+        inline std::size_t count_all(
+            const Range1T& Input,
+            const Range2T& Search,
+            match_mode_type Mode=match_non_overlapping)
+        {
+            iterator_range<BOOST_STRING_TYPENAME range_const_iterator<Range1T>::type> lit_input(::boost::as_literal(Input));
+            iterator_range<BOOST_STRING_TYPENAME range_const_iterator<Range2T>::type> lit_search(::boost::as_literal(Search));
+            if( ::boost::empty(lit_search) )
+                return 0;
+
+            return ::boost::algorithm::detail::count_all_impl(
+                ::boost::begin(lit_input), ::boost::end(lit_input),
+                ::boost::begin(lit_search), ::boost::end(lit_search),
+                is_equal(), Mode,
+                BOOST_STRING_TYPENAME ::boost::algorithm::detail::count_use_searcher<
+                    BOOST_STRING_TYPENAME range_const_iterator<Range1T>::type,
+                    BOOST_STRING_TYPENAME range_const_iterator<Range2T>::type>::type() );
+        }
+
+        //! Count all algorithm ( case insensitive )
+        /*!
+            Count the occurrences of the substring in the input.
+            Searching is case insensitive.
+
+            When both are random access sequences of \c char or \c wchar_t,
+            the substring is folded to upper case and counted with a
+            Boyer-Moore-Horspool searcher over the folded input. A \c char
+            substring of up to 64 characters is folded into a buffer on the
+            stack, and nothing is allocated. A longer one, or a \c wchar_t
+            one, is copied to the heap, and so is the searcher's skip table
+            for \c wchar_t.
+
+            \param Input A string which will be searched.
+            \param Search A substring to be searched for.
+            \param Mode Whether overlapping occurrences are counted.
+            \param Loc A locale used for case insensitive comparison
+            \return The number of occurrences.
+
+            \note This function provides the strong exception-safety guarantee
+        */
+        template<typename Range1T, typename Range2T>
+        inline std::size_t icount_all(
+            const Range1T& Input,
+            const Range2T& Search,
+            match_mode_type Mode=match_non_overlapping,
+            const std::locale& Loc=std::locale())
+        {
+            iterator_range<BOOST_STRING_TYPENAME range_const_iterator<Range1T>::type> lit_input(::boost::as_literal(Input));
+            iterator_range<BOOST_STRING_TYPENAME range_const_iterator<Range2T>::type> lit_search(::boost::as_literal(Search));
+            if( ::boost::empty(lit_search) )
+                return 0;
+
+            return ::boost::algorithm::detail::count_all_impl(
+                ::boost::begin(lit_input), ::boost::end(lit_input),
+                ::boost::begin(lit_search), ::boost::end(lit_search),
+                is_iequal(Loc), Mode,
+                BOOST_STRING_TYPENAME ::boost::algorithm::detail::count_use_searcher<
+                    BOOST_STRING_TYPENAME range_const_iterator<Range1T>::type,
+                    BOOST_STRING_TYPENAME range_const_iterator<Range2T>::type>::type() );
+        }
+
+    } // namespace algorithm
+
+    // pull names to the boost namespace
+    using algorithm::count_all;
+    using algorithm::icount_all;
+
+} // namespace boost
+
+
+#endif  // BOOST_STRING_COUNT_HPP
@@ -21,6 +21,17 @@
 #include <boost/range/empty.hpp>
 #include <boost/range/as_literal.hpp>
 
+#include <boost/mpl/bool.hpp>
+#include <boost/type_traits/is_same.hpp>
+#include <boost/type_traits/is_convertible.hpp>
+
+#include <boost/algorithm/string/compare.hpp>
+#include <boost/algorithm/searching/iboyer_moore_horspool.hpp>
+#include <boost/algorithm/searching/reverse_search.hpp>
+
+#include <iterator>
+#include <locale>
+
 namespace boost {
     namespace algorithm {
         namespace detail {
@@ -28,6 +39,45 @@ namespace boost {
 
 //  find first functor -----------------------------------------------//
 
+            // find a subsequence in the sequence, one position at a time
+            template<typename ForwardIteratorT, typename SearchIteratorT, typename PredicateT>
+            inline iterator_range<ForwardIteratorT>
+            find_first_naive(
+                ForwardIteratorT Begin,
+                ForwardIteratorT End,
+                const iterator_range<SearchIteratorT>& Search,
+                const PredicateT& Comp )
+            {
+                typedef iterator_range<ForwardIteratorT> result_type;
+                typedef ForwardIteratorT input_iterator_type;
+
+                // Outer loop
+                for(input_iterator_type OuterIt=Begin;
+                    OuterIt!=End;
+                    ++OuterIt)
+                {
+                    // Sanity check
+                    if( boost::empty(Search) )
+                        return result_type( End, End );
+
+                    input_iterator_type InnerIt=OuterIt;
+                    SearchIteratorT SubstrIt=Search.begin();
+                    for(;
+                        InnerIt!=End && SubstrIt!=Search.end();
+                        ++InnerIt,++SubstrIt)
+                    {
+                        if( !( Comp(*InnerIt,*SubstrIt) ) )
+                            break;
+                    }
+
+                    // Substring matching succeeded
+                    if ( SubstrIt==Search.end() )
+                        return result_type( OuterIt, InnerIt );
+                }
+
+                return result_type( End, End );
+            }
+
             // find a subsequence in the sequence ( functor )
             /*
                 Returns a pair <begin,end> marking the subsequence in the sequence.
@@ -55,47 +105,199 @@ namespace boost {
                     ForwardIteratorT Begin,
                     ForwardIteratorT End ) const
                 {
-                    typedef iterator_range<ForwardIteratorT> result_type;
-                    typedef ForwardIteratorT input_iterator_type;
+                    return find_first_naive( Begin, End, m_Search, m_Comp );
+                }
 
-                    // Outer loop
-                    for(input_iterator_type OuterIt=Begin;
-                        OuterIt!=End;
-                        ++OuterIt)
-                    {
-                        // Sanity check
-                        if( boost::empty(m_Search) )
-                            return result_type( End, End );
+            private:
+                iterator_range<search_iterator_type> m_Search;
+                PredicateT m_Comp;
+            };
 
-                        input_iterator_type InnerIt=OuterIt;
-                        search_iterator_type SubstrIt=m_Search.begin();
-                        for(;
-                            InnerIt!=End && SubstrIt!=m_Search.end();
-                            ++InnerIt,++SubstrIt)
-                        {
-                            if( !( m_Comp(*InnerIt,*SubstrIt) ) )
-                                break;
-                        }
+            // Holds a case insensitive Boyer-Moore-Horspool searcher, when
+            // the search string can be used to build one
+            template<
+                typename SearchIteratorT,
+                bool UseSearcherT=
+                    is_convertible<
+                        typename std::iterator_traits<SearchIteratorT>::iterator_category,
+                        std::random_access_iterator_tag>::value &&
+                    ( is_same<typename std::iterator_traits<SearchIteratorT>::value_type, char>::value ||
+                      is_same<typename std::iterator_traits<SearchIteratorT>::value_type, wchar_t>::value ) >
+            struct ifirst_searcher
+            {
+                ifirst_searcher( SearchIteratorT, SearchIteratorT, const std::locale& ) {}
 
-                        // Substring matching succeeded
-                        if ( SubstrIt==m_Search.end() )
-                            return result_type( OuterIt, InnerIt );
-                    }
+                template< typename ForwardIteratorT >
+                struct accepts : public mpl::false_ {};
 
-                    return result_type( End, End );
+                template< typename ForwardIteratorT >
+                ForwardIteratorT operator()( ForwardIteratorT, ForwardIteratorT End ) const { return End; }
+                std::size_t pattern_length() const { return 0; }
+            };
+
+            template<typename SearchIteratorT>
+            struct ifirst_searcher<SearchIteratorT, true> :
+                public ::boost::algorithm::iboyer_moore_horspool<SearchIteratorT>
+            {
+                ifirst_searcher( SearchIteratorT SearchBegin, SearchIteratorT SearchEnd, const std::locale& Loc ) :
+                    ::boost::algorithm::iboyer_moore_horspool<SearchIteratorT>( SearchBegin, SearchEnd, Loc ) {}
+
+                // The corpus must be random access, and hold the same characters
+                template< typename ForwardIteratorT >
+                struct accepts : public mpl::bool_<
+                    is_convertible<
+                        typename std::iterator_traits<ForwardIteratorT>::iterator_category,
+                        std::random_access_iterator_tag>::value &&
+                    is_same<
+                        typename std::iterator_traits<ForwardIteratorT>::value_type,
+                        typename std::iterator_traits<SearchIteratorT>::value_type>::value > {};
+            };
+
+            // find a subsequence in the sequence, ignoring case ( functor )
+            /*
+                Uses a case insensitive Boyer-Moore-Horspool searcher when both
+                the search string and the input are random access sequences of
+                char or wchar_t, and compares one position at a time otherwise.
+                The searcher is built by each call that uses it, so that the
+                finder stays cheap to construct and to copy.
+            */
+            template<typename SearchIteratorT>
+            struct first_finderF<SearchIteratorT, is_iequal>
+            {
+                typedef SearchIteratorT search_iterator_type;
+
+                // Construction
+                template< typename SearchT >
+                first_finderF( const SearchT& Search, is_iequal Comp ) :
+                    m_Search(::boost::begin(Search), ::boost::end(Search)), m_Comp(Comp) {}
+                first_finderF(
+                        search_iterator_type SearchBegin,
+                        search_iterator_type SearchEnd,
+                        is_iequal Comp ) :
+                    m_Search(SearchBegin, SearchEnd), m_Comp(Comp) {}
+
+                // Operation
+                template< typename ForwardIteratorT >
+                iterator_range<ForwardIteratorT>
+                operator()(
+                    ForwardIteratorT Begin,
+                    ForwardIteratorT End ) const
+                {
+                    return find( Begin, End,
+                        typename searcher_type::template accepts<ForwardIteratorT>() );
                 }
 
             private:
+                typedef ifirst_searcher<search_iterator_type> searcher_type;
+
+                template< typename ForwardIteratorT >
+                iterator_range<ForwardIteratorT>
+                find( ForwardIteratorT Begin, ForwardIteratorT End, mpl::true_ ) const
+                {
+                    if( boost::empty(m_Search) )
+                        return iterator_range<ForwardIteratorT>( End, End );
+
+                    const searcher_type Searcher( m_Search.begin(), m_Search.end(), m_Comp.getloc() );
+                    ForwardIteratorT Found=Searcher( Begin, End );
+                    if ( Found==End )
+                        return iterator_range<ForwardIteratorT>( End, End );
+                    return iterator_range<ForwardIteratorT>( Found, Found+Searcher.pattern_length() );
+                }
+
+                template< typename ForwardIteratorT >
+                iterator_range<ForwardIteratorT>
+                find( ForwardIteratorT Begin, ForwardIteratorT End, mpl::false_ ) const
+                {
+                    return find_first_naive( Begin, End, m_Search, m_Comp );
+                }
+
                 iterator_range<search_iterator_type> m_Search;
-                PredicateT m_Comp;
+                is_iequal m_Comp;
             };
 
 //  find last functor -----------------------------------------------//
 
+            // Holds a right-to-left Boyer-Moore-Horspool searcher, when the
+            // search string and the comparison can be used to build one
+            template<
+                typename SearchIteratorT,
+                typename PredicateT,
+                bool UseSearcherT=
+                    is_convertible<
+                        typename std::iterator_traits<SearchIteratorT>::iterator_category,
+                        std::random_access_iterator_tag>::value &&
+                    ( is_same<typename std::iterator_traits<SearchIteratorT>::value_type, char>::value ||
+                      is_same<typename std::iterator_traits<SearchIteratorT>::value_type, wchar_t>::value ) &&
+                    ( is_same<PredicateT, is_equal>::value || is_same<PredicateT, is_iequal>::value ) >
+            struct last_searcher
+            {
+                last_searcher( SearchIteratorT, SearchIteratorT, const PredicateT& ) {}
+
+                template< typename ForwardIteratorT >
+                struct accepts : public mpl::false_ {};
+
+                template< typename ForwardIteratorT >
+                ForwardIteratorT operator()( ForwardIteratorT, ForwardIteratorT End ) const { return End; }
+                std::size_t pattern_length() const { return 0; }
+            };
+
+            // The corpus must be random access, and hold the same characters
+            template<typename SearchIteratorT>
+            struct last_searcher_accepts
+            {
+                template< typename ForwardIteratorT >
+                struct accepts : public mpl::bool_<
+                    is_convertible<
+                        typename std::iterator_traits<ForwardIteratorT>::iterator_category,
+                        std::random_access_iterator_tag>::value &&
+                    is_same<
+                        typename std::iterator_traits<ForwardIteratorT>::value_type,
+                        typename std::iterator_traits<SearchIteratorT>::value_type>::value > {};
+            };
+
+            template<typename SearchIteratorT>
+            struct last_searcher<SearchIteratorT, is_equal, true> :
+                public ::boost::algorithm::reverse_boyer_moore_horspool<SearchIteratorT>,
+                public last_searcher_accepts<SearchIteratorT>
+            {
+                last_searcher( SearchIteratorT SearchBegin, SearchIteratorT SearchEnd, const is_equal& ) :
+                    ::boost::algorithm::reverse_boyer_moore_horspool<SearchIteratorT>( SearchBegin, SearchEnd ) {}
+            };
+
+            // Case insensitive: a case insensitive searcher for the reversed
+            // search string, run over the reversed input
+            template<typename SearchIteratorT>
+            struct last_searcher<SearchIteratorT, is_iequal, true> :
+                public last_searcher_accepts<SearchIteratorT>
+            {
+                last_searcher( SearchIteratorT SearchBegin, SearchIteratorT SearchEnd, const is_iequal& Comp ) :
+                    m_Searcher( reverse_search_iterator( SearchEnd ), reverse_search_iterator( SearchBegin ), Comp.getloc() ) {}
+
+                template< typename ForwardIteratorT >
+                ForwardIteratorT operator()( ForwardIteratorT Begin, ForwardIteratorT End ) const
+                {
+                    typedef std::reverse_iterator<ForwardIteratorT> reverse_input_iterator;
+                    return ::boost::algorithm::detail::reverse_search_result( Begin, End,
+                        m_Searcher( reverse_input_iterator( End ), reverse_input_iterator( Begin ) ),
+                        m_Searcher.pattern_length() );
+                }
+                std::size_t pattern_length() const { return m_Searcher.pattern_length(); }
+
+            private:
+                typedef std::reverse_iterator<SearchIteratorT> reverse_search_iterator;
+                ::boost::algorithm::iboyer_moore_horspool<reverse_search_iterator> m_Searcher;
+            };
+
             // find the last match a subsequence in the sequence ( functor )
             /*
                 Returns a pair <begin,end> marking the subsequence in the sequence.
                 If the find fails, returns <End,End>
+
+                When the search string and the input are random access sequences
+                of char or wchar_t, and the comparison is is_equal or is_iequal,
+                the input is scanned from the end with a right-to-left
+                Boyer-Moore-Horspool searcher. As in first_finderF, that is
+                built by each call that uses it.
             */
             template<typename SearchIteratorT, typename PredicateT>
             struct last_finderF
@@ -127,13 +329,35 @@ namespace boost {
                     if( boost::empty(m_Search) )
                         return result_type( End, End );
 
+                    return find( Begin, End,
+                        typename searcher_type::template accepts<ForwardIteratorT>() );
+                }
+
+            private:
+                typedef last_searcher<search_iterator_type, PredicateT> searcher_type;
+
+                // random access input, with a searcher
+                template< typename ForwardIteratorT >
+                iterator_range<ForwardIteratorT>
+                find( ForwardIteratorT Begin, ForwardIteratorT End, mpl::true_ ) const
+                {
+                    const searcher_type Searcher( m_Search.begin(), m_Search.end(), m_Comp );
+                    ForwardIteratorT Found=Searcher( Begin, End );
+                    if ( Found==End )
+                        return iterator_range<ForwardIteratorT>( End, End );
+                    return iterator_range<ForwardIteratorT>( Found, Found+Searcher.pattern_length() );
+                }
+
+                template< typename ForwardIteratorT >
+                iterator_range<ForwardIteratorT>
+                find( ForwardIteratorT Begin, ForwardIteratorT End, mpl::false_ ) const
+                {
                     typedef BOOST_STRING_TYPENAME boost::detail::
                         iterator_traits<ForwardIteratorT>::iterator_category category;
 
                     return findit( Begin, End, category() );
                 }
 
-            private:
                 // forward iterator
                 template< typename ForwardIteratorT >
                 iterator_range<ForwardIteratorT>
@@ -150,10 +374,13 @@ namespace boost {
                     result_type M=first_finder( Begin, End );
                     result_type Last=M;
 
+                    // Carry on from just after the start of each match, so
+                    // that a last match that overlaps it is found too
                     while( M )
                     {
                         Last=M;
-                        M=first_finder( ::boost::end(M), End );
+                        ForwardIteratorT Next=::boost::begin(M);
+                        M=first_finder( ++Next, End );
                     }
 
                     return Last;
@@ -12,14 +12,20 @@
 #define BOOST_STRING_STD_ROPE_TRAITS_HPP
 
 #include <boost/algorithm/string/yes_no_type.hpp>
+#ifdef __GLIBCXX__
+#include <ext/rope>
+#else
 #include <rope>
+#endif
 #include <boost/algorithm/string/sequence_traits.hpp>
+#include <boost/algorithm/searching/segmented_iterator.hpp>
 
 namespace boost {
     namespace algorithm {
 
 //  SGI's std::rope<> traits  -----------------------------------------------//
 
+#ifndef __GLIBCXX__
     
     // native replace trait
         template<typename T, typename TraitsT, typename AllocT>
@@ -73,6 +79,37 @@ namespace boost {
             typedef mpl::bool_<value> type;     
         };
 
+#else // __GLIBCXX__
+
+    // segmented iterator trait (libstdc++ ships the rope as __gnu_cxx::rope)
+        namespace detail {
+            // Reaches the leaf buffer that a rope iterator keeps, which
+            // is protected in the iterator base
+            template<typename T, typename AllocT>
+            struct rope_iterator_buffer : public __gnu_cxx::_Rope_iterator_base<T,AllocT>
+            {
+                typedef __gnu_cxx::_Rope_iterator_base<T,AllocT> base_type;
+
+                static const T* current( const base_type& It ) { return It.*(&rope_iterator_buffer::_M_buf_ptr); }
+                static const T* end( const base_type& It ) { return It.*(&rope_iterator_buffer::_M_buf_end); }
+            };
+        } // namespace detail
+
+        // The searchers search each leaf of libstdc++'s rope through its buffer
+        template<typename T, typename AllocT>
+        struct segmented_iterator_traits< __gnu_cxx::_Rope_const_iterator<T,AllocT> >
+        {
+            typedef boost::true_type is_segmented;
+            typedef const T* pointer;
+
+            static std::ptrdiff_t segment( __gnu_cxx::_Rope_const_iterator<T,AllocT>& It, pointer& P )
+            {
+                *It;    // fills in the buffer
+                P = detail::rope_iterator_buffer<T,AllocT>::current( It );
+                return detail::rope_iterator_buffer<T,AllocT>::end( It ) - P;
+            }
+        };
+#endif // __GLIBCXX__
 
     } // namespace algorithm
 } // namespace boost
@@ -0,0 +1,129 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+#include <boost/algorithm/searching/aho_corasick.hpp>
+
+#include "random_test.hpp"
+
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <iterator>
+
+namespace ba = boost::algorithm;
+
+namespace {
+
+//  Every match, found the slow way, ordered by end position and then by length (longest first)
+    template <typename String>
+    std::vector<std::pair<std::size_t, std::size_t> >
+    brute_force ( const String &corpus, const std::vector<String> &patterns ) {
+        std::vector<std::pair<std::size_t, std::size_t> > retVal;
+        for ( std::size_t end = 1; end <= corpus.size (); ++end ) {
+            std::vector<std::pair<std::size_t, std::size_t> > here;    // (start, id)
+            for ( std::size_t id = 0; id < patterns.size (); ++id ) {
+                const std::size_t len = patterns [ id ].size ();
+                if ( len == 0 || len > end ) continue;
+                if ( std::find ( patterns.begin (), patterns.begin () + id, patterns [ id ] ) != patterns.begin () + id )
+                    continue;   // duplicates report the first id
+                if ( std::equal ( patterns [ id ].begin (), patterns [ id ].end (), corpus.begin () + ( end - len )))
+                    here.push_back ( std::make_pair ( end - len, id ));
+                }
+            std::sort ( here.begin (), here.end ());
+            retVal.insert ( retVal.end (), here.begin (), here.end ());
+            }
+        return retVal;
+        }
+
+    template <typename String>
+    void check_one ( const String &corpus, const std::vector<String> &patterns ) {
+        typedef typename String::const_iterator iter_type;
+        typedef std::pair<iter_type, std::size_t> match_type;
+
+        const std::vector<std::pair<std::size_t, std::size_t> > expected = brute_force ( corpus, patterns );
+        ba::aho_corasick<iter_type> ac = ba::make_aho_corasick ( patterns );
+        BOOST_CHECK_EQUAL ( ac.size (), patterns.size ());
+
+    //  All the matches
+        std::vector<match_type> found;
+        ac.find_all ( corpus.begin (), corpus.end (), std::back_inserter ( found ));
+        BOOST_REQUIRE_EQUAL ( found.size (), expected.size ());
+        for ( std::size_t i = 0; i < found.size (); ++i ) {
+            BOOST_CHECK_EQUAL ( found [ i ].first - corpus.begin (), (std::ptrdiff_t) expected [ i ].first );
+            BOOST_CHECK_EQUAL ( found [ i ].second, expected [ i ].second );
+            }
+
+    //  The first match
+        const match_type first = ac ( corpus.begin (), corpus.end ());
+        const match_type first2 = ba::aho_corasick_search ( corpus.begin (), corpus.end (), patterns.begin (), patterns.end ());
+        BOOST_CHECK ( first == first2 );
+        if ( expected.empty ()) {
+            BOOST_CHECK ( first.first == corpus.end ());
+            BOOST_CHECK_EQUAL ( first.second, ba::aho_corasick<iter_type>::npos );
+            }
+        else {
+            BOOST_CHECK_EQUAL ( first.first - corpus.begin (), (std::ptrdiff_t) expected [ 0 ].first );
+            BOOST_CHECK_EQUAL ( first.second, expected [ 0 ].second );
+            }
+        }
+
+    template <typename String>
+    void check_random ( unsigned alphabet, std::size_t count, unsigned long seed ) {
+        std::vector<String> patterns;
+        for ( std::size_t i = 0; i < count; ++i )
+            patterns.push_back ( make_string<String> ( 1 + next_random ( seed ) % 6, alphabet, seed ));
+        const String corpus = make_string<String> ( 500, alphabet, seed );
+        check_one ( corpus, patterns );
+        }
+    }
+
+
+BOOST_AUTO_TEST_CASE( test_main )
+{
+    std::vector<std::string> keywords;
+    keywords.push_back ( "he" );
+    keywords.push_back ( "she" );
+    keywords.push_back ( "his" );
+    keywords.push_back ( "hers" );
+    check_one ( std::string ( "ushers" ), keywords );
+    check_one ( std::string ( "ahishers" ), keywords );
+    check_one ( std::string ( "nothing to see" ), keywords );
+    check_one ( std::string ( "" ), keywords );
+
+//  Empty and duplicate patterns
+    keywords.push_back ( "" );
+    keywords.push_back ( "she" );
+    check_one ( std::string ( "ushers she" ), keywords );
+    check_one ( std::string ( "ushers" ), std::vector<std::string> ());
+
+//  High-bit characters
+    std::vector<std::string> high;
+    high.push_back ( "\xff\x80" );
+    high.push_back ( "\x80" );
+    check_one ( std::string ( "ab\xff\x80\x80\xff" ), high );
+
+//  Byte alphabets use the dense automaton; wider ones use the sparse one
+    for ( unsigned long seed = 1; seed < 20; ++seed ) {
+        check_random<std::string>  ( 2 + seed % 5, 1 + seed * 3, seed );
+        check_random<std::wstring> ( 2 + seed % 5, 1 + seed * 3, seed );
+        check_random<std::vector<int> > ( 2 + seed % 5, 1 + seed * 3, seed );
+        }
+
+//  Using a range-based interface
+    std::string corpus ( "she sells sea shells" );
+    ba::aho_corasick<std::string::const_iterator> ac = ba::make_aho_corasick ( keywords );
+    std::pair<std::string::iterator, std::size_t> res = ac ( corpus );
+    BOOST_CHECK ( res.first == corpus.begin () && res.second == 1 );
+    res = ba::aho_corasick_search ( corpus, keywords );
+    BOOST_CHECK ( res.first == corpus.begin () && res.second == 1 );
+}
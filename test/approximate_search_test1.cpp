@@ -0,0 +1,174 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+
+    Testing the bitap approximate searcher
+*/
+
+#include <boost/algorithm/searching/approximate_search.hpp>
+
+#include "random_test.hpp"
+
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+#include <vector>
+#include <list>
+#include <iterator>
+#include <algorithm>
+
+namespace ba = boost::algorithm;
+
+namespace {
+
+//  The fewest errors of any match ending at each position (index = end offset)
+    std::vector<std::size_t> reference ( const std::string &haystack, const std::string &needle, ba::approximate_mode_type mode ) {
+        const std::size_t n = haystack.size (), m = needle.size ();
+        std::vector<std::size_t> retVal ( n + 1, m + n + 1 );
+        if ( mode == ba::approximate_edits ) {
+        //  Sellers' dynamic programming; a match may start anywhere
+            std::vector<std::size_t> col ( m + 1 );
+            for ( std::size_t i = 0; i <= m; ++i ) col [ i ] = i;
+            retVal [ 0 ] = m;
+            for ( std::size_t e = 1; e <= n; ++e ) {
+                std::size_t diag = col [ 0 ];
+                col [ 0 ] = 0;
+                for ( std::size_t i = 1; i <= m; ++i ) {
+                    const std::size_t up = col [ i ];
+                    col [ i ] = std::min ( std::min ( up + 1, col [ i - 1 ] + 1 ),
+                                           diag + ( needle [ i - 1 ] == haystack [ e - 1 ] ? 0 : 1 ));
+                    diag = up;
+                    }
+                retVal [ e ] = col [ m ];
+                }
+            }
+        else {
+            for ( std::size_t e = m; e <= n; ++e ) {
+                std::size_t errors = 0;
+                for ( std::size_t i = 0; i < m; ++i )
+                    if ( needle [ i ] != haystack [ e - m + i ] )
+                        ++errors;
+                if ( mode == ba::approximate_exact && errors != 0 )
+                    continue;
+                retVal [ e ] = errors;
+                }
+            }
+        return retVal;
+        }
+
+    void check_one ( const std::string &haystack, const std::string &needle, std::size_t k, ba::approximate_mode_type mode ) {
+        typedef std::string::const_iterator iter_type;
+        const ba::bitap<iter_type> bp ( needle.begin (), needle.end (), k, mode );
+        const std::vector<std::size_t> ref = reference ( haystack, needle, k == 0 ? ba::approximate_exact : mode );
+
+        std::vector<std::size_t> ends, errors;
+        for ( std::size_t e = 1; e <= haystack.size (); ++e )
+            if ( ref [ e ] <= k ) {
+                ends.push_back ( e );
+                errors.push_back ( ref [ e ] );
+                }
+
+        std::vector<ba::approximate_match<iter_type> > all;
+        bp.find_all ( haystack.begin (), haystack.end (), std::back_inserter ( all ));
+        std::vector<std::size_t> all_ends, all_errors;
+        for ( std::size_t i = 0; i < all.size (); ++i ) {
+            all_ends.push_back ( all [ i ].end - haystack.begin ());
+            all_errors.push_back ( all [ i ].errors );
+            }
+        BOOST_CHECK_EQUAL_COLLECTIONS ( all_ends.begin (), all_ends.end (), ends.begin (), ends.end ());
+        BOOST_CHECK_EQUAL_COLLECTIONS ( all_errors.begin (), all_errors.end (), errors.begin (), errors.end ());
+
+        const boost::optional<ba::approximate_match<iter_type> > first = bp ( haystack.begin (), haystack.end ());
+        if ( ends.empty ())
+            BOOST_CHECK ( !first );
+        else {
+            BOOST_REQUIRE ( first );
+            BOOST_CHECK_EQUAL ( std::size_t ( first->end - haystack.begin ()), ends [ 0 ] );
+            BOOST_CHECK_EQUAL ( first->errors, errors [ 0 ] );
+            }
+
+        const boost::optional<ba::approximate_match<iter_type> > free_first = ba::approximate_search ( haystack, needle, k, mode );
+        BOOST_CHECK_EQUAL ( free_first ? std::size_t ( free_first->end - haystack.begin ()) : 0U, ends.empty () ? 0U : ends [ 0 ] );
+        const boost::optional<ba::approximate_match<iter_type> > free_first2 =
+            ba::approximate_search ( haystack.begin (), haystack.end (), needle, k, mode );
+        BOOST_CHECK_EQUAL ( bool ( free_first2 ), bool ( free_first ));
+        if ( free_first2 && free_first )
+            BOOST_CHECK ( free_first2->end == free_first->end && free_first2->errors == free_first->errors );
+        const boost::optional<ba::approximate_match<iter_type> > free_first3 =
+            ba::approximate_search ( haystack.begin (), haystack.end (), needle.begin (), needle.end (), k, mode );
+        BOOST_CHECK_EQUAL ( bool ( free_first3 ), bool ( free_first ));
+        if ( free_first3 && free_first )
+            BOOST_CHECK ( free_first3->end == free_first->end && free_first3->errors == free_first->errors );
+        }
+    }
+
+
+BOOST_AUTO_TEST_CASE( test_main )
+{
+    typedef std::string::const_iterator iter_type;
+    const std::string haystack ( "the quick brown fox jumps over the lazy dog" );
+
+    check_one ( haystack, "fox", 0, ba::approximate_edits );
+    check_one ( haystack, "fax", 1, ba::approximate_substitutions );
+    check_one ( haystack, "fx", 1, ba::approximate_edits );
+    check_one ( haystack, "foox", 1, ba::approximate_edits );
+    check_one ( haystack, "cat", 0, ba::approximate_exact );
+    check_one ( haystack, "lazy cog", 2, ba::approximate_exact );
+
+    for ( unsigned long seed = 1; seed < 150; ++seed ) {
+        unsigned long s = seed;
+        const unsigned alphabet = 2 + seed % 4;
+        const std::string hay = make_string ( 200 + seed, alphabet, s );
+        const std::string needle = make_string ( 1 + seed % 12, alphabet, s );
+        const std::size_t k = seed % 4;
+        check_one ( hay, needle, k, ba::approximate_substitutions );
+        check_one ( hay, needle, k, ba::approximate_edits );
+        check_one ( hay, needle, k, ba::approximate_exact );
+        }
+
+//  Patterns longer than one word
+    unsigned long s = 7;
+    const std::string big = make_string ( 3000, 4, s );
+    std::string needle = big.substr ( 1000, 150 );
+    needle [ 10 ] = 'z';
+    needle.erase ( 70, 1 );
+    needle.insert ( 128, "y" );
+    check_one ( big, needle, 0, ba::approximate_edits );
+    check_one ( big, needle, 3, ba::approximate_edits );
+    check_one ( big, needle, 3, ba::approximate_substitutions );
+    check_one ( big, big.substr ( 2000, 64 ), 2, ba::approximate_edits );
+    check_one ( big, big.substr ( 2000, 65 ), 2, ba::approximate_edits );
+    const boost::optional<ba::approximate_match<iter_type> > found = ba::approximate_search ( big, needle, 3 );
+    BOOST_REQUIRE ( found );
+    BOOST_CHECK_EQUAL ( found->errors, 3U );
+
+//  Non-overlapping mode starts over after each match
+    const std::string aaaa ( "aaaaaa" ), aa ( "aa" );
+    std::vector<ba::approximate_match<iter_type> > matches;
+    ba::make_bitap ( aa ).find_all ( aaaa.begin (), aaaa.end (), std::back_inserter ( matches ), ba::match_non_overlapping );
+    BOOST_REQUIRE_EQUAL ( matches.size (), 3U );
+    BOOST_CHECK ( matches [ 2 ].end == aaaa.end ());
+
+//  Forward iterators are enough for the corpus, and the elements need not be chars
+    std::list<int> lhaystack;
+    for ( int i = 0; i < 20; ++i )
+        lhaystack.push_back ( i );
+    std::vector<int> lneedle;
+    lneedle.push_back ( 7 );
+    lneedle.push_back ( 42 );
+    lneedle.push_back ( 9 );
+    const boost::optional<ba::approximate_match<std::list<int>::iterator> > lfound =
+        ba::approximate_search ( lhaystack, lneedle, 1, ba::approximate_substitutions );
+    BOOST_REQUIRE ( lfound );
+    BOOST_CHECK_EQUAL ( *lfound->end, 10 );
+    BOOST_CHECK_EQUAL ( lfound->errors, 1U );
+
+//  An empty pattern matches at the start
+    const std::string empty;
+    BOOST_CHECK ( ba::approximate_search ( haystack, empty, 1 )->end == haystack.begin ());
+}
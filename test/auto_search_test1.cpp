@@ -0,0 +1,190 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+
+    Testing the adaptive searcher
+*/
+
+#include <boost/algorithm/searching/auto_searcher.hpp>
+
+#include "random_test.hpp"
+
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <algorithm>
+#include <iterator>
+
+namespace ba = boost::algorithm;
+
+namespace {
+
+    std::vector<std::size_t> brute_force ( const std::string &haystack, const std::string &needle, ba::match_mode_type mode ) {
+        std::vector<std::size_t> retVal;
+        if ( needle.empty ()) return retVal;
+        std::string::size_type pos = haystack.find ( needle );
+        while ( pos != std::string::npos ) {
+            retVal.push_back ( pos );
+            pos = haystack.find ( needle, pos + ( mode == ba::match_overlapping ? 1 : needle.size ()));
+            }
+        return retVal;
+        }
+
+//  Check the searcher over the string itself, and over a copy of it in a
+//  deque (which the memchr and simd engines can't use directly)
+    void check_searcher ( const ba::auto_searcher<std::string::const_iterator> &as,
+                          const std::string &haystack, const std::string &needle ) {
+        typedef std::string::const_iterator iter_type;
+        const std::deque<char> dq ( haystack.begin (), haystack.end ());
+
+        const iter_type expected = std::search ( haystack.begin (), haystack.end (), needle.begin (), needle.end ());
+        BOOST_CHECK ( as ( haystack.begin (), haystack.end ()) == expected );
+        BOOST_CHECK ( as ( dq.begin (), dq.end ()) - dq.begin () == expected - haystack.begin ());
+
+        for ( int i = 0; i < 2; ++i ) {
+            const ba::match_mode_type mode = i == 0 ? ba::match_overlapping : ba::match_non_overlapping;
+            const std::vector<std::size_t> exp_all = brute_force ( haystack, needle, mode );
+
+            std::vector<iter_type> all;
+            as.find_all ( haystack.begin (), haystack.end (), std::back_inserter ( all ), mode );
+            BOOST_CHECK_EQUAL ( all.size (), exp_all.size ());
+            for ( std::size_t j = 0; j < all.size () && j < exp_all.size (); ++j )
+                BOOST_CHECK_EQUAL ( static_cast<std::size_t> ( all [ j ] - haystack.begin ()), exp_all [ j ] );
+
+            std::vector<std::deque<char>::const_iterator> dq_all;
+            as.find_all ( dq.begin (), dq.end (), std::back_inserter ( dq_all ), mode );
+            BOOST_CHECK_EQUAL ( dq_all.size (), exp_all.size ());
+            for ( std::size_t j = 0; j < dq_all.size () && j < exp_all.size (); ++j )
+                BOOST_CHECK_EQUAL ( static_cast<std::size_t> ( dq_all [ j ] - dq.begin ()), exp_all [ j ] );
+            }
+        }
+
+    void check_one ( const std::string &haystack, const std::string &needle ) {
+        typedef std::string::const_iterator iter_type;
+        const iter_type expected = std::search ( haystack.begin (), haystack.end (), needle.begin (), needle.end ());
+        BOOST_CHECK ( ba::auto_search ( haystack, needle ) == expected );
+        BOOST_CHECK ( ba::auto_search ( haystack.begin (), haystack.end (), needle.begin (), needle.end ()) == expected );
+
+    //  Force each engine in turn
+        const ba::auto_searcher<iter_type> as ( needle.begin (), needle.end ());
+        check_searcher ( as, haystack, needle );
+
+        ba::auto_search_thresholds t;
+        t.simd_max_length = 0;
+        t.periodic_repeats = 0;
+        const ba::auto_searcher<iter_type> bmh ( needle.begin (), needle.end (), t );
+        check_searcher ( bmh, haystack, needle );
+
+        t.boyer_moore_any_alphabet_length = 0;
+        const ba::auto_searcher<iter_type> bm ( needle.begin (), needle.end (), t );
+        check_searcher ( bm, haystack, needle );
+
+        t.periodic_repeats = 1;
+        const ba::auto_searcher<iter_type> tw ( needle.begin (), needle.end (), t );
+        check_searcher ( tw, haystack, needle );
+
+        t = ba::auto_search_thresholds ();
+        t.simd_max_length = static_cast<std::size_t> ( -1 );
+        const ba::auto_searcher<iter_type> simd ( needle.begin (), needle.end (), t );
+        check_searcher ( simd, haystack, needle );
+
+        if ( needle.size () > 1 ) {
+            BOOST_CHECK_EQUAL ( bmh.engine (), ba::engine_horspool );
+            BOOST_CHECK_EQUAL ( bm.engine (), ba::engine_boyer_moore );
+            BOOST_CHECK_EQUAL ( tw.engine (), ba::engine_two_way );
+            BOOST_CHECK_EQUAL ( simd.engine (), ba::engine_simd );
+            }
+        }
+    }
+
+
+BOOST_AUTO_TEST_CASE( test_engine_choice )
+{
+    typedef std::string::const_iterator iter_type;
+    unsigned long seed = 7;
+    const std::string one ( "x" );
+    const std::string short_pat ( "needle" );
+    const std::string english ( "the quick brown fox jumps over the lazy dog, then naps for a while" );
+    const std::string periodic ( "abcabcabcabcabcabcabcabcabcabc" );
+    const std::string wide   = make_string ( 300, 100, seed );
+    const std::string narrow = make_string ( 300, 4, seed );
+    const std::string huge   = make_string ( 2000, 4, seed );
+
+    BOOST_CHECK_EQUAL ( ba::make_auto_searcher ( one ).engine (),       ba::engine_memchr );
+    BOOST_CHECK_EQUAL ( ba::make_auto_searcher ( short_pat ).engine (), ba::engine_simd );
+    BOOST_CHECK_EQUAL ( ba::make_auto_searcher ( english ).engine (),   ba::engine_horspool );
+    BOOST_CHECK_EQUAL ( ba::make_auto_searcher ( periodic ).engine (),  ba::engine_two_way );
+    BOOST_CHECK_EQUAL ( ba::make_auto_searcher ( wide ).engine (),      ba::engine_boyer_moore );
+    BOOST_CHECK_EQUAL ( ba::make_auto_searcher ( narrow ).engine (),    ba::engine_horspool );
+    BOOST_CHECK_EQUAL ( ba::make_auto_searcher ( huge ).engine (),      ba::engine_boyer_moore );
+    BOOST_CHECK_EQUAL ( std::string ( ba::make_auto_searcher ( wide ).engine_name ()), "boyer_moore" );
+
+//  What the analysis found
+    const ba::auto_searcher<iter_type> p ( periodic.begin (), periodic.end ());
+    BOOST_CHECK_EQUAL ( p.period (), 3U );
+    BOOST_CHECK_EQUAL ( p.alphabet_size (), 3U );
+    BOOST_CHECK_EQUAL ( p.pattern_length (), periodic.size ());
+
+//  A corpus that's not much longer than the pattern gets no tables
+    const ba::auto_searcher<iter_type> small ( english.begin (), english.end (), ba::auto_search_thresholds (), 100 );
+    BOOST_CHECK_EQUAL ( small.engine (), ba::engine_simd );
+    const ba::auto_searcher<iter_type> large ( english.begin (), english.end (), ba::auto_search_thresholds (), 100000 );
+    BOOST_CHECK_EQUAL ( large.engine (), ba::engine_horspool );
+
+//  The thresholds can be changed
+    ba::auto_search_thresholds t;
+    t.simd_max_length = 4;
+    BOOST_CHECK_EQUAL ( ba::auto_searcher<iter_type> ( short_pat.begin (), short_pat.end (), t ).engine (), ba::engine_horspool );
+    t.boyer_moore_min_length = 1;
+    t.boyer_moore_min_alphabet = 1;
+    BOOST_CHECK_EQUAL ( ba::auto_searcher<iter_type> ( short_pat.begin (), short_pat.end (), t ).engine (), ba::engine_boyer_moore );
+}
+
+BOOST_AUTO_TEST_CASE( test_search )
+{
+    check_one ( "", "" );
+    check_one ( "abc", "" );
+    check_one ( "", "abc" );
+    check_one ( "abc", "abcd" );
+    check_one ( "abcabcabc", "c" );
+    check_one ( "abcabcabc", "q" );
+    check_one ( "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa", "aaaa" );
+    check_one ( "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaab", "aaaaaaaaaaaaaaaaaaab" );
+    check_one ( "the quick brown fox jumps over the lazy dog", "lazy" );
+    check_one ( "the quick brown fox jumps over the lazy dog", "over the lazy dog" );
+
+    unsigned long seed = 42;
+    const std::size_t k_lengths [] = { 1, 2, 3, 5, 16, 17, 40, 300 };
+    for ( unsigned alphabet = 2; alphabet <= 26; alphabet += 8 )
+        for ( std::size_t i = 0; i < sizeof ( k_lengths ) / sizeof ( k_lengths [ 0 ] ); ++i ) {
+            const std::string haystack = make_string ( 3000, alphabet, seed );
+            check_one ( haystack, haystack.substr ( 2000, k_lengths [ i ] ));
+            check_one ( haystack, make_string ( k_lengths [ i ], alphabet, seed ));
+            }
+}
+
+BOOST_AUTO_TEST_CASE( test_not_bytes )
+{
+    typedef std::vector<int>::const_iterator iter_type;
+    std::vector<int> corpus;
+    for ( int i = 0; i < 1000; ++i )
+        corpus.push_back ( i % 37 );
+    const std::vector<int> pattern ( corpus.begin () + 500, corpus.begin () + 520 );
+    const std::vector<int> single ( 1, 36 );
+
+    const ba::auto_searcher<iter_type> as ( pattern.begin (), pattern.end ());
+    BOOST_CHECK ( as.engine () != ba::engine_simd && as.engine () != ba::engine_memchr );
+    BOOST_CHECK ( as ( corpus.begin (), corpus.end ()) == corpus.begin () + 19 );
+    BOOST_CHECK ( ba::auto_search ( corpus, single ) == corpus.begin () + 36 );
+
+    std::vector<iter_type> all;
+    as.find_all ( corpus, std::back_inserter ( all ));
+    BOOST_CHECK_EQUAL ( all.size (), 26U );
+}
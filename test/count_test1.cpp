@@ -0,0 +1,181 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+
+    Testing the searchers' count members, parallel_count and count_all
+*/
+
+#include <boost/algorithm/searching/boyer_moore.hpp>
+#include <boost/algorithm/searching/boyer_moore_horspool.hpp>
+#include <boost/algorithm/searching/knuth_morris_pratt.hpp>
+#include <boost/algorithm/searching/two_way.hpp>
+#include <boost/algorithm/searching/auto_searcher.hpp>
+#include <boost/algorithm/searching/iboyer_moore.hpp>
+#include <boost/algorithm/searching/iboyer_moore_horspool.hpp>
+#include <boost/algorithm/searching/parallel_search.hpp>
+#include <boost/algorithm/string/count.hpp>
+
+#include "random_test.hpp"
+
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <list>
+#include <iterator>
+
+namespace ba = boost::algorithm;
+
+namespace {
+
+    std::size_t brute_force ( const std::string &haystack, const std::string &needle, ba::match_mode_type mode ) {
+        std::size_t retVal = 0;
+        if ( needle.empty ()) return retVal;
+        std::string::size_type pos = haystack.find ( needle );
+        while ( pos != std::string::npos ) {
+            ++retVal;
+            pos = haystack.find ( needle, pos + ( mode == ba::match_overlapping ? 1 : needle.size ()));
+            }
+        return retVal;
+        }
+
+//  Count over the string itself, and over a copy of it in a deque (which
+//  the vector kernel can't use)
+    template <typename Searcher>
+    void check_searcher ( const Searcher &searcher, const std::string &haystack, const std::string &needle ) {
+        const std::deque<char> dq ( haystack.begin (), haystack.end ());
+        for ( int i = 0; i < 2; ++i ) {
+            const ba::match_mode_type mode = i == 0 ? ba::match_overlapping : ba::match_non_overlapping;
+            const std::size_t expected = brute_force ( haystack, needle, mode );
+            BOOST_CHECK_EQUAL ( searcher.count ( haystack.begin (), haystack.end (), mode ), expected );
+            BOOST_CHECK_EQUAL ( searcher.count ( dq, mode ), expected );
+            BOOST_CHECK_EQUAL ( ba::count_all ( haystack, needle, mode ), expected );
+            }
+        BOOST_CHECK_EQUAL ( searcher.count ( haystack ), brute_force ( haystack, needle, ba::match_overlapping ));
+        }
+
+    void check_one ( const std::string &haystack, const std::string &needle ) {
+        typedef std::string::const_iterator iter_type;
+        check_searcher ( ba::boyer_moore<iter_type>          ( needle.begin (), needle.end ()), haystack, needle );
+        check_searcher ( ba::boyer_moore_horspool<iter_type> ( needle.begin (), needle.end ()), haystack, needle );
+        check_searcher ( ba::knuth_morris_pratt<iter_type>   ( needle.begin (), needle.end ()), haystack, needle );
+        check_searcher ( ba::two_way<iter_type>              ( needle.begin (), needle.end ()), haystack, needle );
+        check_searcher ( ba::auto_searcher<iter_type>        ( needle.begin (), needle.end ()), haystack, needle );
+        check_searcher ( ba::iboyer_moore<iter_type>         ( needle.begin (), needle.end ()), haystack, needle );
+        check_searcher ( ba::iboyer_moore_horspool<iter_type> ( needle.begin (), needle.end ()), haystack, needle );
+        }
+    }
+
+
+BOOST_AUTO_TEST_CASE( test_count )
+{
+    check_one ( "", "" );
+    check_one ( "abc", "" );
+    check_one ( "", "abc" );
+    check_one ( "abc", "abcd" );
+    check_one ( "abcabcabc", "abc" );
+    check_one ( "abcabcabc", "c" );
+    check_one ( "abcabcabc", "q" );
+    check_one ( "aaaaaaaaaa", "aa" );
+    check_one ( "aaaaaaaaaa", "aaa" );
+    check_one ( "abababababa", "aba" );
+
+//  Long enough to use the vector kernel, with a tail
+    unsigned long seed = 3;
+    const std::size_t k_lengths [] = { 1, 2, 3, 7, 20 };
+    for ( unsigned alphabet = 2; alphabet <= 26; alphabet += 8 )
+        for ( std::size_t i = 0; i < sizeof ( k_lengths ) / sizeof ( k_lengths [ 0 ] ); ++i ) {
+            const std::string haystack = make_string ( 5000 + 17 * i, alphabet, seed );
+            check_one ( haystack, haystack.substr ( 1000, k_lengths [ i ] ));
+            check_one ( haystack, make_string ( k_lengths [ i ], alphabet, seed ));
+            }
+}
+
+BOOST_AUTO_TEST_CASE( test_count_bytes )
+{
+//  More than 255 blocks of every byte value, to exercise the counter flush
+    std::string haystack;
+    for ( int i = 0; i < 100000; ++i )
+        haystack.push_back ( static_cast<char> ( i * 7 ));
+    const std::string needle ( 1, static_cast<char> ( 0xC8 ));
+    const ba::boyer_moore_horspool<std::string::const_iterator> bmh ( needle.begin (), needle.end ());
+    BOOST_CHECK_EQUAL ( bmh.count ( haystack ), brute_force ( haystack, needle, ba::match_overlapping ));
+
+    const std::string zeros ( 70000, '\0' );
+    const std::string zero ( 1, '\0' );
+    BOOST_CHECK_EQUAL ( ba::make_boyer_moore ( zero ).count ( zeros ), zeros.size ());
+    BOOST_CHECK_EQUAL ( ba::count_all ( zeros, zero ), zeros.size ());
+}
+
+BOOST_AUTO_TEST_CASE( test_count_all )
+{
+    BOOST_CHECK_EQUAL ( ba::count_all ( "aaaa", "aa" ), 2U );
+    BOOST_CHECK_EQUAL ( ba::count_all ( "aaaa", "aa", ba::match_overlapping ), 3U );
+    BOOST_CHECK_EQUAL ( ba::count_all ( "aaaa", "" ), 0U );
+    BOOST_CHECK_EQUAL ( ba::icount_all ( "Error, error, ERROR", "error" ), 3U );
+    BOOST_CHECK_EQUAL ( ba::icount_all ( std::wstring ( L"AbAbA" ), L"aba", ba::match_overlapping ), 2U );
+
+//  Patterns on either side of the longest one that is folded on the stack
+    unsigned long seed = 22;
+    const std::string text = make_string ( 20000, 2, seed );
+    std::string mixed ( text );
+    for ( std::size_t i = 0; i < mixed.size (); i += 3 )
+        mixed [ i ] = static_cast<char> ( mixed [ i ] - 'a' + 'A' );
+    for ( std::size_t len = 62; len <= 66; ++len ) {
+        const std::string pat = text.substr ( 1000, len );
+        BOOST_CHECK ( ba::count_all ( text, pat ) >= 1U );
+        BOOST_CHECK_EQUAL ( ba::icount_all ( mixed, pat ), ba::count_all ( text, pat ));
+        BOOST_CHECK_EQUAL ( ba::icount_all ( mixed, pat, ba::match_overlapping ),
+                            ba::count_all ( text, pat, ba::match_overlapping ));
+        }
+
+//  Not random access, and not characters: the finder loop
+    const std::string s ( "xaaay" );
+    const std::list<char> li ( s.begin (), s.end ());
+    BOOST_CHECK_EQUAL ( ba::count_all ( li, "aa" ), 1U );
+    BOOST_CHECK_EQUAL ( ba::count_all ( li, "aa", ba::match_overlapping ), 2U );
+    BOOST_CHECK_EQUAL ( ba::icount_all ( li, "AA", ba::match_overlapping ), 2U );
+
+    int nums [] = { 1, 2, 1, 2, 1, 3 };
+    int pat  [] = { 1, 2, 1 };
+    const std::vector<int> v ( nums, nums + 6 );
+    BOOST_CHECK_EQUAL ( ba::count_all ( v, pat ), 1U );
+    BOOST_CHECK_EQUAL ( ba::count_all ( v, pat, ba::match_overlapping ), 2U );
+}
+
+BOOST_AUTO_TEST_CASE( test_parallel_count )
+{
+    typedef std::string::const_iterator iter_type;
+    unsigned long seed = 5;
+    const std::string haystack = make_string ( 2 * 1024 * 1024, 3, seed );
+    const char *needles [] = { "a", "ab", "aaa", "abcab", "aaaaaaaaaaaaaaaa" };
+    const unsigned threads [] = { 0, 1, 2, 3, 8 };
+    for ( std::size_t n = 0; n < sizeof ( needles ) / sizeof ( needles [ 0 ] ); ++n ) {
+        const std::string needle ( needles [ n ] );
+        const ba::boyer_moore_horspool<iter_type> bmh ( needle.begin (), needle.end ());
+        const ba::knuth_morris_pratt<iter_type>   kmp ( needle.begin (), needle.end ());
+        for ( int i = 0; i < 2; ++i ) {
+            const ba::match_mode_type mode = i == 0 ? ba::match_overlapping : ba::match_non_overlapping;
+            const std::size_t expected = brute_force ( haystack, needle, mode );
+            for ( std::size_t t = 0; t < sizeof ( threads ) / sizeof ( threads [ 0 ] ); ++t ) {
+                BOOST_CHECK_EQUAL ( ba::parallel_count ( bmh, haystack, mode, threads [ t ] ), expected );
+                BOOST_CHECK_EQUAL ( ba::parallel_count ( kmp, haystack.begin (), haystack.end (), mode, threads [ t ] ), expected );
+                }
+            }
+        }
+
+//  A run of matches that crosses every chunk boundary
+    const std::string run ( 1024 * 1024 + 5, 'a' );
+    const std::string aaa ( "aaa" );
+    const ba::boyer_moore<iter_type> bm ( aaa.begin (), aaa.end ());
+    for ( std::size_t t = 0; t < sizeof ( threads ) / sizeof ( threads [ 0 ] ); ++t ) {
+        BOOST_CHECK_EQUAL ( ba::parallel_count ( bm, run, ba::match_non_overlapping, threads [ t ] ), run.size () / 3 );
+        BOOST_CHECK_EQUAL ( ba::parallel_count ( bm, run, ba::match_overlapping, threads [ t ] ), run.size () - 2 );
+        }
+}
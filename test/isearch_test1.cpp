@@ -0,0 +1,134 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+
+    Testing the case-insensitive searchers
+*/
+
+#include <boost/algorithm/searching/iboyer_moore.hpp>
+#include <boost/algorithm/searching/iboyer_moore_horspool.hpp>
+#include <boost/algorithm/string/find.hpp>
+#include <boost/algorithm/string/predicate.hpp>
+#include <boost/algorithm/string/replace.hpp>
+
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+
+#include <cctype>
+#include <string>
+#include <vector>
+#include <list>
+#include <iterator>
+
+namespace ba = boost::algorithm;
+
+namespace {
+
+    template <typename charT>
+    bool iequal ( charT a, charT b ) {
+        return std::toupper ( a, std::locale::classic ()) == std::toupper ( b, std::locale::classic ());
+        }
+
+    template <typename Str>
+    std::vector<int> brute_force ( const Str &haystack, const Str &needle, ba::match_mode_type mode ) {
+        std::vector<int> retVal;
+        if ( needle.empty () || needle.size () > haystack.size ()) return retVal;
+        for ( std::size_t i = 0; i + needle.size () <= haystack.size (); ) {
+            std::size_t j = 0;
+            while ( j < needle.size () && iequal ( haystack [ i + j ], needle [ j ] ))
+                ++j;
+            if ( j == needle.size ()) {
+                retVal.push_back ( static_cast<int> ( i ));
+                i += mode == ba::match_overlapping ? 1 : needle.size ();
+                }
+            else
+                ++i;
+            }
+        return retVal;
+        }
+
+    template <typename Searcher, typename Str>
+    void check_searcher ( const Searcher &s, const Str &haystack, const Str &needle ) {
+        typedef typename Str::const_iterator iter_type;
+        const std::vector<int> expected = brute_force ( haystack, needle, ba::match_overlapping );
+        const iter_type found = s ( haystack.begin (), haystack.end ());
+        if ( needle.empty ())
+            BOOST_CHECK ( found == haystack.begin () || haystack.empty ());
+        else if ( expected.empty ())
+            BOOST_CHECK ( found == haystack.end ());
+        else
+            BOOST_CHECK_EQUAL ( found - haystack.begin (), expected [ 0 ] );
+
+        for ( int i = 0; i < 2; ++i ) {
+            const ba::match_mode_type mode = i == 0 ? ba::match_overlapping : ba::match_non_overlapping;
+            const std::vector<int> exp_all = brute_force ( haystack, needle, mode );
+            std::vector<iter_type> all;
+            s.find_all ( haystack.begin (), haystack.end (), std::back_inserter ( all ), mode );
+            std::vector<int> offsets;
+            for ( std::size_t j = 0; j < all.size (); ++j )
+                offsets.push_back ( static_cast<int> ( all [ j ] - haystack.begin ()));
+            BOOST_CHECK_EQUAL_COLLECTIONS ( offsets.begin (), offsets.end (), exp_all.begin (), exp_all.end ());
+            }
+        }
+
+    template <typename Str>
+    void check_one ( const Str &haystack, const Str &needle ) {
+        typedef typename Str::const_iterator iter_type;
+        const ba::iboyer_moore<iter_type>          bm  ( needle.begin (), needle.end ());
+        const ba::iboyer_moore_horspool<iter_type> bmh ( needle.begin (), needle.end ());
+        check_searcher ( bm,  haystack, needle );
+        check_searcher ( bmh, haystack, needle );
+
+    //  Copies have their own tables
+        const ba::iboyer_moore<iter_type>          bm2  ( bm );
+        const ba::iboyer_moore_horspool<iter_type> bmh2 ( bmh );
+        check_searcher ( bm2,  haystack, needle );
+        check_searcher ( bmh2, haystack, needle );
+
+        BOOST_CHECK ( ba::iboyer_moore_search ( haystack, needle ) == bm ( haystack.begin (), haystack.end ()));
+        BOOST_CHECK ( ba::iboyer_moore_horspool_search ( haystack.begin (), haystack.end (),
+                        needle.begin (), needle.end ()) == bmh ( haystack.begin (), haystack.end ()));
+        }
+    }
+
+
+BOOST_AUTO_TEST_CASE( test_main )
+{
+    const std::string haystack ( "Content-Type: text/html; CONTENT-LENGTH: 42\r\ncontent-encoding: gzip" );
+    check_one ( haystack, std::string ( "content-" ));
+    check_one ( haystack, std::string ( "CONTENT-length" ));
+    check_one ( haystack, std::string ( "GZIP" ));
+    check_one ( haystack, std::string ( "Content-Language" ));
+    check_one ( haystack, std::string ( "[]{}" ));
+    check_one ( haystack, std::string ());
+    check_one ( std::string (), std::string ( "abc" ));
+    check_one ( std::string ( "aAaAaAaA" ), std::string ( "AAA" ));
+    check_one ( std::string ( "@[`{ AZ az" ), std::string ( "`{" ));
+    check_one ( std::string ( "\xe9t\xc9 \xc9T\xe9" ), std::string ( "\xc9t" ));
+
+    const std::wstring wide ( L"Content-Type: text/html; CONTENT-LENGTH: 42" );
+    check_one ( wide, std::wstring ( L"content-" ));
+    check_one ( wide, std::wstring ( L"Length: 4" ));
+    check_one ( wide, std::wstring ( L"nope" ));
+
+//  The string algorithms use the searcher for case insensitive finds
+    std::string text ( "The quick brown FOX jumps over the lazy fox" );
+    boost::iterator_range<std::string::iterator> r = ba::ifind_first ( text, "fox" );
+    BOOST_CHECK_EQUAL ( r.begin () - text.begin (), 16 );
+    BOOST_CHECK_EQUAL ( r.end () - text.begin (), 19 );
+    BOOST_CHECK ( ba::ifind_first ( text, "cat" ).empty ());
+    BOOST_CHECK ( ba::ifind_first ( text, "" ).empty ());
+    BOOST_CHECK ( ba::icontains ( text, "LAZY" ));
+    BOOST_CHECK ( !ba::icontains ( text, "LAZZY" ));
+    BOOST_CHECK_EQUAL ( ba::ireplace_all_copy ( text, "FoX", "dog" ), "The quick brown dog jumps over the lazy dog" );
+    BOOST_CHECK_EQUAL ( ba::ireplace_all_copy ( std::string ( "aAaAa" ), "aa", "b" ), "bba" );
+
+//  ... and still work for sequences that aren't random access
+    const std::list<char> l ( text.begin (), text.end ());
+    BOOST_CHECK ( ba::icontains ( l, "BROWN" ));
+    BOOST_CHECK_EQUAL ( std::distance ( l.begin (), ba::ifind_first ( l, "Jumps" ).begin ()), 20 );
+}
@@ -0,0 +1,131 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+
+    Testing the DFA-compiled Knuth-Morris-Pratt searcher
+*/
+
+#include <boost/algorithm/searching/knuth_morris_pratt_dfa.hpp>
+
+#include "random_test.hpp"
+
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+#include <vector>
+#include <iterator>
+#include <algorithm>
+
+namespace ba = boost::algorithm;
+
+namespace {
+
+    std::vector<std::string::size_type> brute_force ( const std::string &haystack, const std::string &needle, ba::match_mode_type mode ) {
+        std::vector<std::string::size_type> retVal;
+        if ( needle.empty ()) return retVal;
+        std::string::size_type pos = haystack.find ( needle );
+        while ( pos != std::string::npos ) {
+            retVal.push_back ( pos );
+            pos = haystack.find ( needle, pos + ( mode == ba::match_overlapping ? 1 : needle.size ()));
+            }
+        return retVal;
+        }
+
+    void check_one ( const std::string &haystack, const std::string &needle ) {
+        typedef std::string::const_iterator iter_type;
+        const ba::knuth_morris_pratt_dfa<iter_type> kmp ( needle.begin (), needle.end ());
+        const iter_type expected = std::search ( haystack.begin (), haystack.end (), needle.begin (), needle.end ());
+
+        BOOST_CHECK ( kmp ( haystack.begin (), haystack.end ()) == expected );
+        BOOST_CHECK ( kmp ( haystack ) == expected );
+        BOOST_CHECK ( ba::knuth_morris_pratt_dfa_search ( haystack.begin (), haystack.end (), needle.begin (), needle.end ()) == expected );
+        BOOST_CHECK ( ba::knuth_morris_pratt_dfa_search ( haystack.begin (), haystack.end (), needle ) == expected );
+        BOOST_CHECK ( ba::knuth_morris_pratt_dfa_search ( haystack, needle.begin (), needle.end ()) == expected );
+        BOOST_CHECK ( ba::knuth_morris_pratt_dfa_search ( haystack, needle ) == expected );
+        BOOST_CHECK ( ba::make_knuth_morris_pratt_dfa ( needle ) ( haystack ) == expected );
+
+        for ( int i = 0; i < 2; ++i ) {
+            const ba::match_mode_type mode = i == 0 ? ba::match_overlapping : ba::match_non_overlapping;
+            const std::vector<std::string::size_type> want = brute_force ( haystack, needle, mode );
+            std::vector<iter_type> all;
+            kmp.find_all ( haystack.begin (), haystack.end (), std::back_inserter ( all ), mode );
+            std::vector<std::string::size_type> offsets;
+            for ( std::size_t j = 0; j < all.size (); ++j )
+                offsets.push_back ( all [ j ] - haystack.begin ());
+            BOOST_CHECK_EQUAL_COLLECTIONS ( offsets.begin (), offsets.end (), want.begin (), want.end ());
+            }
+        }
+    }
+
+
+BOOST_AUTO_TEST_CASE( test_main )
+{
+    check_one ( "abababababab", "abab" );
+    check_one ( "abababababab", "bab" );
+    check_one ( "abcabcabdabcabcabcabd", "abcabd" );
+    check_one ( "abcabcabdabcabcabcabd", "" );
+    check_one ( "", "abc" );
+    check_one ( "NOW AN FOWE\220ER ANNMAN THE ANPANMANEND", "ANPANMAN" );
+    check_one ( "NOW AN FOWE\220ER ANNMAN THE ANPANMANEND", "\220ER" );
+    check_one ( "aaaaaaaa", "aaaaaaaaa" );
+    check_one ( "aaaaaaaaa", "aaaaaaaaa" );
+
+    for ( unsigned long seed = 1; seed < 200; ++seed ) {
+        unsigned long s = seed;
+        const unsigned alphabet = 2 + seed % 3;
+        const std::string haystack = make_string ( 300 + seed, alphabet, s );
+        check_one ( haystack, make_string ( 1 + seed % 7, alphabet, s ));
+        check_one ( haystack, haystack.substr ( seed % 100, 1 + seed % 11 ));
+        }
+
+//  Adversarial input for the naive search
+    std::string worst ( 5000, 'a' );
+    check_one ( worst, std::string ( 300, 'a' ) + "b" );
+    check_one ( worst + "b", std::string ( 300, 'a' ) + "b" );
+
+//  Long patterns get the compact table; some get the wide entries
+    unsigned long s = 42;
+    const std::string big = make_string ( 200000, 3, s );
+    const std::string k_sizes [] = { big.substr ( 1000, 600 ), big.substr ( 5000, 70000 ), big.substr ( 0, 66000 ) + "d" };
+    for ( std::size_t i = 0; i < sizeof ( k_sizes ) / sizeof ( k_sizes [ 0 ] ); ++i ) {
+        const ba::knuth_morris_pratt_dfa<std::string::const_iterator> kmp ( k_sizes [ i ].begin (), k_sizes [ i ].end ());
+        BOOST_CHECK ( kmp.compact ());
+        check_one ( big, k_sizes [ i ] );
+        }
+
+    const std::string short_pattern ( "abc" );
+    BOOST_CHECK ( !ba::make_knuth_morris_pratt_dfa ( short_pattern ).compact ());
+
+//  Long patterns with every byte value would make huge tables, so only the
+//  shallow states get rows. Periodic patterns make the search follow long
+//  chains of failure links from the deep states.
+    std::string bytes ( 300000, ' ' );
+    for ( std::size_t i = 0; i < bytes.size (); ++i )
+        bytes [ i ] = static_cast<char> ( next_random ( s ) % 256 );
+    const std::string period = bytes.substr ( 7000, 9000 );
+    std::string periodic;
+    for ( int i = 0; i < 8; ++i )
+        periodic += period;
+    const std::string k_deep [] = { bytes.substr ( 250000, 20000 ), bytes.substr ( 100, 70000 ),
+                                    period + period + period, period + period + period.substr ( 0, 8999 ) + "x" };
+    for ( std::size_t i = 0; i < sizeof ( k_deep ) / sizeof ( k_deep [ 0 ] ); ++i ) {
+        const ba::knuth_morris_pratt_dfa<std::string::const_iterator> kmp ( k_deep [ i ].begin (), k_deep [ i ].end ());
+        BOOST_CHECK ( kmp.compact () && kmp.bounded ());
+        check_one ( bytes, k_deep [ i ] );
+        check_one ( periodic, k_deep [ i ] );
+        }
+    BOOST_CHECK ( !ba::knuth_morris_pratt_dfa<std::string::const_iterator> ( k_sizes [ 1 ].begin (), k_sizes [ 1 ].end ()).bounded ());
+
+//  Unsigned bytes
+    std::vector<unsigned char> uhaystack, uneedle;
+    for ( int i = 0; i < 1000; ++i )
+        uhaystack.push_back ( static_cast<unsigned char> ( i * 7 ));
+    uneedle.assign ( uhaystack.begin () + 500, uhaystack.begin () + 520 );
+    BOOST_CHECK ( ba::knuth_morris_pratt_dfa_search ( uhaystack, uneedle ) ==
+                  std::search ( uhaystack.begin (), uhaystack.end (), uneedle.begin (), uneedle.end ()));
+}
@@ -0,0 +1,110 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+
+    Testing the Knuth-Morris-Pratt searcher on input iterators
+*/
+
+#include <boost/algorithm/searching/knuth_morris_pratt.hpp>
+
+#include "random_test.hpp"
+
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+#include <vector>
+#include <sstream>
+#include <iterator>
+#include <algorithm>
+
+namespace ba = boost::algorithm;
+
+namespace {
+
+    typedef std::istreambuf_iterator<char> stream_iterator;
+
+    std::vector<boost::uintmax_t> brute_force ( const std::string &haystack, const std::string &needle, ba::match_mode_type mode ) {
+        std::vector<boost::uintmax_t> retVal;
+        if ( needle.empty ()) return retVal;
+        std::string::size_type pos = haystack.find ( needle );
+        while ( pos != std::string::npos ) {
+            retVal.push_back ( pos );
+            pos = haystack.find ( needle, pos + ( mode == ba::match_overlapping ? 1 : needle.size ()));
+            }
+        return retVal;
+        }
+
+    void check_one ( const std::string &haystack, const std::string &needle ) {
+        const ba::knuth_morris_pratt<std::string::const_iterator> kmp ( needle.begin (), needle.end ());
+        const std::string::size_type k_expected = haystack.find ( needle );
+
+        {
+            std::istringstream is ( haystack );
+            const boost::optional<boost::uintmax_t> found = kmp.search_stream ( stream_iterator ( is ), stream_iterator ());
+            if ( k_expected == std::string::npos )
+                BOOST_CHECK ( !found );
+            else {
+                BOOST_REQUIRE ( found );
+                BOOST_CHECK_EQUAL ( *found, k_expected );
+            //  The stream is left just after the match
+                if ( !needle.empty ()) {
+                    const std::string rest (( stream_iterator ( is )), stream_iterator ());
+                    BOOST_CHECK_EQUAL ( rest, haystack.substr ( k_expected + needle.size ()));
+                    }
+                }
+        }
+
+        {
+            std::istringstream is ( haystack );
+            const boost::optional<boost::uintmax_t> found = ba::knuth_morris_pratt_search_stream ( is, needle );
+            BOOST_CHECK_EQUAL ( found ? *found : std::string::npos, k_expected );
+        }
+
+        for ( int i = 0; i < 2; ++i ) {
+            const ba::match_mode_type mode = i == 0 ? ba::match_overlapping : ba::match_non_overlapping;
+            const std::vector<boost::uintmax_t> expected = brute_force ( haystack, needle, mode );
+            std::istringstream is ( haystack );
+            std::vector<boost::uintmax_t> all;
+            kmp.find_all_stream ( stream_iterator ( is ), stream_iterator (), std::back_inserter ( all ), mode );
+            BOOST_CHECK_EQUAL_COLLECTIONS ( all.begin (), all.end (), expected.begin (), expected.end ());
+            }
+        }
+    }
+
+
+BOOST_AUTO_TEST_CASE( test_main )
+{
+    check_one ( "abababababab", "abab" );
+    check_one ( "abababababab", "bab" );
+    check_one ( "abcabcabdabcabcabcabd", "abcabd" );
+    check_one ( "abcabcabdabcabcabcabd", "" );
+    check_one ( "", "abc" );
+    check_one ( "NOW AN FOWE\220ER ANNMAN THE ANPANMANEND", "ANPANMAN" );
+    check_one ( "aaaaaaaa", "aaaaaaaaa" );
+
+    for ( unsigned long seed = 1; seed < 200; ++seed ) {
+        unsigned long s = seed;
+        const unsigned alphabet = 2 + seed % 3;
+        const std::string haystack = make_string ( 300 + seed, alphabet, s );
+        check_one ( haystack, make_string ( 1 + seed % 7, alphabet, s ));
+        check_one ( haystack, haystack.substr ( seed % 100, 1 + seed % 11 ));
+        }
+
+//  Elements that aren't characters: a stream of numbers
+    std::istringstream is ( "1 2 3 1 2 3 1 2 4 5 1 2 4" );
+    std::vector<int> pattern;
+    pattern.push_back ( 1 );
+    pattern.push_back ( 2 );
+    pattern.push_back ( 4 );
+    std::vector<boost::uintmax_t> all;
+    ba::make_knuth_morris_pratt ( pattern ).find_all_stream (
+        std::istream_iterator<int> ( is ), std::istream_iterator<int> (), std::back_inserter ( all ));
+    BOOST_REQUIRE_EQUAL ( all.size (), 2U );
+    BOOST_CHECK_EQUAL ( all [ 0 ], 6U );
+    BOOST_CHECK_EQUAL ( all [ 1 ], 10U );
+}
@@ -0,0 +1,88 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+
+    Testing the parallel searches
+*/
+
+#include <boost/algorithm/searching/parallel_search.hpp>
+#include <boost/algorithm/searching/boyer_moore.hpp>
+#include <boost/algorithm/searching/boyer_moore_horspool.hpp>
+#include <boost/algorithm/searching/knuth_morris_pratt.hpp>
+
+#include "random_test.hpp"
+
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+#include <vector>
+#include <iterator>
+
+namespace ba = boost::algorithm;
+
+namespace {
+
+    template <typename Searcher>
+    void check_searcher ( const std::string &haystack, const Searcher &searcher, unsigned threads ) {
+        typedef std::string::const_iterator iter_type;
+        const iter_type first = haystack.begin ();
+        const iter_type last  = haystack.end ();
+
+        BOOST_CHECK ( ba::parallel_search ( searcher, first, last, threads ) == searcher ( first, last ));
+
+        for ( int i = 0; i < 2; ++i ) {
+            const ba::match_mode_type mode = i == 0 ? ba::match_overlapping : ba::match_non_overlapping;
+            std::vector<iter_type> expected, found;
+            searcher.find_all ( first, last, std::back_inserter ( expected ), mode );
+            ba::parallel_find_all ( searcher, first, last, std::back_inserter ( found ), mode, threads );
+            BOOST_CHECK_EQUAL ( found.size (), expected.size ());
+            BOOST_CHECK ( found == expected );
+            }
+        }
+
+    void check_one ( const std::string &haystack, const std::string &needle ) {
+        typedef std::string::const_iterator iter_type;
+        const ba::boyer_moore<iter_type>          bm  ( needle.begin (), needle.end ());
+        const ba::boyer_moore_horspool<iter_type> bmh ( needle.begin (), needle.end ());
+        const ba::knuth_morris_pratt<iter_type>   kmp ( needle.begin (), needle.end ());
+        const unsigned threads [] = { 0, 1, 2, 3, 8 };
+        for ( std::size_t i = 0; i < sizeof ( threads ) / sizeof ( threads [ 0 ] ); ++i ) {
+            check_searcher ( haystack, bm,  threads [ i ] );
+            check_searcher ( haystack, bmh, threads [ i ] );
+            check_searcher ( haystack, kmp, threads [ i ] );
+            }
+        }
+    }
+
+
+BOOST_AUTO_TEST_CASE( test_main )
+{
+    unsigned long seed = 1;
+    std::string haystack = make_string ( 3 * 1024 * 1024, 4, seed );
+
+//  Small patterns occur everywhere; long ones not at all
+    check_one ( haystack, "abc" );
+    check_one ( haystack, "aaaa" );
+    check_one ( haystack, make_string ( 40, 4, seed ));
+    check_one ( haystack, "" );
+
+//  A match that straddles the boundary between two chunks, and one at the end
+    std::string marked ( 3 * 1024 * 1024, 'x' );
+    const std::string needle ( "needle in a haystack" );
+    marked.replace ( 1024 * 1024 - 5, needle.size (), needle );
+    check_one ( marked, needle );
+    marked.replace ( marked.size () - needle.size (), needle.size (), needle );
+    check_one ( marked, needle );
+    check_one ( std::string ( 2 * 1024 * 1024, 'x' ), needle );
+
+//  Periodic corpus
+    check_one ( std::string ( 1024 * 1024, 'a' ), std::string ( 7, 'a' ));
+
+//  Too small to be worth splitting
+    check_one ( "abcabcabdabcabcabcabd", "abcabd" );
+}
@@ -0,0 +1,41 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+#ifndef RANDOM_TEST_H
+#define RANDOM_TEST_H
+
+/*
+    Deterministic pseudo-random data for constructing test cases. The same
+    seed always gives the same sequence, on every platform, so that a
+    failure can be reproduced.
+*/
+
+#include <cstddef>
+#include <string>
+
+//  A small linear congruential generator; returns values in [0, 32768)
+inline unsigned long next_random ( unsigned long &state ) {
+    state = state * 1103515245UL + 12345UL;
+    return ( state >> 16 ) & 0x7FFF;
+    }
+
+//  'size' elements, each one of the first 'alphabet' lower case letters
+template <typename String>
+String make_string ( std::size_t size, unsigned alphabet, unsigned long &seed ) {
+    String retVal;
+    for ( std::size_t i = 0; i < size; ++i )
+        retVal.push_back ( static_cast<typename String::value_type> ( 'a' + next_random ( seed ) % alphabet ));
+    return retVal;
+    }
+
+inline std::string make_string ( std::size_t size, unsigned alphabet, unsigned long &seed ) {
+    return make_string<std::string> ( size, alphabet, seed );
+    }
+
+#endif  // RANDOM_TEST_H
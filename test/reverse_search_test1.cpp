@@ -0,0 +1,145 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+
+    Testing the right-to-left searchers, and find_last, which uses them
+*/
+
+#include <boost/algorithm/searching/reverse_search.hpp>
+#include <boost/algorithm/string/find.hpp>
+#include <boost/algorithm/string/replace.hpp>
+#include <boost/algorithm/string/finder.hpp>
+
+#include "random_test.hpp"
+
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+#include <vector>
+#include <list>
+#include <deque>
+#include <algorithm>
+#include <iterator>
+
+#ifndef BOOST_NO_CXX11_HDR_FORWARD_LIST
+#include <forward_list>
+#endif
+
+namespace ba = boost::algorithm;
+
+namespace {
+
+//  The start of the last match, or haystack.size () if there isn't one
+    std::size_t last_match ( const std::string &haystack, const std::string &needle ) {
+        if ( needle.empty ()) return haystack.size ();
+        const std::string::size_type pos = haystack.rfind ( needle );
+        return pos == std::string::npos ? haystack.size () : pos;
+        }
+
+    void check_one ( const std::string &haystack, const std::string &needle ) {
+        typedef std::string::const_iterator iter_type;
+        const std::size_t expected = last_match ( haystack, needle );
+
+        const ba::reverse_boyer_moore<iter_type>          rbm  ( needle.begin (), needle.end ());
+        const ba::reverse_boyer_moore_horspool<iter_type> rbmh ( needle.begin (), needle.end ());
+        BOOST_CHECK_EQUAL ( rbm  ( haystack.begin (), haystack.end ()) - haystack.begin (), expected );
+        BOOST_CHECK_EQUAL ( rbmh ( haystack.begin (), haystack.end ()) - haystack.begin (), expected );
+        BOOST_CHECK_EQUAL ( ba::reverse_boyer_moore_search ( haystack, needle ) - haystack.begin (), expected );
+        BOOST_CHECK_EQUAL ( ba::reverse_boyer_moore_horspool_search ( haystack, needle ) - haystack.begin (), expected );
+        BOOST_CHECK_EQUAL ( ba::reverse_boyer_moore_horspool_search (
+            haystack.begin (), haystack.end (), needle.begin (), needle.end ()) - haystack.begin (), expected );
+
+    //  find_last goes through last_finderF
+        if ( !needle.empty ()) {
+            const boost::iterator_range<iter_type> r = ba::find_last ( haystack, needle );
+            if ( expected == haystack.size ())
+                BOOST_CHECK ( r.empty ());
+            else {
+                BOOST_CHECK_EQUAL ( static_cast<std::size_t> ( r.begin () - haystack.begin ()), expected );
+                BOOST_CHECK_EQUAL ( static_cast<std::size_t> ( r.size ()), needle.size ());
+                }
+            }
+        }
+    }
+
+
+BOOST_AUTO_TEST_CASE( test_reverse_search )
+{
+    check_one ( "", "" );
+    check_one ( "abc", "" );
+    check_one ( "", "abc" );
+    check_one ( "abc", "abcd" );
+    check_one ( "abc", "abc" );
+    check_one ( "abcabcabc", "abc" );
+    check_one ( "abcabcabc", "a" );
+    check_one ( "abcabcabc", "c" );
+    check_one ( "abcabcabc", "q" );
+    check_one ( "aaaaaaaaaa", "aaa" );
+    check_one ( "baaaaaaaaa", "ba" );
+    check_one ( "the quick brown fox jumps over the lazy dog", "the" );
+
+    unsigned long seed = 17;
+    const std::size_t k_lengths [] = { 1, 2, 3, 7, 20, 100 };
+    for ( unsigned alphabet = 2; alphabet <= 26; alphabet += 6 )
+        for ( std::size_t i = 0; i < sizeof ( k_lengths ) / sizeof ( k_lengths [ 0 ] ); ++i ) {
+            const std::string haystack = make_string ( 2000, alphabet, seed );
+            check_one ( haystack, haystack.substr ( 300, k_lengths [ i ] ));
+            check_one ( haystack, make_string ( k_lengths [ i ], alphabet, seed ));
+            }
+}
+
+BOOST_AUTO_TEST_CASE( test_find_last )
+{
+//  Case insensitive
+    const std::string str ( "123abcxXxabcXxXabc321" );
+    boost::iterator_range<std::string::const_iterator> r = ba::ifind_last ( str, "XXx" );
+    BOOST_CHECK_EQUAL ( r.begin () - str.begin (), 12 );
+    BOOST_CHECK_EQUAL ( r.end ()   - str.begin (), 15 );
+    r = ba::ifind_last ( str, "ABC" );
+    BOOST_CHECK_EQUAL ( r.begin () - str.begin (), 15 );
+    BOOST_CHECK ( ba::ifind_last ( str, "abcd" ).empty ());
+
+    const std::wstring wstr ( L"One, two, ONE, three" );
+    const boost::iterator_range<std::wstring::const_iterator> wr = ba::ifind_last ( wstr, L"one" );
+    BOOST_CHECK_EQUAL ( wr.begin () - wstr.begin (), 10 );
+
+//  A delimiter at the very start and the very end
+    const std::string delims ( ";a;b;" );
+    BOOST_CHECK_EQUAL ( ba::find_last ( delims, ";" ).begin () - delims.begin (), 4 );
+    BOOST_CHECK_EQUAL ( ba::find_last ( delims, ";a" ).begin () - delims.begin (), 0 );
+
+//  Overlapping matches, through each kind of iterator
+    const std::string aaa ( "xaaay" );
+    BOOST_CHECK_EQUAL ( ba::find_last ( aaa, "aa" ).begin () - aaa.begin (), 2 );
+    const std::deque<char> dq ( aaa.begin (), aaa.end ());
+    BOOST_CHECK_EQUAL ( ba::find_last ( dq, "aa" ).begin () - dq.begin (), 2 );
+    const std::list<char> li ( aaa.begin (), aaa.end ());
+    BOOST_CHECK ( ba::find_last ( li, "aa" ).begin () == ++++li.begin ());
+#ifndef BOOST_NO_CXX11_HDR_FORWARD_LIST
+//  Forward only: the search restarts just after the start of each match,
+//  not after its end, so the overlapping last match is found
+    const std::forward_list<char> fl ( aaa.begin (), aaa.end ());
+    BOOST_CHECK_EQUAL ( std::distance ( fl.begin (), ba::find_last ( fl, "aa" ).begin ()), 2 );
+    BOOST_CHECK_EQUAL ( std::distance ( fl.begin (), ba::find_last ( fl, "a" ).begin ()), 3 );
+    BOOST_CHECK_EQUAL ( std::distance ( fl.begin (), ba::ifind_last ( fl, "AAA" ).begin ()), 1 );
+    BOOST_CHECK ( ba::find_last ( fl, "ax" ).empty ());
+#endif
+
+//  replace_last
+    std::string s ( "a.b.c.d" );
+    ba::replace_last ( s, ".", "/" );
+    BOOST_CHECK_EQUAL ( s, "a.b.c/d" );
+    ba::ireplace_last ( s, "B", "X" );
+    BOOST_CHECK_EQUAL ( s, "a.X.c/d" );
+
+//  Not char: the search falls back to the backward scan
+    int nums [] = { 1, 2, 3, 1, 2, 3, 4 };
+    int pat  [] = { 1, 2 };
+    const std::vector<int> v ( nums, nums + 7 );
+    BOOST_CHECK_EQUAL ( ba::find_last ( v, pat ).begin () - v.begin (), 3 );
+}
@@ -0,0 +1,182 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+
+    Testing searching the contents of files
+*/
+
+#include <boost/algorithm/searching/search_file.hpp>
+#include <boost/algorithm/searching/boyer_moore.hpp>
+#include <boost/algorithm/searching/boyer_moore_horspool.hpp>
+#include <boost/algorithm/searching/knuth_morris_pratt.hpp>
+
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <iterator>
+
+#if defined(__linux__)
+#include <csignal>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#endif
+
+namespace ba = boost::algorithm;
+
+namespace {
+
+    const char *k_file_name = "search_file_test1.tmp";
+
+    void write_file ( const std::string &contents ) {
+        std::ofstream out ( k_file_name, std::ios::binary );
+        out << contents;
+        }
+
+    std::vector<boost::uintmax_t> brute_force ( const std::string &haystack, const std::string &needle, ba::match_mode_type mode ) {
+        std::vector<boost::uintmax_t> retVal;
+        std::string::size_type pos = haystack.find ( needle );
+        while ( pos != std::string::npos ) {
+            retVal.push_back ( pos );
+            pos = haystack.find ( needle, pos + ( mode == ba::match_overlapping ? 1 : needle.size ()));
+            }
+        return retVal;
+        }
+
+    template <typename Searcher>
+    void check_one ( const std::string &haystack, const std::string &needle, const Searcher &searcher ) {
+        write_file ( haystack );
+
+        const std::string::size_type pos = haystack.find ( needle );
+        const boost::optional<boost::uintmax_t> found = ba::search_file ( k_file_name, searcher );
+        if ( pos == std::string::npos )
+            BOOST_CHECK ( !found );
+        else {
+            BOOST_REQUIRE ( found );
+            BOOST_CHECK_EQUAL ( *found, pos );
+            }
+
+        for ( int i = 0; i < 2; ++i ) {
+            const ba::match_mode_type mode = i == 0 ? ba::match_overlapping : ba::match_non_overlapping;
+            const std::vector<boost::uintmax_t> expected = brute_force ( haystack, needle, mode );
+            std::vector<boost::uintmax_t> all;
+            ba::find_all_in_file ( std::string ( k_file_name ), searcher, std::back_inserter ( all ), mode );
+            BOOST_CHECK_EQUAL_COLLECTIONS ( all.begin (), all.end (), expected.begin (), expected.end ());
+            }
+        }
+
+#if defined(__linux__)
+//  Write 'contents' to a named pipe from another process, and search it
+    const char *k_pipe_name = "search_file_test1.fifo";
+
+    template <typename Searcher>
+    void check_pipe ( const std::string &haystack, const std::string &needle, const Searcher &searcher ) {
+        for ( int i = 0; i < 3; ++i ) {
+            const ba::match_mode_type mode = i == 1 ? ba::match_non_overlapping : ba::match_overlapping;
+            ::unlink ( k_pipe_name );
+            BOOST_REQUIRE ( ::mkfifo ( k_pipe_name, 0600 ) == 0 );
+            const pid_t child = ::fork ();
+            BOOST_REQUIRE ( child >= 0 );
+            if ( child == 0 ) {
+                {
+                std::ofstream out ( k_pipe_name, std::ios::binary );
+                out << haystack;
+                }
+                ::_exit ( 0 );
+                }
+
+            if ( i < 2 ) {
+                const std::vector<boost::uintmax_t> expected = brute_force ( haystack, needle, mode );
+                std::vector<boost::uintmax_t> all;
+                ba::find_all_in_file ( k_pipe_name, searcher, std::back_inserter ( all ), mode );
+                BOOST_CHECK_EQUAL_COLLECTIONS ( all.begin (), all.end (), expected.begin (), expected.end ());
+                }
+            else {
+            //  Stops at the first match; drop the rest so that the writer can finish
+                const std::string::size_type pos = haystack.find ( needle );
+                const boost::optional<boost::uintmax_t> found = ba::search_file ( k_pipe_name, searcher );
+                if ( pos == std::string::npos )
+                    BOOST_CHECK ( !found );
+                else {
+                    BOOST_REQUIRE ( found );
+                    BOOST_CHECK_EQUAL ( *found, pos );
+                    }
+                }
+            ::kill ( child, SIGKILL );
+            ::waitpid ( child, NULL, 0 );
+            ::unlink ( k_pipe_name );
+            }
+        }
+
+    void check_pipe ( const std::string &haystack, const std::string &needle ) {
+        typedef std::string::const_iterator iter_type;
+        check_pipe ( haystack, needle, ba::boyer_moore<iter_type>          ( needle.begin (), needle.end ()));
+        check_pipe ( haystack, needle, ba::boyer_moore_horspool<iter_type> ( needle.begin (), needle.end ()));
+        check_pipe ( haystack, needle, ba::knuth_morris_pratt<iter_type>   ( needle.begin (), needle.end ()));
+        }
+#endif
+
+    void check_one ( const std::string &haystack, const std::string &needle ) {
+        typedef std::string::const_iterator iter_type;
+        check_one ( haystack, needle, ba::boyer_moore<iter_type>          ( needle.begin (), needle.end ()));
+        check_one ( haystack, needle, ba::boyer_moore_horspool<iter_type> ( needle.begin (), needle.end ()));
+        check_one ( haystack, needle, ba::knuth_morris_pratt<iter_type>   ( needle.begin (), needle.end ()));
+        }
+    }
+
+
+BOOST_AUTO_TEST_CASE( test_main )
+{
+    check_one ( "", "abc" );
+    check_one ( "abcabcabdabcabcabcabd", "abcabd" );
+    check_one ( "aaaaaaaaaa", "aaa" );
+    check_one ( "NOW AN FOWE\220ER ANNMAN THE ANPANMANEND", "ANPANMAN" );
+    check_one ( "NOW AN FOWE\220ER ANNMAN THE ANPANMANEND", "ANPANMEN" );
+
+//  Bigger than a page, and bigger than the read block size
+    std::string big ( 200000, 'x' );
+    big.replace ( 4095, 5, "needl" );
+    big.replace ( 65534, 6, "needle" );
+    big.replace ( big.size () - 6, 6, "needle" );
+    check_one ( big, "needle" );
+    std::remove ( k_file_name );
+
+    const std::string needle ( "Name:" );
+#if defined(__linux__)
+//  A file that can't be mapped, and has to be read
+    ba::boyer_moore<std::string::const_iterator> bm ( needle.begin (), needle.end ());
+    const boost::optional<boost::uintmax_t> found = ba::search_file ( "/proc/self/status", bm );
+    BOOST_REQUIRE ( found );
+    BOOST_CHECK_EQUAL ( *found, 0U );
+
+//  An endless source: the search has to stop at the first match
+    const std::string zeros ( 3, '\0' );
+    const boost::optional<boost::uintmax_t> zero = ba::search_file ( "/dev/zero",
+                ba::boyer_moore_horspool<std::string::const_iterator> ( zeros.begin (), zeros.end ()));
+    BOOST_REQUIRE ( zero );
+    BOOST_CHECK_EQUAL ( *zero, 0U );
+
+//  A pipe, read a block at a time, with matches across the blocks
+    std::string big_pipe ( 300000, 'x' );
+    big_pipe.replace ( 65534, 6, "needle" );
+    big_pipe.replace ( 131070, 6, "needle" );
+    big_pipe.replace ( big_pipe.size () - 6, 6, "needle" );
+    check_pipe ( big_pipe, "needle" );
+    check_pipe ( "aaaaaaaaaa", "aaa" );
+    check_pipe ( "", "abc" );
+#endif
+
+//  A file that isn't there
+    BOOST_CHECK_THROW ( ba::search_file ( "no_such_file.tmp",
+                ba::knuth_morris_pratt<std::string::const_iterator> ( needle.begin (), needle.end ())),
+                ba::search_file_error );
+}
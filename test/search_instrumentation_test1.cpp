@@ -0,0 +1,120 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+
+    Testing the instrumentation policies of the searchers
+*/
+
+#include <boost/algorithm/searching/boyer_moore.hpp>
+#include <boost/algorithm/searching/boyer_moore_horspool.hpp>
+#include <boost/algorithm/searching/knuth_morris_pratt.hpp>
+#include <boost/algorithm/searching/instrumentation.hpp>
+
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+
+#include <boost/type_traits/is_empty.hpp>
+
+#include <string>
+#include <vector>
+#include <iterator>
+#include <algorithm>
+
+#ifndef BOOST_NO_CXX11_HDR_THREAD
+#include <thread>
+#endif
+
+namespace ba = boost::algorithm;
+
+namespace {
+    typedef std::string::const_iterator iter_type;
+    typedef ba::detail::BM_traits<iter_type> traits_type;
+    typedef ba::boyer_moore<iter_type, traits_type, ba::search_counters>          bm_type;
+    typedef ba::boyer_moore_horspool<iter_type, traits_type, ba::search_counters> bmh_type;
+    typedef ba::knuth_morris_pratt<iter_type, std::allocator<char>, ba::search_counters> kmp_type;
+
+    template <typename Searcher>
+    void check_counts ( const Searcher &s, boost::uintmax_t comparisons, boost::uintmax_t shifts,
+                        boost::uintmax_t shift_total, boost::uintmax_t verifications, boost::uintmax_t matches ) {
+        const ba::search_counters &c = s.instrumentation ();
+        BOOST_CHECK_EQUAL ( c.comparisons (),   comparisons );
+        BOOST_CHECK_EQUAL ( c.shifts (),        shifts );
+        BOOST_CHECK_EQUAL ( c.shift_total (),   shift_total );
+        BOOST_CHECK_EQUAL ( c.verifications (), verifications );
+        BOOST_CHECK_EQUAL ( c.matches (),       matches );
+        }
+    }
+
+
+BOOST_AUTO_TEST_CASE( test_main )
+{
+    BOOST_STATIC_ASSERT (( boost::is_empty<ba::no_instrumentation>::value ));
+
+    const std::string haystack ( "xxxxabc" );
+    const std::string needle   ( "abc" );
+
+//  Counted by hand; the vectorized search is not used when counting
+    bmh_type bmh ( needle.begin (), needle.end ());
+    BOOST_CHECK ( bmh ( haystack ) == haystack.begin () + 4 );
+    check_counts ( bmh, 5, 2, 4, 3, 1 );
+    BOOST_CHECK_EQUAL ( bmh.instrumentation ().average_shift (), 2.0 );
+
+    bm_type bm ( needle.begin (), needle.end ());
+    BOOST_CHECK ( bm ( haystack ) == haystack.begin () + 4 );
+    check_counts ( bm, 5, 2, 4, 3, 1 );
+
+    kmp_type kmp ( needle.begin (), needle.end ());
+    BOOST_CHECK ( kmp ( haystack ) == haystack.begin () + 4 );
+    check_counts ( kmp, 7, 4, 4, 0, 1 );
+
+//  The counts accumulate until they are reset
+    BOOST_CHECK ( kmp ( haystack ) == haystack.begin () + 4 );
+    check_counts ( kmp, 14, 8, 8, 0, 2 );
+    kmp.instrumentation ().reset ();
+    check_counts ( kmp, 0, 0, 0, 0, 0 );
+
+//  find_all counts every match, and so do the stream functions
+    const std::string corpus ( "abcabcxabcabc" );
+    std::vector<iter_type> found;
+    bmh.instrumentation ().reset ();
+    bmh.find_all ( corpus.begin (), corpus.end (), std::back_inserter ( found ));
+    BOOST_CHECK_EQUAL ( found.size (), 4U );
+    BOOST_CHECK_EQUAL ( bmh.instrumentation ().matches (), 4U );
+    BOOST_CHECK_GE ( bmh.instrumentation ().verifications (), 4U );
+
+    found.clear ();
+    bm.instrumentation ().reset ();
+    bm.find_all ( corpus.begin (), corpus.end (), std::back_inserter ( found ));
+    BOOST_CHECK_EQUAL ( bm.instrumentation ().matches (), 4U );
+
+    std::vector<boost::uintmax_t> offsets;
+    kmp.find_all_stream ( corpus.begin (), corpus.end (), std::back_inserter ( offsets ));
+    BOOST_CHECK_EQUAL ( offsets.size (), 4U );
+    BOOST_CHECK_EQUAL ( kmp.instrumentation ().matches (), 4U );
+    BOOST_CHECK_GE ( kmp.instrumentation ().comparisons (), corpus.size ());
+
+//  A searcher without instrumentation behaves as before
+    const ba::boyer_moore_horspool<iter_type> plain ( needle.begin (), needle.end ());
+    BOOST_CHECK ( plain ( haystack ) == haystack.begin () + 4 );
+
+#if !defined(BOOST_NO_CXX11_HDR_ATOMIC) && !defined(BOOST_NO_CXX11_HDR_THREAD)
+//  One searcher, shared between threads
+    typedef ba::boyer_moore_horspool<iter_type, traits_type, ba::atomic_search_counters> shared_type;
+    const shared_type shared ( needle.begin (), needle.end ());
+    std::vector<std::thread> threads;
+    for ( int i = 0; i < 4; ++i )
+        threads.push_back ( std::thread ( [&shared, &corpus] () {
+            for ( int j = 0; j < 1000; ++j ) {
+                std::vector<iter_type> all;
+                shared.find_all ( corpus.begin (), corpus.end (), std::back_inserter ( all ));
+                }
+            }));
+    for ( std::size_t i = 0; i < threads.size (); ++i )
+        threads [ i ].join ();
+    BOOST_CHECK_EQUAL ( shared.instrumentation ().matches (), 4U * 4000U );
+#endif
+}
@@ -14,53 +14,39 @@
 #define BOOST_TEST_MAIN
 #include <boost/test/unit_test.hpp>
 
-#include <ctime>        // for clock_t
 #include <iostream>
 #include <fstream>
-#include <iomanip>
 #include <algorithm>
 #include <vector>
 #include <string>
 
 typedef std::vector<std::string> vec;
-#define NUM_TRIES   100
-
-#define runOne(call, refDiff)   { \
-    std::clock_t bTime, eTime;                              \
-    bTime = std::clock ();                                  \
-    for ( i = 0; i < NUM_TRIES; ++i ) {                     \
-        res = boost::algorithm::call                        \
-            ( haystack.begin (), haystack.end (),           \
-                        needle.begin (), needle.end ());    \
-        if ( res != exp ) {                                 \
-            std::cout << "On run # " << i << " expected "   \
-                << exp - haystack.begin () << " got "       \
-                << res - haystack.begin () << std::endl;    \
-            throw std::runtime_error                        \
-                ( "Unexpected result from " #call );        \
-            }                                               \
+#define runOne(call)    {                                   \
+    res = boost::algorithm::call                            \
+        ( haystack.begin (), haystack.end (),               \
+                    needle.begin (), needle.end ());        \
+    if ( res != exp ) {                                     \
+        std::cout << "Expected "                            \
+            << exp - haystack.begin () << " got "           \
+            << res - haystack.begin () << std::endl;        \
+        throw std::runtime_error                            \
+            ( "Unexpected result from " #call );            \
         }                                                   \
-    eTime = std::clock ();                                  \
-    printRes ( #call, eTime - bTime, refDiff ); }
-    
-#define runObject(obj, refDiff) { \
-    std::clock_t bTime, eTime;                              \
-    bTime = std::clock ();                                  \
+    }
+
+#define runObject(obj)  {                                   \
     boost::algorithm::obj <vec::const_iterator>             \
                 s_o ( needle.begin (), needle.end ());      \
-    for ( i = 0; i < NUM_TRIES; ++i ) {                     \
-        res = s_o ( haystack.begin (), haystack.end ());    \
-        if ( res != exp ) {                                 \
-            std::cout << "On run # " << i << " expected "   \
-            << exp - haystack.begin () << " got "           \
-            << res - haystack.begin () << std::endl;        \
-            throw std::runtime_error                        \
-            ( "Unexpected result from " #obj " object" );   \
-            }                                               \
+    res = s_o ( haystack.begin (), haystack.end ());        \
+    if ( res != exp ) {                                     \
+        std::cout << "Expected "                            \
+        << exp - haystack.begin () << " got "               \
+        << res - haystack.begin () << std::endl;            \
+        throw std::runtime_error                            \
+        ( "Unexpected result from " #obj " object" );       \
         }                                                   \
-    eTime = std::clock ();                                  \
-    printRes ( #obj " object", eTime - bTime, refDiff ); }
-    
+    }
+
 
 namespace {
 
@@ -74,22 +60,7 @@ namespace {
         return retVal;
         }
     
-    void printRes ( const char *prompt, unsigned long diff, unsigned long stdDiff ) {
-        std::cout 
-            << std::setw(34) << prompt << " "
-            << std::setw(6)  << (  1.0 * diff) / CLOCKS_PER_SEC << " seconds\t"
-            << std::setw(5)  << (100.0 * diff) / stdDiff << "% \t" 
-            << std::setw(12) << diff;
-        if ( diff > stdDiff ) 
-            std::cout << " !!";
-        std::cout << std::endl;
-        }
-    
     void check_one ( const vec &haystack, const vec &needle, int expected ) {
-        std::size_t i;
-        std::clock_t sTime;
-        unsigned long stdDiff;
-        
         vec::const_iterator res;
         vec::const_iterator exp;        // the expected result
         
@@ -105,24 +76,12 @@ namespace {
         std::cout << "Pattern is " << needle.size ()   << " entries long" << std::endl;
         std::cout << "Corpus  is " << haystack.size () << " entries long" << std::endl;
 
-    //  First, the std library search
-        sTime = std::clock ();
-        for ( i = 0; i < NUM_TRIES; ++i ) {
-            res = std::search ( haystack.begin (), haystack.end (), needle.begin (), needle.end ());
-            if ( res != exp ) {
-                std::cout << "On run # " << i << " expected " << exp - haystack.begin () << " got " << res - haystack.begin () << std::endl;
-                throw std::runtime_error ( "Unexpected result from std::search" );
-                }
-            }
-        stdDiff = std::clock () - sTime;
-        printRes ( "std::search", stdDiff, stdDiff );
-
-        runOne    ( boyer_moore_search,          stdDiff );
-        runObject ( boyer_moore,                 stdDiff );
-        runOne    ( boyer_moore_horspool_search, stdDiff );
-        runObject ( boyer_moore_horspool,        stdDiff );
-        runOne    ( knuth_morris_pratt_search,   stdDiff );
-        runObject ( knuth_morris_pratt,          stdDiff );
+        runOne    ( boyer_moore_search );
+        runObject ( boyer_moore );
+        runOne    ( boyer_moore_horspool_search );
+        runObject ( boyer_moore_horspool );
+        runOne    ( knuth_morris_pratt_search );
+        runObject ( knuth_morris_pratt );
         }
     }
 
@@ -134,7 +93,6 @@ BOOST_AUTO_TEST_CASE( test_main )
     vec p1n = ReadFromFile ( "search_test_data/0002n.pat" );
     vec p1f = ReadFromFile ( "search_test_data/0002f.pat" );
 
-    std::cout << std::ios::fixed << std::setprecision(4);
 //  std::cout << "Corpus is " << c1.size () << " entries long\n";
     std::cout << "--- Beginning ---" << std::endl;
     check_one ( c1, p1b, 0 );       //  Find it at position zero
@@ -0,0 +1,92 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+
+    Testing the vectorized Boyer-Moore-Horspool path for byte corpora
+*/
+
+#include <boost/algorithm/searching/boyer_moore_horspool.hpp>
+
+#include "random_test.hpp"
+
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+namespace ba = boost::algorithm;
+
+namespace {
+
+    std::string make_corpus ( std::size_t size, unsigned alphabet, unsigned long seed ) {
+        return make_string ( size, alphabet, seed );
+        }
+
+    template <typename Iter>
+    int offset ( Iter first, Iter last, Iter found ) {
+        return found == last ? -1 : static_cast<int> ( std::distance ( first, found ));
+        }
+
+    void check_one ( const std::string &haystack, const std::string &needle ) {
+        const int expected = offset ( haystack.begin (), haystack.end (),
+            std::search ( haystack.begin (), haystack.end (), needle.begin (), needle.end ()));
+
+    //  std::string iterators
+        ba::boyer_moore_horspool<std::string::const_iterator> bmh ( needle.begin (), needle.end ());
+        BOOST_CHECK_EQUAL ( offset ( haystack.begin (), haystack.end (),
+            bmh ( haystack.begin (), haystack.end ())), expected );
+
+    //  char pointers
+        const char *hBeg = haystack.data ();
+        const char *hEnd = hBeg + haystack.size ();
+        BOOST_CHECK_EQUAL ( offset ( hBeg, hEnd, ba::boyer_moore_horspool_search (
+            hBeg, hEnd, needle.data (), needle.data () + needle.size ())), expected );
+
+    //  vector<unsigned char>, with the pattern in a different container
+        std::vector<unsigned char> uh ( haystack.begin (), haystack.end ());
+        std::vector<unsigned char> un ( needle.begin (), needle.end ());
+        ba::boyer_moore_horspool<std::vector<unsigned char>::const_iterator> ubmh ( un.begin (), un.end ());
+        const std::vector<unsigned char> &cuh = uh;
+        BOOST_CHECK_EQUAL ( offset ( cuh.begin (), cuh.end (), ubmh ( cuh.begin (), cuh.end ())), expected );
+        }
+    }
+
+
+BOOST_AUTO_TEST_CASE( test_main )
+{
+//  Patterns placed at every offset around the vector block sizes
+    for ( std::size_t len = 1; len <= 40; ++len ) {
+        const std::string needle = make_corpus ( len, 26, len );
+        for ( std::size_t pos = 0; pos < 70; ++pos ) {
+            std::string haystack ( 100, '-' );
+            haystack.replace ( pos, len, needle );
+            haystack.resize ( std::max<std::size_t> ( pos + len, 70 ), '-' );
+            check_one ( haystack, needle );
+            check_one ( haystack.substr ( 0, pos + len - 1 ), needle );    // just too short
+            }
+        }
+
+//  Small alphabets give lots of candidates that fail verification
+    for ( unsigned alphabet = 2; alphabet <= 4; ++alphabet ) {
+        const std::string haystack = make_corpus ( 5000, alphabet, alphabet );
+        for ( std::size_t len = 1; len <= 24; ++len ) {
+            check_one ( haystack, haystack.substr ( 4000 - len, len ));
+            check_one ( haystack, make_corpus ( len, alphabet, 1000 + len ));
+            }
+        }
+
+//  High-bit bytes must compare the same way as std::search does
+    std::string high ( 300, '\x80' );
+    high [ 257 ] = '\xff';
+    high [ 258 ] = '\x01';
+    check_one ( high, std::string ( "\x80\xff\x01" ));
+    check_one ( high, std::string ( "\xff\x01\x80\x80" ));
+    check_one ( high, std::string ( "\x01\xff" ));
+}
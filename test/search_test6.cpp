@@ -0,0 +1,146 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+
+    Testing the find_all interfaces
+*/
+
+#include <boost/algorithm/searching/boyer_moore.hpp>
+#include <boost/algorithm/searching/boyer_moore_horspool.hpp>
+#include <boost/algorithm/searching/knuth_morris_pratt.hpp>
+
+#include <boost/iterator/iterator_adaptor.hpp>
+
+#include "random_test.hpp"
+
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <iterator>
+
+namespace ba = boost::algorithm;
+
+namespace {
+
+//  An iterator that counts how many times the corpus is looked at
+    template <typename Iter>
+    class counting_iterator
+        : public boost::iterator_adaptor<counting_iterator<Iter>, Iter> {
+        typedef boost::iterator_adaptor<counting_iterator<Iter>, Iter> super_t;
+    public:
+        counting_iterator () : count_ ( NULL ) {}
+        counting_iterator ( Iter it, std::size_t *count ) : super_t ( it ), count_ ( count ) {}
+    private:
+        friend class boost::iterator_core_access;
+        typename super_t::reference dereference () const { ++*count_; return *this->base (); }
+        std::size_t *count_;
+        };
+
+    std::vector<int> brute_force ( const std::string &haystack, const std::string &needle, ba::match_mode_type mode ) {
+        std::vector<int> retVal;
+        if ( needle.empty ()) return retVal;
+        std::string::size_type pos = haystack.find ( needle );
+        while ( pos != std::string::npos ) {
+            retVal.push_back ( static_cast<int> ( pos ));
+            pos = haystack.find ( needle, pos + ( mode == ba::match_overlapping ? 1 : needle.size ()));
+            }
+        return retVal;
+        }
+
+    template <typename Iter>
+    std::vector<int> offsets ( Iter first, const std::vector<Iter> &found ) {
+        std::vector<int> retVal;
+        for ( typename std::vector<Iter>::const_iterator it = found.begin (); it != found.end (); ++it )
+            retVal.push_back ( static_cast<int> ( *it - first ));
+        return retVal;
+        }
+
+    void check_one ( const std::string &haystack, const std::string &needle, ba::match_mode_type mode ) {
+        typedef std::string::const_iterator iter_type;
+        const std::vector<int> expected = brute_force ( haystack, needle, mode );
+
+        ba::boyer_moore<iter_type>          bm  ( needle.begin (), needle.end ());
+        ba::boyer_moore_horspool<iter_type> bmh ( needle.begin (), needle.end ());
+        ba::knuth_morris_pratt<iter_type>   kmp ( needle.begin (), needle.end ());
+
+        std::vector<iter_type> r1, r2, r3;
+        bm.find_all  ( haystack.begin (), haystack.end (), std::back_inserter ( r1 ), mode );
+        bmh.find_all ( haystack.begin (), haystack.end (), std::back_inserter ( r2 ), mode );
+        kmp.find_all ( haystack.begin (), haystack.end (), std::back_inserter ( r3 ), mode );
+
+        const std::vector<int> o1 = offsets ( haystack.begin (), r1 );
+        const std::vector<int> o2 = offsets ( haystack.begin (), r2 );
+        const std::vector<int> o3 = offsets ( haystack.begin (), r3 );
+        BOOST_CHECK_EQUAL_COLLECTIONS ( o1.begin (), o1.end (), expected.begin (), expected.end ());
+        BOOST_CHECK_EQUAL_COLLECTIONS ( o2.begin (), o2.end (), expected.begin (), expected.end ());
+        BOOST_CHECK_EQUAL_COLLECTIONS ( o3.begin (), o3.end (), expected.begin (), expected.end ());
+
+    //  Non-contiguous corpus, so Horspool uses the skip table
+        typedef counting_iterator<std::string::const_iterator> c_iter;
+        std::size_t count = 0;
+        std::vector<c_iter> r4;
+        bmh.find_all ( c_iter ( haystack.begin (), &count ), c_iter ( haystack.end (), &count ),
+                                std::back_inserter ( r4 ), mode );
+        std::vector<int> o4;
+        for ( std::size_t i = 0; i < r4.size (); ++i )
+            o4.push_back ( static_cast<int> ( r4 [ i ].base () - haystack.begin ()));
+        BOOST_CHECK_EQUAL_COLLECTIONS ( o4.begin (), o4.end (), expected.begin (), expected.end ());
+        }
+
+    void check_one ( const std::string &haystack, const std::string &needle ) {
+        check_one ( haystack, needle, ba::match_overlapping );
+        check_one ( haystack, needle, ba::match_non_overlapping );
+        }
+
+//  With the Galil rule, Boyer-Moore looks at each corpus element a bounded
+//  number of times, even when the pattern occurs everywhere.
+    void check_linear ( const std::string &haystack, const std::string &needle ) {
+        typedef counting_iterator<std::string::const_iterator> c_iter;
+        ba::boyer_moore<std::string::const_iterator> bm ( needle.begin (), needle.end ());
+        std::size_t count = 0;
+        std::vector<c_iter> found;
+        bm.find_all ( c_iter ( haystack.begin (), &count ), c_iter ( haystack.end (), &count ),
+                        std::back_inserter ( found ));
+        BOOST_CHECK_EQUAL ( found.size (), brute_force ( haystack, needle, ba::match_overlapping ).size ());
+        BOOST_CHECK_LE ( count, 3 * haystack.size ());
+        }
+    }
+
+
+BOOST_AUTO_TEST_CASE( test_main )
+{
+    check_one ( "aaaaaaaa", "a" );
+    check_one ( "aaaaaaaa", "aa" );
+    check_one ( "aaaaaaaa", "aaa" );
+    check_one ( "aaaaaaaa", "aaaaaaaa" );
+    check_one ( "aaaaaaaa", "aaaaaaaaa" );
+    check_one ( "abababababab", "abab" );
+    check_one ( "abababababab", "aba" );
+    check_one ( "abcabcabdabcabcabcabd", "abcabd" );
+    check_one ( "abcabcabdabcabcabcabd", "" );
+    check_one ( "", "abc" );
+    check_one ( "NOW AN FOWE\220ER ANNMAN THE ANPANMANEND", "AN" );
+
+    for ( unsigned long seed = 1; seed < 200; ++seed ) {
+        unsigned long s = seed;
+        const unsigned alphabet = 2 + seed % 3;
+        const std::string haystack = make_string ( 200 + seed, alphabet, s );
+        check_one ( haystack, make_string ( 1 + seed % 7, alphabet, s ));
+        check_one ( haystack, haystack.substr ( seed % 50, 1 + seed % 9 ));
+        }
+
+//  Periodic patterns in periodic text
+    check_linear ( std::string ( 10000, 'a' ), std::string ( 50, 'a' ));
+    std::string ab;
+    for ( int i = 0; i < 5000; ++i ) ab += "ab";
+    check_linear ( ab, ab.substr ( 0, 40 ));
+    check_linear ( ab, ab.substr ( 0, 41 ));
+}
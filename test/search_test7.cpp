@@ -0,0 +1,88 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+
+    Testing the skip tables for narrow and wide element types
+*/
+
+#include <boost/algorithm/searching/boyer_moore.hpp>
+#include <boost/algorithm/searching/boyer_moore_horspool.hpp>
+#include <boost/cstdint.hpp>
+
+#include "random_test.hpp"
+
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <vector>
+
+namespace ba = boost::algorithm;
+
+namespace {
+
+//  The traits that were used for everything but bytes before the flat table
+    template <typename Iterator>
+    struct map_traits {
+        typedef typename std::iterator_traits<Iterator>::difference_type value_type;
+        typedef typename std::iterator_traits<Iterator>::value_type key_type;
+        typedef ba::detail::skip_table<key_type, value_type, false> skip_table_t;
+        };
+
+    template <typename T>
+    std::vector<T> make_vector ( std::size_t size, unsigned long base, unsigned alphabet, unsigned long &seed ) {
+        std::vector<T> retVal ( size );
+        for ( std::size_t i = 0; i < size; ++i )
+            retVal [ i ] = static_cast<T> ( base + next_random ( seed ) % alphabet );
+        return retVal;
+        }
+
+    template <typename T>
+    void check_one ( const std::vector<T> &haystack, const std::vector<T> &needle ) {
+        typedef typename std::vector<T>::const_iterator iter_type;
+        const iter_type expected = std::search ( haystack.begin (), haystack.end (), needle.begin (), needle.end ());
+        BOOST_CHECK ( ba::boyer_moore_search          ( haystack, needle ) == expected );
+        BOOST_CHECK ( ba::boyer_moore_horspool_search ( haystack, needle ) == expected );
+
+        const ba::boyer_moore<iter_type, map_traits<iter_type> > bm ( needle.begin (), needle.end ());
+        const ba::boyer_moore_horspool<iter_type, map_traits<iter_type> > bmh ( needle.begin (), needle.end ());
+        BOOST_CHECK ( bm  ( haystack.begin (), haystack.end ()) == expected );
+        BOOST_CHECK ( bmh ( haystack.begin (), haystack.end ()) == expected );
+        }
+
+    template <typename T>
+    void check_type ( unsigned long base ) {
+        unsigned long seed = 17;
+        for ( unsigned alphabet = 2; alphabet < 20000; alphabet *= 7 ) {
+            const std::vector<T> haystack = make_vector<T> ( 3000, base, alphabet, seed );
+            for ( std::size_t len = 1; len < 300; len = 2 * len + 3 ) {
+                check_one ( haystack, make_vector<T> ( len, base, alphabet, seed ));
+                check_one ( haystack, std::vector<T> ( haystack.begin () + len, haystack.begin () + 2 * len ));
+                check_one ( haystack, std::vector<T> ( haystack.end () - len, haystack.end ()));
+                }
+            }
+        }
+    }
+
+
+BOOST_AUTO_TEST_CASE( test_main )
+{
+    check_type<char>           ( 'a' );
+    check_type<unsigned char>  ( 0 );
+    check_type<wchar_t>        ( 0x4E00 );
+    check_type<boost::uint16_t>( 0xF000 );
+    check_type<boost::uint32_t>( 0x10000 );
+    check_type<int>            ( 0 );
+    check_type<long long>      ( 0 );
+
+//  Patterns too long for the narrow entries in the byte table
+    unsigned long seed = 3;
+    const std::vector<char> haystack = make_vector<char> ( 300000, 'a', 3, seed );
+    check_one ( haystack, std::vector<char> ( haystack.begin () + 1000, haystack.begin () + 1300 ));
+    check_one ( haystack, std::vector<char> ( haystack.end () - 70000, haystack.end ()));
+    check_one ( haystack, make_vector<char> ( 70000, 'a', 3, seed ));
+}
@@ -0,0 +1,100 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+
+    Testing the short pattern path of the free search functions
+*/
+
+#include <boost/algorithm/searching/boyer_moore.hpp>
+#include <boost/algorithm/searching/boyer_moore_horspool.hpp>
+#include <boost/algorithm/searching/knuth_morris_pratt.hpp>
+
+#include "random_test.hpp"
+
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <algorithm>
+
+namespace ba = boost::algorithm;
+
+namespace {
+
+    template <typename Container>
+    void check_one ( const Container &haystack, const Container &needle ) {
+        typedef typename Container::const_iterator iter_type;
+        const iter_type expected = std::search ( haystack.begin (), haystack.end (), needle.begin (), needle.end ());
+
+        BOOST_CHECK ( ba::boyer_moore_search ( haystack.begin (), haystack.end (), needle.begin (), needle.end ()) == expected );
+        BOOST_CHECK ( ba::boyer_moore_search ( haystack.begin (), haystack.end (), needle ) == expected );
+        BOOST_CHECK ( ba::boyer_moore_search ( haystack, needle.begin (), needle.end ()) == expected );
+        BOOST_CHECK ( ba::boyer_moore_search ( haystack, needle ) == expected );
+
+        BOOST_CHECK ( ba::boyer_moore_horspool_search ( haystack.begin (), haystack.end (), needle.begin (), needle.end ()) == expected );
+        BOOST_CHECK ( ba::boyer_moore_horspool_search ( haystack.begin (), haystack.end (), needle ) == expected );
+        BOOST_CHECK ( ba::boyer_moore_horspool_search ( haystack, needle.begin (), needle.end ()) == expected );
+        BOOST_CHECK ( ba::boyer_moore_horspool_search ( haystack, needle ) == expected );
+
+        BOOST_CHECK ( ba::knuth_morris_pratt_search ( haystack.begin (), haystack.end (), needle.begin (), needle.end ()) == expected );
+        BOOST_CHECK ( ba::knuth_morris_pratt_search ( haystack.begin (), haystack.end (), needle ) == expected );
+        BOOST_CHECK ( ba::knuth_morris_pratt_search ( haystack, needle.begin (), needle.end ()) == expected );
+        BOOST_CHECK ( ba::knuth_morris_pratt_search ( haystack, needle ) == expected );
+
+    //  And over raw pointers
+        if ( !haystack.empty () && !needle.empty ()) {
+            const typename Container::value_type *h = &haystack [ 0 ];
+            const typename Container::value_type *n = &needle [ 0 ];
+            const typename Container::value_type *found =
+                ba::boyer_moore_search ( h, h + haystack.size (), n, n + needle.size ());
+            BOOST_CHECK_EQUAL ( found - h, expected - haystack.begin ());
+            }
+        }
+
+    template <typename Container>
+    void check_type () {
+        unsigned long seed = 11;
+        for ( int i = 0; i < 300; ++i ) {
+            const std::size_t size = 1 + next_random ( seed ) % 200;
+            const unsigned alphabet = 2 + i % 5;
+            Container haystack ( size, 0 );
+            for ( std::size_t j = 0; j < size; ++j )
+                haystack [ j ] = static_cast<typename Container::value_type> ( 0x7E + next_random ( seed ) % alphabet );
+
+        //  Every length from 0 to just past the short pattern limit,
+        //  both from the corpus and not
+            for ( std::size_t len = 0; len <= 18 && len <= size; ++len ) {
+                const std::size_t start = next_random ( seed ) % ( size - len + 1 );
+                check_one ( haystack, Container ( haystack.begin () + start, haystack.begin () + start + len ));
+                Container other ( len, 0 );
+                for ( std::size_t j = 0; j < len; ++j )
+                    other [ j ] = static_cast<typename Container::value_type> ( 0x7E + next_random ( seed ) % alphabet );
+                check_one ( haystack, other );
+                }
+            }
+        check_one ( Container (), Container ( 3, 1 ));
+        check_one ( Container (), Container ());
+        }
+    }
+
+
+BOOST_AUTO_TEST_CASE( test_main )
+{
+    check_type<std::string> ();
+    check_type<std::vector<char> > ();
+    check_type<std::vector<signed char> > ();
+    check_type<std::vector<unsigned char> > ();
+
+//  Not contiguous, so these use the searchers
+    const std::string haystack ( "NOW AN FOWE\220ER ANNMAN THE ANPANMANEND" );
+    const std::deque<char> d ( haystack.begin (), haystack.end ());
+    std::vector<char> needle ( haystack.begin () + 28, haystack.begin () + 33 );
+    BOOST_CHECK ( ba::knuth_morris_pratt_search ( d, needle ) - d.begin () == 28 );
+    BOOST_CHECK ( ba::boyer_moore_search ( d, needle ) - d.begin () == 28 );
+}
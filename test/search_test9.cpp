@@ -0,0 +1,182 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+
+    Testing searchers built with an allocator
+*/
+
+#include <boost/algorithm/searching/boyer_moore.hpp>
+#include <boost/algorithm/searching/boyer_moore_horspool.hpp>
+#include <boost/algorithm/searching/knuth_morris_pratt.hpp>
+
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+
+#include <new>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+namespace ba = boost::algorithm;
+
+//  Count the allocations that go to the global heap
+namespace {
+    bool g_counting = false;
+    std::size_t g_global_allocations = 0;
+
+    void *counted_malloc ( std::size_t size ) {
+        if ( g_counting )
+            ++g_global_allocations;
+        void *p = std::malloc ( size == 0 ? 1 : size );
+        if ( p == NULL )
+            throw std::bad_alloc ();
+        return p;
+        }
+    }
+
+void *operator new   ( std::size_t size ) { return counted_malloc ( size ); }
+void *operator new[] ( std::size_t size ) { return counted_malloc ( size ); }
+void operator delete   ( void *p ) BOOST_NOEXCEPT { std::free ( p ); }
+void operator delete[] ( void *p ) BOOST_NOEXCEPT { std::free ( p ); }
+#ifdef __cpp_sized_deallocation
+void operator delete   ( void *p, std::size_t ) BOOST_NOEXCEPT { ::operator delete   ( p ); }
+void operator delete[] ( void *p, std::size_t ) BOOST_NOEXCEPT { ::operator delete[] ( p ); }
+#endif
+
+namespace {
+
+//  A bump allocator over a fixed buffer; deallocation does nothing.
+    struct arena {
+        arena () : buffer_ ( k_size / sizeof ( double )), used ( 0 ), allocations ( 0 ) {}
+
+        void *allocate ( std::size_t size ) {
+            const std::size_t k_words = ( size + sizeof ( double ) - 1 ) / sizeof ( double );
+            if ( used + k_words > buffer_.size ())
+                throw std::bad_alloc ();
+            void *p = &buffer_ [ used ];
+            used += k_words;
+            ++allocations;
+            return p;
+            }
+
+        static const std::size_t k_size = 4 << 20;
+        std::vector<double> buffer_;        // allocated before we start counting
+        std::size_t used;               // in doubles
+        std::size_t allocations;
+        };
+
+    template <typename T>
+    class arena_allocator {
+    public:
+        typedef T value_type;
+        typedef T *pointer;
+        typedef const T *const_pointer;
+        typedef T &reference;
+        typedef const T &const_reference;
+        typedef std::size_t size_type;
+        typedef std::ptrdiff_t difference_type;
+        template <typename U> struct rebind { typedef arena_allocator<U> other; };
+
+        explicit arena_allocator ( arena *a ) : arena_ ( a ) {}
+        template <typename U> arena_allocator ( const arena_allocator<U> &rhs ) : arena_ ( rhs.get_arena ()) {}
+
+        T *allocate ( std::size_t n, const void * = NULL ) { return static_cast<T *> ( arena_->allocate ( n * sizeof ( T ))); }
+        void deallocate ( T *, std::size_t ) {}
+        std::size_t max_size () const { return arena::k_size / sizeof ( T ); }
+        void construct ( T *p, const T &val ) { new ( p ) T ( val ); }
+        void destroy ( T *p ) { p->~T (); }
+
+        arena *get_arena () const { return arena_; }
+
+    private:
+        arena *arena_;
+        };
+
+    template <typename T, typename U>
+    bool operator == ( const arena_allocator<T> &lhs, const arena_allocator<U> &rhs ) { return lhs.get_arena () == rhs.get_arena (); }
+    template <typename T, typename U>
+    bool operator != ( const arena_allocator<T> &lhs, const arena_allocator<U> &rhs ) { return lhs.get_arena () != rhs.get_arena (); }
+
+//  A key type that is not integral, to get the map-based skip table
+    struct token {
+        token ( int v = 0 ) : value ( v ) {}
+        int value;
+        bool operator == ( const token &rhs ) const { return value == rhs.value; }
+        bool operator != ( const token &rhs ) const { return value != rhs.value; }
+        };
+    }
+
+namespace std {
+    template <> struct hash<token> {
+        std::size_t operator () ( const token &t ) const { return static_cast<std::size_t> ( t.value ); }
+        };
+    }
+
+namespace {
+
+    template <typename Container>
+    void check_one ( const Container &haystack, const Container &needle ) {
+        typedef typename Container::const_iterator iter_type;
+        typedef arena_allocator<char> alloc_type;
+        typedef ba::boyer_moore<iter_type, ba::detail::BM_traits<iter_type, alloc_type> > bm_type;
+        typedef ba::boyer_moore_horspool<iter_type, ba::detail::BM_traits<iter_type, alloc_type> > bmh_type;
+        typedef ba::knuth_morris_pratt<iter_type, alloc_type> kmp_type;
+        const iter_type expected = std::search ( haystack.begin (), haystack.end (), needle.begin (), needle.end ());
+
+        arena a;
+        g_counting = true;
+        g_global_allocations = 0;
+        {
+            const bm_type  bm  ( needle.begin (), needle.end (), alloc_type ( &a ));
+            const bmh_type bmh ( needle.begin (), needle.end (), alloc_type ( &a ));
+            const kmp_type kmp ( needle.begin (), needle.end (), alloc_type ( &a ));
+            const bool ok = bm  ( haystack.begin (), haystack.end ()) == expected
+                         && bmh ( haystack.begin (), haystack.end ()) == expected
+                         && kmp ( haystack.begin (), haystack.end ()) == expected;
+            g_counting = false;
+            BOOST_CHECK ( ok );
+        }
+        BOOST_CHECK_EQUAL ( g_global_allocations, 0U );
+        if ( !needle.empty ())
+            BOOST_CHECK_GT ( a.allocations, 0U );
+        }
+    }
+
+
+BOOST_AUTO_TEST_CASE( test_main )
+{
+    const std::string haystack ( "Now is the time for all good men to come to the aid of their country" );
+    check_one ( haystack, std::string ( "their" ));
+    check_one ( haystack, std::string ( "the" ));
+    check_one ( haystack, std::string ( "tho" ));
+    check_one ( haystack, std::string ());
+    check_one ( haystack, std::string ( 300, 'x' ));            // 16-bit skip entries
+    check_one ( haystack + std::string ( 70000, 'y' ), std::string ( 70000, 'y' ));
+
+    std::wstring whaystack ( L"abracadabra abracadabrx" );
+    check_one ( whaystack, std::wstring ( L"abrx" ));
+    check_one ( whaystack, std::wstring ( L"cad" ));
+
+    std::vector<token> thaystack, tneedle;
+    for ( int i = 0; i < 200; ++i )
+        thaystack.push_back ( token ( i % 17 ));
+    for ( int i = 5; i < 12; ++i )
+        tneedle.push_back ( token ( i ));
+    check_one ( thaystack, tneedle );
+
+//  Copies of a searcher share its allocator
+    arena a;
+    typedef std::string::const_iterator iter_type;
+    typedef ba::boyer_moore<iter_type, ba::detail::BM_traits<iter_type, arena_allocator<char> > > bm_type;
+    const std::string needle ( "good" );
+    const bm_type bm ( needle.begin (), needle.end (), arena_allocator<char> ( &a ));
+    const std::size_t k_before = a.allocations;
+    const bm_type bm2 ( bm );
+    BOOST_CHECK_GT ( a.allocations, k_before );
+    BOOST_CHECK ( bm2 ( haystack ) == haystack.begin () + haystack.find ( needle ));
+}
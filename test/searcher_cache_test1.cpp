@@ -0,0 +1,150 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+
+    Testing the cache of searchers
+*/
+
+#include <boost/algorithm/searching/searcher_cache.hpp>
+
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+#include <vector>
+#include <algorithm>
+
+#if !defined(BOOST_NO_CXX11_HDR_MUTEX)
+
+#include <thread>
+
+namespace ba = boost::algorithm;
+
+namespace {
+
+    const std::string k_corpus ( "Now is the time for all good men to come to the aid of their country, "
+                                 "and the quick brown fox jumps over the lazy dog." );
+
+    template <typename Cache>
+    void check_one ( Cache &cache, const std::string &needle ) {
+        const std::string::const_iterator expected = std::search (
+                k_corpus.begin (), k_corpus.end (), needle.begin (), needle.end ());
+        BOOST_CHECK ( ba::cached_search ( cache, k_corpus.begin (), k_corpus.end (),
+                            needle.begin (), needle.end ()) == expected );
+        BOOST_CHECK ( ba::cached_search ( cache, k_corpus, needle ) == expected );
+        }
+    }
+
+
+BOOST_AUTO_TEST_CASE( test_hits_and_misses )
+{
+    ba::searcher_cache<char> cache ( 3 );
+    BOOST_CHECK_EQUAL ( cache.capacity (), 3U );
+    BOOST_CHECK_EQUAL ( cache.size (), 0U );
+
+    check_one ( cache, "the" );         // miss, then a hit
+    check_one ( cache, "the" );         // two hits
+    check_one ( cache, "fox" );
+    check_one ( cache, "cat" );
+    check_one ( cache, "" );
+    ba::searcher_cache_stats stats = cache.stats ();
+    BOOST_CHECK_EQUAL ( stats.misses, 4U );
+    BOOST_CHECK_EQUAL ( stats.hits, 6U );
+    BOOST_CHECK_EQUAL ( stats.evictions, 1U );
+    BOOST_CHECK_EQUAL ( cache.size (), 3U );
+
+//  "the" was used least recently, and has gone
+    check_one ( cache, "fox" );
+    check_one ( cache, "the" );
+    stats = cache.stats ();
+    BOOST_CHECK_EQUAL ( stats.misses, 5U );
+    BOOST_CHECK_EQUAL ( stats.evictions, 2U );
+
+//  ... and "fox" was used more recently than "cat", which went instead
+    check_one ( cache, "fox" );
+    BOOST_CHECK_EQUAL ( cache.stats ().misses, 5U );
+
+    cache.clear ();
+    BOOST_CHECK_EQUAL ( cache.size (), 0U );
+    check_one ( cache, "fox" );
+    BOOST_CHECK_EQUAL ( cache.stats ().misses, 6U );
+}
+
+BOOST_AUTO_TEST_CASE( test_ownership )
+{
+    ba::searcher_cache<char, ba::boyer_moore_horspool<const char *> > cache ( 2 );
+    ba::searcher_cache<char, ba::boyer_moore_horspool<const char *> >::pointer p;
+    {
+        std::string needle ( "lazy" );
+        p = cache.get ( needle );
+        needle = "XXXX";
+    }
+    BOOST_CHECK_EQUAL ( p->pattern_length (), 4U );
+    BOOST_CHECK ( (*p) ( k_corpus ) == k_corpus.begin () + k_corpus.find ( "lazy" ));
+
+//  A searcher that is evicted stays usable while someone holds it
+    cache.get ( std::string ( "dog" ));
+    cache.get ( std::string ( "fox" ));
+    BOOST_CHECK_EQUAL ( cache.stats ().evictions, 1U );
+    BOOST_CHECK ( (*p) ( k_corpus ) == k_corpus.begin () + k_corpus.find ( "lazy" ));
+
+    std::vector<std::string::const_iterator> found;
+    ba::cached_find_all ( cache, k_corpus, std::string ( "the" ), std::back_inserter ( found ));
+    BOOST_CHECK_EQUAL ( found.size (), 5U );
+}
+
+BOOST_AUTO_TEST_CASE( test_free_functions )
+{
+    typedef ba::knuth_morris_pratt<const char *> kmp;
+    const std::string needle ( "quick" );
+    const std::string::const_iterator expected = k_corpus.begin () + k_corpus.find ( needle );
+    for ( int i = 0; i < 3; ++i ) {
+        BOOST_CHECK ( ba::boyer_moore_search_cached ( k_corpus, needle ) == expected );
+        BOOST_CHECK ( ba::boyer_moore_horspool_search_cached ( k_corpus.begin (), k_corpus.end (),
+                            needle.begin (), needle.end ()) == expected );
+        BOOST_CHECK ( ba::knuth_morris_pratt_search_cached ( k_corpus, needle ) == expected );
+        }
+    BOOST_CHECK_EQUAL (( ba::default_searcher_cache_stats<char, kmp> ().misses ), 1U );
+    BOOST_CHECK_EQUAL (( ba::default_searcher_cache_stats<char, kmp> ().hits ), 2U );
+}
+
+BOOST_AUTO_TEST_CASE( test_threads )
+{
+    ba::searcher_cache<char> cache ( 8 );
+    std::vector<std::string> needles;
+    for ( int i = 0; i < 16; ++i )
+        needles.push_back ( k_corpus.substr ( i * 7, 3 + i % 5 ));
+
+    std::vector<int> failures ( 4, 0 );
+    std::vector<std::thread> workers;
+    for ( int t = 0; t < 4; ++t )
+        workers.push_back ( std::thread ( [&, t] () {
+            for ( int i = 0; i < 2000; ++i ) {
+                const std::string &needle = needles [ ( i * ( t + 1 )) % needles.size () ];
+                if ( ba::cached_search ( cache, k_corpus, needle ) !=
+                        std::search ( k_corpus.begin (), k_corpus.end (), needle.begin (), needle.end ()))
+                    ++failures [ t ];
+                }
+            }));
+    for ( std::size_t t = 0; t < workers.size (); ++t )
+        workers [ t ].join ();
+
+    for ( std::size_t t = 0; t < failures.size (); ++t )
+        BOOST_CHECK_EQUAL ( failures [ t ], 0 );
+    const ba::searcher_cache_stats stats = cache.stats ();
+    BOOST_CHECK_EQUAL ( stats.hits + stats.misses, 8000U );
+    BOOST_CHECK_LE ( cache.size (), 8U );
+}
+
+#else
+
+BOOST_AUTO_TEST_CASE( test_main )
+{
+    BOOST_TEST_MESSAGE ( "The searcher cache needs <mutex>" );
+}
+
+#endif
@@ -0,0 +1,161 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+
+    Testing the searchers over segmented corpora (std::deque, and libstdc++'s rope)
+*/
+
+#include <boost/algorithm/searching/boyer_moore.hpp>
+#include <boost/algorithm/searching/boyer_moore_horspool.hpp>
+#include <boost/algorithm/searching/knuth_morris_pratt.hpp>
+#ifdef __GLIBCXX__
+#include <boost/algorithm/string/std/rope_traits.hpp>
+#endif
+#include <boost/static_assert.hpp>
+
+#include "random_test.hpp"
+
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <iterator>
+#include <algorithm>
+
+namespace ba = boost::algorithm;
+
+namespace {
+
+//  The deque must give the same answers as the string it was copied from,
+//  whether the search starts at the beginning of a block or in the middle.
+    template <typename Searcher>
+    void check_searcher ( const Searcher &searcher, const std::string &haystack, const std::deque<char> &dq ) {
+        typedef std::string::const_iterator iter_type;
+        typedef std::deque<char>::const_iterator dq_iter_type;
+        const std::size_t k_starts [] = { 0, 1, 511, 512, 1000 };
+        for ( std::size_t s = 0; s < sizeof ( k_starts ) / sizeof ( k_starts [ 0 ] ); ++s ) {
+            const std::size_t start = k_starts [ s ];
+            if ( start > haystack.size ()) continue;
+            BOOST_CHECK_EQUAL ( searcher ( dq.begin () + start, dq.end ()) - dq.begin (),
+                                searcher ( haystack.begin () + start, haystack.end ()) - haystack.begin ());
+
+            for ( int i = 0; i < 2; ++i ) {
+                const ba::match_mode_type mode = i == 0 ? ba::match_overlapping : ba::match_non_overlapping;
+                std::vector<iter_type> expected;
+                std::vector<dq_iter_type> found;
+                searcher.find_all ( haystack.begin () + start, haystack.end (), std::back_inserter ( expected ), mode );
+                searcher.find_all ( dq.begin () + start, dq.end (), std::back_inserter ( found ), mode );
+                BOOST_CHECK_EQUAL ( found.size (), expected.size ());
+                for ( std::size_t j = 0; j < found.size () && j < expected.size (); ++j )
+                    BOOST_CHECK_EQUAL ( found [ j ] - dq.begin (), expected [ j ] - haystack.begin ());
+                BOOST_CHECK_EQUAL ( searcher.count ( dq.begin () + start, dq.end (), mode ), expected.size ());
+                }
+            }
+        }
+
+    void check_one ( const std::string &haystack, const std::string &needle ) {
+        typedef std::string::const_iterator iter_type;
+        const std::deque<char> dq ( haystack.begin (), haystack.end ());
+        check_searcher ( ba::boyer_moore<iter_type>          ( needle.begin (), needle.end ()), haystack, dq );
+        check_searcher ( ba::boyer_moore_horspool<iter_type> ( needle.begin (), needle.end ()), haystack, dq );
+        check_searcher ( ba::knuth_morris_pratt<iter_type>   ( needle.begin (), needle.end ()), haystack, dq );
+
+    //  The procedural interfaces go through the same objects
+        BOOST_CHECK_EQUAL ( ba::boyer_moore_horspool_search ( dq, needle ) - dq.begin (),
+                            ba::boyer_moore_horspool_search ( haystack, needle ) - haystack.begin ());
+        BOOST_CHECK_EQUAL ( ba::knuth_morris_pratt_search ( dq, needle ) - dq.begin (),
+                            ba::knuth_morris_pratt_search ( haystack, needle ) - haystack.begin ());
+        }
+    }
+
+
+BOOST_AUTO_TEST_CASE( test_segmented )
+{
+    check_one ( "", "abc" );
+    check_one ( "abc", "abcd" );
+    check_one ( "abcabcabc", "c" );
+
+//  Patterns shorter than a block, longer than one, and longer than several;
+//  some of them occur across block boundaries
+    unsigned long seed = 11;
+    const std::size_t k_lengths [] = { 1, 2, 3, 17, 511, 512, 513, 1500 };
+    for ( unsigned alphabet = 2; alphabet <= 26; alphabet += 24 ) {
+        const std::string haystack = make_string ( 6000, alphabet, seed );
+        for ( std::size_t i = 0; i < sizeof ( k_lengths ) / sizeof ( k_lengths [ 0 ] ); ++i ) {
+            check_one ( haystack, haystack.substr ( 510, k_lengths [ i ] ));
+            check_one ( haystack, haystack.substr ( 3000, k_lengths [ i ] ));
+            check_one ( haystack, make_string ( k_lengths [ i ], alphabet, seed ));
+            }
+        }
+
+//  A run of matches over every boundary
+    check_one ( std::string ( 5000, 'a' ), "aaa" );
+    check_one ( std::string ( 5000, 'a' ), std::string ( 700, 'a' ));
+}
+
+BOOST_AUTO_TEST_CASE( test_segmented_ints )
+{
+    typedef std::vector<int>::const_iterator iter_type;
+    std::deque<int> dq;
+    for ( int i = 0; i < 5000; ++i )
+        dq.push_back ( i % 101 );
+    const std::vector<int> v ( dq.begin (), dq.end ());
+    const std::vector<int> pattern ( v.begin () + 120, v.begin () + 150 );
+    const ba::boyer_moore_horspool<iter_type> bmh ( pattern.begin (), pattern.end ());
+    const ba::knuth_morris_pratt<iter_type>   kmp ( pattern.begin (), pattern.end ());
+
+    BOOST_CHECK ( bmh ( dq.begin (), dq.end ()) == dq.begin () + 19 );
+    BOOST_CHECK ( kmp ( dq.begin () + 20, dq.end ()) == dq.begin () + 120 );
+    BOOST_CHECK_EQUAL ( bmh.count ( dq ), 50U );
+    BOOST_CHECK_EQUAL ( kmp.count ( dq, ba::match_non_overlapping ), 50U );
+}
+
+#ifdef __GLIBCXX__
+BOOST_AUTO_TEST_CASE( test_segmented_rope )
+{
+    typedef std::string::const_iterator iter_type;
+    typedef __gnu_cxx::crope::const_iterator rope_iter_type;
+    BOOST_STATIC_ASSERT (( ba::segmented_iterator_traits<rope_iter_type>::is_segmented::value ));
+
+//  Built from pieces, so that the rope has many leaves
+    unsigned long seed = 5;
+    const std::string haystack = make_string ( 20000, 3, seed );
+    __gnu_cxx::crope rope;
+    for ( std::size_t i = 0; i < haystack.size (); i += 1000 )
+        rope.append ( haystack.data () + i, std::min<std::size_t> ( 1000, haystack.size () - i ));
+    BOOST_REQUIRE ( std::equal ( haystack.begin (), haystack.end (), rope.begin ()));
+
+    const std::size_t k_lengths [] = { 1, 3, 17, 999, 1500 };
+    for ( std::size_t i = 0; i < sizeof ( k_lengths ) / sizeof ( k_lengths [ 0 ] ); ++i ) {
+        const std::string needle = haystack.substr ( 990, k_lengths [ i ] );
+        const ba::boyer_moore<iter_type>          bm   ( needle.begin (), needle.end ());
+        const ba::boyer_moore_horspool<iter_type> bmh  ( needle.begin (), needle.end ());
+        const ba::knuth_morris_pratt<iter_type>   kmp  ( needle.begin (), needle.end ());
+        const std::ptrdiff_t expected = bmh ( haystack.begin (), haystack.end ()) - haystack.begin ();
+        BOOST_CHECK_EQUAL ( bm  ( rope.begin (), rope.end ()) - rope.begin (), expected );
+        BOOST_CHECK_EQUAL ( bmh ( rope.begin (), rope.end ()) - rope.begin (), expected );
+        BOOST_CHECK_EQUAL ( kmp ( rope.begin (), rope.end ()) - rope.begin (), expected );
+        BOOST_CHECK_EQUAL ( bmh ( rope.begin () + 991, rope.end ()) - rope.begin (),
+                            bmh ( haystack.begin () + 991, haystack.end ()) - haystack.begin ());
+
+        for ( int j = 0; j < 2; ++j ) {
+            const ba::match_mode_type mode = j == 0 ? ba::match_overlapping : ba::match_non_overlapping;
+            std::vector<iter_type> all;
+            std::vector<rope_iter_type> found;
+            bmh.find_all ( haystack.begin (), haystack.end (), std::back_inserter ( all ), mode );
+            kmp.find_all ( rope.begin (), rope.end (), std::back_inserter ( found ), mode );
+            BOOST_CHECK_EQUAL ( found.size (), all.size ());
+            for ( std::size_t k = 0; k < found.size () && k < all.size (); ++k )
+                BOOST_CHECK_EQUAL ( found [ k ] - rope.begin (), all [ k ] - haystack.begin ());
+            BOOST_CHECK_EQUAL ( bmh.count ( rope.begin (), rope.end (), mode ), all.size ());
+            BOOST_CHECK_EQUAL ( bm.count  ( rope.begin (), rope.end (), mode ), all.size ());
+            }
+        }
+}
+#endif
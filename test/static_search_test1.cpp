@@ -0,0 +1,131 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+
+    Testing the compile-time searchers
+*/
+
+#include <boost/algorithm/searching/static_search.hpp>
+
+#include "random_test.hpp"
+
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <algorithm>
+
+#if !defined(BOOST_NO_CXX14_CONSTEXPR) && !defined(BOOST_NO_CXX11_VARIADIC_TEMPLATES)
+
+#include <utility>      // for std::index_sequence
+
+namespace ba = boost::algorithm;
+
+namespace {
+
+    template <typename Container>
+    Container make_corpus ( std::size_t size, unsigned alphabet, unsigned long seed ) {
+        return make_string<Container> ( size, alphabet, seed );
+        }
+
+    template <typename charT, charT... Chars>
+    std::vector<charT> pattern_of ( const ba::static_horspool<charT, Chars...> & ) {
+        return std::vector<charT> { Chars... };
+        }
+
+//  Check both searchers against std::search, for every suffix of the corpus
+    template <typename Horspool, typename BoyerMoore, typename Container>
+    void check_one ( const Container &haystack ) {
+        typedef typename Container::value_type value_type;
+        typedef typename Container::const_iterator iter_type;
+        const Horspool   h;
+        const BoyerMoore bm;
+        const std::vector<value_type> needle = pattern_of ( h );
+        BOOST_CHECK_EQUAL ( needle.size (), Horspool::pattern_length ());
+        BOOST_CHECK_EQUAL ( needle.size (), BoyerMoore::pattern_length ());
+
+        for ( iter_type first = haystack.begin (); first != haystack.end (); ++first ) {
+            const iter_type expected = std::search ( first, haystack.end (), needle.begin (), needle.end ());
+            BOOST_CHECK ( h  ( first, haystack.end ()) == expected );
+            BOOST_CHECK ( bm ( first, haystack.end ()) == expected );
+            if ( expected == haystack.end ())
+                break;
+            }
+        }
+
+    constexpr char k_long_pattern [] =
+        "ab0123456789abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789"
+        "ab0123456789abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789"
+        "ab0123456789abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789"
+        "ab0123456789abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789";
+
+    template <std::size_t... I>
+    ba::static_horspool<char, k_long_pattern [ I ]...> long_horspool ( std::index_sequence<I...> ) { return {}; }
+
+    template <std::size_t... I>
+    ba::static_boyer_moore<char, k_long_pattern [ I ]...> long_boyer_moore ( std::index_sequence<I...> ) { return {}; }
+    }
+
+
+BOOST_AUTO_TEST_CASE( test_main )
+{
+    typedef ba::static_horspool   <char, 'a', 'b', 'a', 'b'> abab_h;
+    typedef ba::static_boyer_moore<char, 'a', 'b', 'a', 'b'> abab_bm;
+    typedef ba::static_horspool   <char, 'a'> a_h;
+    typedef ba::static_boyer_moore<char, 'a'> a_bm;
+    typedef ba::static_horspool   <char, 'c', 'a', 'b', 'b', 'a', 'c'> cabbac_h;
+    typedef ba::static_boyer_moore<char, 'c', 'a', 'b', 'b', 'a', 'c'> cabbac_bm;
+    typedef ba::static_horspool   <char, 'a', 'b', 'c', 'a', 'b', 'd', 'a', 'b', 'c', 'a', 'b', 'd', 'a', 'b', 'c', 'a', 'b', 'c'> long_h;
+    typedef ba::static_boyer_moore<char, 'a', 'b', 'c', 'a', 'b', 'd', 'a', 'b', 'c', 'a', 'b', 'd', 'a', 'b', 'c', 'a', 'b', 'c'> long_bm;
+
+//  The tables are built at compile time
+    static_assert ( abab_h::pattern_length () == 4, "" );
+    constexpr abab_bm k_searcher;
+    (void) k_searcher;
+
+    for ( unsigned long seed = 1; seed < 40; ++seed ) {
+        const unsigned alphabet = 2 + seed % 3;
+        const std::string s = make_corpus<std::string> ( 300 + seed, alphabet, seed );
+        check_one<abab_h,   abab_bm>   ( s );
+        check_one<a_h,      a_bm>      ( s );
+        check_one<cabbac_h, cabbac_bm> ( s );
+        check_one<long_h,   long_bm>   ( s );
+        check_one<abab_h,   abab_bm>   ( make_corpus<std::vector<char> > ( 300, alphabet, seed ));
+        check_one<cabbac_h, cabbac_bm> ( make_corpus<std::deque<char> >  ( 300, alphabet, seed ));
+        check_one<ba::static_horspool<wchar_t, L'a', L'b', L'c'>,
+                  ba::static_boyer_moore<wchar_t, L'a', L'b', L'c'> > ( make_corpus<std::wstring> ( 300, alphabet, seed ));
+        }
+
+//  A pattern long enough to need 16-bit tables
+    typedef std::make_index_sequence<sizeof ( k_long_pattern ) - 1> long_index;
+    typedef decltype ( long_horspool    ( long_index ())) huge_h;
+    typedef decltype ( long_boyer_moore ( long_index ())) huge_bm;
+    const std::string pattern ( k_long_pattern );
+    std::string haystack ( 1000, 'x' );
+    haystack += pattern.substr ( 0, 200 ) + pattern + pattern.substr ( 5 ) + pattern;
+    check_one<huge_h, huge_bm> ( haystack );
+
+//  Ranges
+    const std::string k_corpus ( "Now is the time for all good men to come to the aid of their country" );
+    const ba::static_horspool   <char, 't', 'h', 'e', 'i', 'r'> their_h;
+    const ba::static_boyer_moore<char, 't', 'h', 'e', 'i', 'r'> their_bm;
+    BOOST_CHECK ( their_h  ( k_corpus ) == k_corpus.begin () + k_corpus.find ( "their" ));
+    BOOST_CHECK ( their_bm ( k_corpus ) == k_corpus.begin () + k_corpus.find ( "their" ));
+    BOOST_CHECK ( their_h  ( k_corpus.begin (), k_corpus.begin () + 10 ) == k_corpus.begin () + 10 );
+    BOOST_CHECK ( their_bm ( k_corpus.end (), k_corpus.end ()) == k_corpus.end ());
+}
+
+#else
+
+BOOST_AUTO_TEST_CASE( test_main )
+{
+    BOOST_TEST_MESSAGE ( "The compile-time searchers need C++14" );
+}
+
+#endif
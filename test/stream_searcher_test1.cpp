@@ -0,0 +1,114 @@
+/* 
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+
+    Testing searches across chunk boundaries
+*/
+
+#include <boost/algorithm/searching/stream_searcher.hpp>
+#include <boost/algorithm/searching/boyer_moore.hpp>
+
+#include "random_test.hpp"
+
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <list>
+#include <iterator>
+
+namespace ba = boost::algorithm;
+
+namespace {
+
+    typedef std::vector<boost::uintmax_t> offsets;
+
+    offsets brute_force ( const std::string &haystack, const std::string &needle, ba::match_mode_type mode ) {
+        offsets retVal;
+        if ( needle.empty ()) return retVal;
+        std::string::size_type pos = haystack.find ( needle );
+        while ( pos != std::string::npos ) {
+            retVal.push_back ( pos );
+            pos = haystack.find ( needle, pos + ( mode == ba::match_overlapping ? 1 : needle.size ()));
+            }
+        return retVal;
+        }
+
+//  Feed the corpus to the searcher in chunks of random sizes, each in its own buffer
+    template <typename Searcher>
+    offsets search_chunks ( const std::string &haystack, const std::string &needle,
+                            ba::match_mode_type mode, unsigned long seed, std::size_t max_chunk ) {
+        ba::stream_searcher<std::string::const_iterator, Searcher> ss ( needle.begin (), needle.end (), mode );
+        offsets retVal;
+        std::size_t pos = 0;
+        while ( pos < haystack.size ()) {
+            const std::size_t len = std::min<std::size_t> ( next_random ( seed ) % ( max_chunk + 1 ), haystack.size () - pos );
+            const std::vector<char> chunk ( haystack.begin () + pos, haystack.begin () + pos + len );
+            ss ( chunk.begin (), chunk.end (), std::back_inserter ( retVal ));
+            pos += len;
+            }
+        BOOST_CHECK_EQUAL ( ss.offset (), haystack.size ());
+        return retVal;
+        }
+
+    void check_one ( const std::string &haystack, const std::string &needle, unsigned long seed ) {
+        typedef std::string::const_iterator iter_type;
+        const ba::match_mode_type modes [] = { ba::match_overlapping, ba::match_non_overlapping };
+        for ( int i = 0; i < 2; ++i ) {
+            const offsets expected = brute_force ( haystack, needle, modes [ i ] );
+            for ( std::size_t max_chunk = 1; max_chunk < 3 * needle.size () + 3; max_chunk += 1 + max_chunk / 2 ) {
+                const offsets o1 = search_chunks<ba::boyer_moore_horspool<iter_type> > ( haystack, needle, modes [ i ], seed, max_chunk );
+                const offsets o2 = search_chunks<ba::boyer_moore<iter_type> >          ( haystack, needle, modes [ i ], seed, max_chunk );
+                const offsets o3 = search_chunks<ba::knuth_morris_pratt<iter_type> >   ( haystack, needle, modes [ i ], seed, max_chunk );
+                BOOST_CHECK_EQUAL_COLLECTIONS ( o1.begin (), o1.end (), expected.begin (), expected.end ());
+                BOOST_CHECK_EQUAL_COLLECTIONS ( o2.begin (), o2.end (), expected.begin (), expected.end ());
+                BOOST_CHECK_EQUAL_COLLECTIONS ( o3.begin (), o3.end (), expected.begin (), expected.end ());
+                }
+            }
+        }
+    }
+
+
+BOOST_AUTO_TEST_CASE( test_main )
+{
+    check_one ( "aaaaaaaaaaaaaaaaaaaa", "aaa", 1 );
+    check_one ( "abababababababababab", "abab", 2 );
+    check_one ( "NOW AN FOWE\220ER ANNMAN THE ANPANMANEND", "ANPANMAN", 3 );
+    check_one ( "NOW AN FOWE\220ER ANNMAN THE ANPANMANEND", "NOT FOUND", 4 );
+    check_one ( "NOW AN FOWE\220ER ANNMAN THE ANPANMANEND", "", 5 );
+    check_one ( "", "abc", 6 );
+
+    for ( unsigned long seed = 1; seed < 60; ++seed ) {
+        unsigned long s = seed;
+        const unsigned alphabet = 2 + seed % 3;
+        const std::string haystack = make_string ( 300, alphabet, s );
+        check_one ( haystack, make_string ( 1 + seed % 9, alphabet, s ), seed );
+        }
+
+//  Chunks from a non-random-access container, with KMP
+    std::list<char> chunk1, chunk2;
+    const std::string first ( "xxxxabc" ), second ( "dexxabcde" ), needle ( "abcde" );
+    chunk1.assign ( first.begin (), first.end ());
+    chunk2.assign ( second.begin (), second.end ());
+    ba::stream_searcher<std::string::const_iterator, ba::knuth_morris_pratt<std::string::const_iterator> >
+        kmp ( needle.begin (), needle.end ());
+    offsets found;
+    kmp ( chunk1, std::back_inserter ( found ));
+    kmp ( chunk2, std::back_inserter ( found ));
+    BOOST_REQUIRE_EQUAL ( found.size (), 2U );
+    BOOST_CHECK_EQUAL ( found [ 0 ], 4U );
+    BOOST_CHECK_EQUAL ( found [ 1 ], 11U );
+
+//  Starting over
+    kmp.reset ();
+    found.clear ();
+    kmp ( chunk2, std::back_inserter ( found ));
+    BOOST_REQUIRE_EQUAL ( found.size (), 1U );
+    BOOST_CHECK_EQUAL ( found [ 0 ], 4U );
+}
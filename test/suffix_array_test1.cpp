@@ -0,0 +1,262 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+
+    Testing the suffix array index
+*/
+
+#include <boost/algorithm/searching/suffix_array.hpp>
+
+#include "random_test.hpp"
+
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <deque>
+#include <iterator>
+#include <stdexcept>
+
+namespace ba = boost::algorithm;
+
+namespace {
+
+    const char *k_file_name = "suffix_array_test1.tmp";
+
+//  The suffixes must be in order, and the LCP array must agree with them
+    template <typename Container, typename Index>
+    void check_arrays ( const Container &corpus, const ba::suffix_array<typename Container::const_iterator, Index> &sa ) {
+        BOOST_REQUIRE_EQUAL ( sa.size (), corpus.size ());
+        std::vector<bool> seen ( corpus.size ());
+        for ( std::size_t i = 0; i < sa.size (); ++i ) {
+            const std::size_t pos = sa.suffixes () [ i ];
+            BOOST_REQUIRE ( pos < corpus.size () && !seen [ pos ] );
+            seen [ pos ] = true;
+            if ( i == 0 ) {
+                BOOST_CHECK_EQUAL ( sa.lcp () [ i ], 0U );
+                continue;
+                }
+            const std::size_t prev = sa.suffixes () [ i - 1 ];
+            BOOST_CHECK ( std::lexicographical_compare ( corpus.begin () + prev, corpus.end (),
+                                                         corpus.begin () + pos,  corpus.end ()));
+            std::size_t common = 0;
+            while ( pos + common < corpus.size () && prev + common < corpus.size () &&
+                    corpus [ pos + common ] == corpus [ prev + common ] )
+                ++common;
+            BOOST_CHECK_EQUAL ( sa.lcp () [ i ], common );
+            }
+        }
+
+    std::vector<std::size_t> brute_force ( const std::string &haystack, const std::string &needle, ba::match_mode_type mode ) {
+        std::vector<std::size_t> retVal;
+        if ( needle.empty ()) return retVal;     // matches nothing, as with the searchers
+        std::string::size_type pos = haystack.find ( needle );
+        while ( pos != std::string::npos ) {
+            retVal.push_back ( pos );
+            pos = haystack.find ( needle, pos + ( mode == ba::match_overlapping ? 1 : needle.size ()));
+            }
+        return retVal;
+        }
+
+    template <typename Index>
+    void check_queries ( const std::string &haystack, const ba::suffix_array<std::string::const_iterator, Index> &sa,
+                         const std::string &needle ) {
+        BOOST_CHECK ( sa.find_first ( needle ) == haystack.begin () + std::min ( haystack.find ( needle ), haystack.size ()));
+        for ( int i = 0; i < 2; ++i ) {
+            const ba::match_mode_type mode = i == 0 ? ba::match_overlapping : ba::match_non_overlapping;
+            const std::vector<std::size_t> expected = brute_force ( haystack, needle, mode );
+            std::vector<std::string::const_iterator> found;
+            sa.find_all ( needle, std::back_inserter ( found ), mode );
+            BOOST_CHECK_EQUAL ( found.size (), expected.size ());
+            for ( std::size_t j = 0; j < found.size () && j < expected.size (); ++j )
+                BOOST_CHECK_EQUAL ( static_cast<std::size_t> ( found [ j ] - haystack.begin ()), expected [ j ] );
+            BOOST_CHECK_EQUAL ( sa.count ( needle, mode ), expected.size ());
+            }
+        }
+
+    template <typename Index>
+    void check_string ( const std::string &haystack, unsigned long &seed ) {
+        const ba::suffix_array<std::string::const_iterator, Index> sa ( haystack.begin (), haystack.end ());
+        check_arrays ( haystack, sa );
+
+        for ( int i = 0; i < 20 && !haystack.empty (); ++i ) {
+            const std::size_t m   = 1 + next_random ( seed ) % 8;
+            const std::size_t pos = next_random ( seed ) % haystack.size ();
+            const std::string needle = haystack.substr ( pos, m );
+            check_queries ( haystack, sa, needle );
+            check_queries ( haystack, sa, needle + "z" );               // probably not there
+            check_queries ( haystack, sa, haystack.substr ( pos ));     // runs off the end
+            }
+        check_queries ( haystack, sa, std::string ( "aaaaaaaaaaaaaaaaaaaa" ));
+        check_queries ( haystack, sa, haystack );
+        }
+    }
+
+BOOST_AUTO_TEST_CASE( test_construction )
+{
+    unsigned long seed = 2012;
+
+//  The cases that trip up induced sorting: periodic strings, runs, one element
+    const char *k_corpora [] = { "", "a", "aa", "ab", "ba", "banana", "mississippi", "abracadabra",
+        "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa", "abababababababababababab", "abcabcabcabcabcabcabd",
+        "zyxwvutsrqponmlkjihgfedcba" };
+    for ( std::size_t i = 0; i < sizeof ( k_corpora ) / sizeof ( k_corpora [ 0 ] ); ++i ) {
+        check_string<boost::uint32_t> ( k_corpora [ i ], seed );
+        check_string<boost::uint64_t> ( k_corpora [ i ], seed );
+        }
+
+//  Random corpora, small and large alphabets
+    for ( std::size_t size = 1; size < 3000; size = size * 3 + 1 )
+        for ( unsigned alphabet = 1; alphabet <= 26; alphabet += 5 )
+            check_string<boost::uint32_t> ( make_string ( size, alphabet, seed ), seed );
+
+//  Every byte value, sorted the way the corpus compares them
+    std::string bytes;
+    for ( int i = 0; i < 2000; ++i )
+        bytes += static_cast<char> ( next_random ( seed ) % 256 );
+    check_string<boost::uint32_t> ( bytes, seed );
+
+    std::vector<unsigned char> ubytes ( bytes.begin (), bytes.end ());
+    check_arrays ( ubytes, ba::make_suffix_array ( ubytes ));
+}
+
+BOOST_AUTO_TEST_CASE( test_other_types )
+{
+    unsigned long seed = 42;
+
+//  Wider elements are ranked by sorting them
+    std::vector<int> ints;
+    for ( int i = 0; i < 1000; ++i )
+        ints.push_back ( static_cast<int> ( next_random ( seed ) % 5 ) * 100000 - 200000 );
+    const ba::suffix_array<std::vector<int>::const_iterator> sa ( ints.begin (), ints.end ());
+    check_arrays ( ints, sa );
+
+    const std::vector<int> pattern ( ints.begin () + 500, ints.begin () + 503 );
+    std::vector<std::vector<int>::const_iterator> found;
+    sa.find_all ( pattern, std::back_inserter ( found ));
+    BOOST_CHECK_EQUAL ( sa.count ( pattern ), found.size ());
+    BOOST_CHECK ( std::find ( found.begin (), found.end (), ints.begin () + 500 ) != found.end ());
+    BOOST_CHECK ( sa.find_first ( pattern ) == std::search ( ints.begin (), ints.end (), pattern.begin (), pattern.end ()));
+
+//  ... and the corpus does not have to be contiguous
+    const std::string text = make_string ( 2000, 4, seed );
+    const std::deque<char> dq ( text.begin (), text.end ());
+    const ba::suffix_array<std::deque<char>::const_iterator> dsa ( dq.begin (), dq.end ());
+    check_arrays ( dq, dsa );
+    const std::string needle = text.substr ( 1234, 5 );
+    BOOST_CHECK_EQUAL ( dsa.find_first ( needle ) - dq.begin (), static_cast<std::ptrdiff_t> ( text.find ( needle )));
+
+//  Empty patterns
+    BOOST_CHECK ( dsa.find_first ( std::string ()) == dq.begin ());
+    BOOST_CHECK_EQUAL ( dsa.count ( std::string ()), 0U );
+}
+
+BOOST_AUTO_TEST_CASE( test_find_first )
+{
+//  Patterns with many matches, so that find_first goes through the block
+//  minima; the ranges start and end at every offset within a block
+    unsigned long seed = 99;
+    const std::string corpus = make_string ( 100000, 2, seed );
+    const ba::suffix_array<std::string::const_iterator> sa ( corpus.begin (), corpus.end ());
+    for ( int i = 0; i < 300; ++i ) {
+        const std::size_t m   = 1 + next_random ( seed ) % 10;
+        const std::size_t pos = next_random ( seed ) * 3 % ( corpus.size () - m );
+        const std::string needle = corpus.substr ( pos, m );
+        BOOST_CHECK_EQUAL ( sa.find_first ( needle ) - corpus.begin (),
+                            static_cast<std::ptrdiff_t> ( corpus.find ( needle )));
+        }
+
+//  ... and through an index that was saved and loaded
+    std::ostringstream out;
+    sa.save ( out );
+    std::istringstream in ( out.str ());
+    const ba::suffix_array<std::string::const_iterator> loaded ( corpus.begin (), corpus.end (), in );
+    const std::string k_needles [] = { "a", "b", "ab", "ba", "bbb", "aabba" };
+    for ( std::size_t i = 0; i < sizeof ( k_needles ) / sizeof ( k_needles [ 0 ] ); ++i )
+        BOOST_CHECK_EQUAL ( loaded.find_first ( k_needles [ i ] ) - corpus.begin (),
+                            static_cast<std::ptrdiff_t> ( corpus.find ( k_needles [ i ] )));
+
+//  A single run of one element
+    const std::string run ( 5000, 'x' );
+    const ba::suffix_array<std::string::const_iterator> rsa ( run.begin (), run.end ());
+    for ( std::size_t m = 1; m < 2000; m += 97 )
+        BOOST_CHECK ( rsa.find_first ( std::string ( m, 'x' )) == run.begin ());
+}
+
+BOOST_AUTO_TEST_CASE( test_persistence )
+{
+    typedef ba::suffix_array<std::string::const_iterator> index_type;
+    unsigned long seed = 7;
+    const std::string corpus = make_string ( 5000, 3, seed );
+    const index_type sa ( corpus.begin (), corpus.end ());
+
+    std::ostringstream out;
+    sa.save ( out );
+    const std::string image = out.str ();
+//  The header, the two arrays, and 20 + 19 + 17 + 13 + 5 block minima
+    BOOST_CHECK_EQUAL ( image.size (), 24 + ( 2 * corpus.size () + 74 ) * sizeof ( boost::uint32_t ));
+
+//  Read back from a stream
+    {
+    std::istringstream in ( image );
+    const index_type loaded ( corpus.begin (), corpus.end (), in );
+    BOOST_CHECK ( std::equal ( sa.suffixes (), sa.suffixes () + sa.size (), loaded.suffixes ()));
+    BOOST_CHECK ( std::equal ( sa.lcp (), sa.lcp () + sa.size (), loaded.lcp ()));
+    check_queries ( corpus, loaded, std::string ( "abc" ));
+    }
+
+//  Used in place
+    {
+    std::vector<boost::uint64_t> buffer ( image.size () / 8 + 1 );
+    std::memcpy ( &buffer [ 0 ], image.data (), image.size ());
+    const index_type view ( corpus.begin (), corpus.end (), &buffer [ 0 ], image.size ());
+    BOOST_CHECK ( view.suffixes () == reinterpret_cast<const boost::uint32_t *> ( &buffer [ 0 ] ) + 6 );
+    check_queries ( corpus, view, std::string ( "cab" ));
+
+    const index_type copy ( view );
+    check_queries ( corpus, copy, std::string ( "bba" ));
+
+//  The wrong corpus, the wrong index type, a truncated index, a misaligned one
+    BOOST_CHECK_THROW ( index_type ( corpus.begin (), corpus.end () - 1, &buffer [ 0 ], image.size ()), std::invalid_argument );
+    BOOST_CHECK_THROW (( ba::suffix_array<std::string::const_iterator, boost::uint64_t> (
+                            corpus.begin (), corpus.end (), &buffer [ 0 ], image.size ())), std::invalid_argument );
+    BOOST_CHECK_THROW ( index_type ( corpus.begin (), corpus.end (), &buffer [ 0 ], image.size () - 1 ), std::invalid_argument );
+    std::memmove ( reinterpret_cast<char *> ( &buffer [ 0 ] ) + 1, &buffer [ 0 ], image.size ());
+    BOOST_CHECK_THROW ( index_type ( corpus.begin (), corpus.end (),
+                            reinterpret_cast<char *> ( &buffer [ 0 ] ) + 1, image.size ()), std::invalid_argument );
+
+    std::istringstream short_in ( image.substr ( 0, image.size () / 2 ));
+    BOOST_CHECK_THROW ( index_type ( corpus.begin (), corpus.end (), short_in ), std::invalid_argument );
+    }
+
+//  Mapped from a file
+    {
+    std::ofstream file ( k_file_name, std::ios::binary );
+    sa.save ( file );
+    }
+    {
+    const index_type mapped ( corpus.begin (), corpus.end (), k_file_name );
+    BOOST_CHECK ( std::equal ( sa.suffixes (), sa.suffixes () + sa.size (), mapped.suffixes ()));
+    check_queries ( corpus, mapped, std::string ( "aabb" ));
+    }
+    std::remove ( k_file_name );
+    BOOST_CHECK_THROW ( index_type ( corpus.begin (), corpus.end (), k_file_name ), ba::search_file_error );
+
+//  An empty corpus has an index too
+    const std::string empty;
+    const index_type esa ( empty.begin (), empty.end ());
+    std::ostringstream eout;
+    esa.save ( eout );
+    std::istringstream ein ( eout.str ());
+    const index_type eloaded ( empty.begin (), empty.end (), ein );
+    BOOST_CHECK ( eloaded.find_first ( std::string ( "a" )) == empty.end ());
+}
@@ -0,0 +1,124 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+
+    Testing the Two-Way searcher
+*/
+
+#include <boost/algorithm/searching/two_way.hpp>
+
+#include <boost/iterator/iterator_adaptor.hpp>
+
+#include "random_test.hpp"
+
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <iterator>
+
+namespace ba = boost::algorithm;
+
+namespace {
+
+//  An iterator that counts how many times the corpus is looked at
+    template <typename Iter>
+    class counting_iterator
+        : public boost::iterator_adaptor<counting_iterator<Iter>, Iter> {
+        typedef boost::iterator_adaptor<counting_iterator<Iter>, Iter> super_t;
+    public:
+        counting_iterator () : count_ ( NULL ) {}
+        counting_iterator ( Iter it, std::size_t *count ) : super_t ( it ), count_ ( count ) {}
+    private:
+        friend class boost::iterator_core_access;
+        typename super_t::reference dereference () const { ++*count_; return *this->base (); }
+        std::size_t *count_;
+        };
+
+    std::vector<int> brute_force ( const std::string &haystack, const std::string &needle, ba::match_mode_type mode ) {
+        std::vector<int> retVal;
+        if ( needle.empty ()) return retVal;
+        std::string::size_type pos = haystack.find ( needle );
+        while ( pos != std::string::npos ) {
+            retVal.push_back ( static_cast<int> ( pos ));
+            pos = haystack.find ( needle, pos + ( mode == ba::match_overlapping ? 1 : needle.size ()));
+            }
+        return retVal;
+        }
+
+    void check_one ( const std::string &haystack, const std::string &needle ) {
+        typedef std::string::const_iterator iter_type;
+        const ba::two_way<iter_type> tw ( needle.begin (), needle.end ());
+
+        const iter_type expected = std::search ( haystack.begin (), haystack.end (), needle.begin (), needle.end ());
+        BOOST_CHECK ( tw ( haystack.begin (), haystack.end ()) == expected );
+        BOOST_CHECK ( ba::two_way_search ( haystack, needle ) == expected );
+        BOOST_CHECK ( ba::two_way_search ( haystack.begin (), haystack.end (), needle.begin (), needle.end ()) == expected );
+
+        for ( int i = 0; i < 2; ++i ) {
+            const ba::match_mode_type mode = i == 0 ? ba::match_overlapping : ba::match_non_overlapping;
+            const std::vector<int> exp_all = brute_force ( haystack, needle, mode );
+            std::vector<iter_type> all;
+            tw.find_all ( haystack.begin (), haystack.end (), std::back_inserter ( all ), mode );
+            std::vector<int> offsets;
+            for ( std::size_t j = 0; j < all.size (); ++j )
+                offsets.push_back ( static_cast<int> ( all [ j ] - haystack.begin ()));
+            BOOST_CHECK_EQUAL_COLLECTIONS ( offsets.begin (), offsets.end (), exp_all.begin (), exp_all.end ());
+            }
+        }
+
+//  The number of times the corpus is looked at is linear in its length
+    void check_linear ( const std::string &haystack, const std::string &needle ) {
+        typedef counting_iterator<std::string::const_iterator> c_iter;
+        const ba::two_way<std::string::const_iterator> tw ( needle.begin (), needle.end ());
+        std::size_t count = 0;
+        tw ( c_iter ( haystack.begin (), &count ), c_iter ( haystack.end (), &count ));
+        BOOST_CHECK_LE ( count, 2 * haystack.size ());
+
+        count = 0;
+        std::vector<c_iter> found;
+        tw.find_all ( c_iter ( haystack.begin (), &count ), c_iter ( haystack.end (), &count ), std::back_inserter ( found ));
+        BOOST_CHECK_EQUAL ( found.size (), brute_force ( haystack, needle, ba::match_overlapping ).size ());
+        BOOST_CHECK_LE ( count, 2 * haystack.size ());
+        }
+    }
+
+
+BOOST_AUTO_TEST_CASE( test_main )
+{
+    check_one ( "aaaaaaaa", "a" );
+    check_one ( "aaaaaaaa", "aaa" );
+    check_one ( "aaaaaaaa", "aaaaaaaaa" );
+    check_one ( "abababababab", "abab" );
+    check_one ( "abababababab", "bab" );
+    check_one ( "abcabcabdabcabcabcabd", "abcabd" );
+    check_one ( "abcabcabdabcabcabcabd", "" );
+    check_one ( "", "abc" );
+    check_one ( "NOW AN FOWE\220ER ANNMAN THE ANPANMANEND", "ANPANMAN" );
+    check_one ( "NOW AN FOWE\220ER ANNMAN THE ANPANMANEND", "\220ER" );
+    check_one ( "zzzzazzzzbzzzz", "zzzb" );
+    check_one ( "banananobano", "nano" );
+
+    for ( unsigned long seed = 1; seed < 300; ++seed ) {
+        unsigned long s = seed;
+        const unsigned alphabet = 2 + seed % 3;
+        const std::string haystack = make_string ( 200 + seed, alphabet, s );
+        check_one ( haystack, make_string ( 1 + seed % 9, alphabet, s ));
+        check_one ( haystack, haystack.substr ( seed % 50, 1 + seed % 13 ));
+        }
+
+//  Worst cases for naive search, and for Boyer-Moore
+    check_linear ( std::string ( 10000, 'a' ), std::string ( 50, 'a' ));
+    check_linear ( std::string ( 10000, 'a' ), std::string ( 49, 'a' ) + "b" );
+    check_linear ( std::string ( 10000, 'a' ), "b" + std::string ( 49, 'a' ));
+    std::string ab;
+    for ( int i = 0; i < 5000; ++i ) ab += "ab";
+    check_linear ( ab, ab.substr ( 0, 40 ));
+    check_linear ( ab, ab.substr ( 0, 41 ) + "b" );
+}
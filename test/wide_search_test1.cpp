@@ -0,0 +1,127 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+
+    Testing the searchers over contiguous corpora of 2, 4 and 8 byte integers
+*/
+
+#include <boost/algorithm/searching/boyer_moore.hpp>
+#include <boost/algorithm/searching/boyer_moore_horspool.hpp>
+#include <boost/algorithm/searching/knuth_morris_pratt.hpp>
+#include <boost/cstdint.hpp>
+
+#include "random_test.hpp"
+
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <iterator>
+
+namespace ba = boost::algorithm;
+
+namespace {
+
+//  Every match, found the slow way
+    template <typename T>
+    std::vector<std::size_t> all_matches ( const std::vector<T> &haystack, const std::vector<T> &needle,
+                                           ba::match_mode_type mode ) {
+        std::vector<std::size_t> retVal;
+        typename std::vector<T>::const_iterator it = haystack.begin ();
+        while ( true ) {
+            it = std::search ( it, haystack.end (), needle.begin (), needle.end ());
+            if ( it == haystack.end ()) break;
+            retVal.push_back ( it - haystack.begin ());
+            it += mode == ba::match_overlapping ? 1 : needle.size ();
+            }
+        return retVal;
+        }
+
+    template <typename T>
+    void check_one ( const std::vector<T> &haystack, const std::vector<T> &needle ) {
+        typedef typename std::vector<T>::const_iterator iter_type;
+        const iter_type expected = std::search ( haystack.begin (), haystack.end (), needle.begin (), needle.end ());
+        const ba::boyer_moore_horspool<iter_type> bmh ( needle.begin (), needle.end ());
+
+        BOOST_CHECK ( bmh ( haystack.begin (), haystack.end ()) == expected );
+        BOOST_CHECK ( ba::boyer_moore_horspool_search ( haystack, needle ) == expected );
+        BOOST_CHECK ( ba::boyer_moore_search ( haystack, needle ) == expected );
+        BOOST_CHECK ( ba::knuth_morris_pratt_search ( haystack, needle ) == expected );
+
+    //  And through plain pointers
+        if ( !haystack.empty () && !needle.empty ()) {
+            const T *first = &haystack [ 0 ];
+            const T *last  = first + haystack.size ();
+            const T *found = ba::boyer_moore_horspool_search ( first, last, &needle [ 0 ], &needle [ 0 ] + needle.size ());
+            BOOST_CHECK_EQUAL ( found - first, expected - haystack.begin ());
+            const ba::boyer_moore_horspool<const T *> p_bmh ( &needle [ 0 ], &needle [ 0 ] + needle.size ());
+            BOOST_CHECK_EQUAL ( p_bmh ( first, last ) - first, expected - haystack.begin ());
+            }
+
+        for ( int i = 0; i < 2; ++i ) {
+            const ba::match_mode_type mode = i == 0 ? ba::match_overlapping : ba::match_non_overlapping;
+            const std::vector<std::size_t> all = needle.empty () ? std::vector<std::size_t> () : all_matches ( haystack, needle, mode );
+            std::vector<iter_type> found;
+            bmh.find_all ( haystack.begin (), haystack.end (), std::back_inserter ( found ), mode );
+            BOOST_CHECK_EQUAL ( found.size (), all.size ());
+            for ( std::size_t j = 0; j < found.size () && j < all.size (); ++j )
+                BOOST_CHECK_EQUAL ( static_cast<std::size_t> ( found [ j ] - haystack.begin ()), all [ j ] );
+            BOOST_CHECK_EQUAL ( bmh.count ( haystack.begin (), haystack.end (), mode ), all.size ());
+            }
+        }
+
+//  Small alphabets, so that there are plenty of candidates to verify, and
+//  values that differ only in their high bytes, so that a compare that looks
+//  at part of an element would go wrong.
+    template <typename T>
+    void check_type ( T high ) {
+        unsigned long seed = 12345;
+        for ( std::size_t size = 0; size < 300; size += 7 ) {
+            std::vector<T> haystack ( size );
+            for ( std::size_t i = 0; i < size; ++i )
+                haystack [ i ] = static_cast<T> ( static_cast<T> ( next_random ( seed ) % 3 ) | ( next_random ( seed ) % 2 ? high : T ( 0 )));
+
+            for ( std::size_t m = 1; m < 20 && m <= size; m += 3 ) {
+                const std::size_t pos = next_random ( seed ) % ( size - m + 1 );
+                std::vector<T> needle ( haystack.begin () + pos, haystack.begin () + pos + m );
+                check_one ( haystack, needle );
+
+            //  ... and one that (probably) isn't there
+                needle [ m / 2 ] ^= high;
+                check_one ( haystack, needle );
+                }
+            }
+
+    //  A pattern at the very end of the corpus
+        std::vector<T> haystack ( 100, T ( 1 ));
+        std::vector<T> needle ( 5, T ( 1 ));
+        needle.back () = high;
+        haystack.back () = high;
+        check_one ( haystack, needle );
+        check_one ( haystack, std::vector<T> ());
+        }
+    }
+
+BOOST_AUTO_TEST_CASE( test_main )
+{
+    check_type<boost::uint16_t> ( 0x8000 );
+    check_type<boost::int16_t>  ( 0x0100 );
+    check_type<boost::uint32_t> ( 0x80000000UL );
+    check_type<boost::int32_t>  ( 0x00010000 );
+    check_type<boost::uint64_t> ( static_cast<boost::uint64_t> ( 1 ) << 40 );
+    check_type<boost::int64_t>  ( static_cast<boost::int64_t> ( 1 ) << 62 );
+    check_type<wchar_t>         ( static_cast<wchar_t> ( 0x100 ));
+
+//  Wide strings go the same way
+    const std::wstring corpus  = L"The quick brown fox jumps over the lazy dog";
+    const std::wstring pattern = L"lazy";
+    BOOST_CHECK ( ba::boyer_moore_horspool_search ( corpus, pattern ) == corpus.begin () + corpus.find ( pattern ));
+    const std::wstring missing = L"lazz";
+    BOOST_CHECK ( ba::boyer_moore_horspool_search ( corpus, missing ) == corpus.end ());
+}
@@ -0,0 +1,130 @@
+/*
+   Copyright (c) Marshall Clow 2010-2012.
+
+   Distributed under the Boost Software License, Version 1.0. (See accompanying
+   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+    For more information, see http://www.boost.org
+*/
+
+#include <boost/algorithm/searching/wu_manber.hpp>
+
+#include "random_test.hpp"
+
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <iterator>
+
+namespace ba = boost::algorithm;
+
+namespace {
+
+//  Every match, found the slow way, ordered by start position and then by id
+    template <typename String>
+    std::vector<std::pair<std::size_t, std::size_t> >
+    brute_force ( const String &corpus, const std::vector<String> &patterns ) {
+        std::vector<std::pair<std::size_t, std::size_t> > retVal;
+        for ( std::size_t start = 0; start < corpus.size (); ++start )
+            for ( std::size_t id = 0; id < patterns.size (); ++id ) {
+                const std::size_t len = patterns [ id ].size ();
+                if ( len == 0 || start + len > corpus.size ()) continue;
+                if ( std::find ( patterns.begin (), patterns.begin () + id, patterns [ id ] ) != patterns.begin () + id )
+                    continue;   // duplicates report the first id
+                if ( std::equal ( patterns [ id ].begin (), patterns [ id ].end (), corpus.begin () + start ))
+                    retVal.push_back ( std::make_pair ( start, id ));
+                }
+        return retVal;
+        }
+
+    template <typename String>
+    void check_one ( const String &corpus, const std::vector<String> &patterns ) {
+        typedef typename String::const_iterator iter_type;
+        const std::vector<std::pair<std::size_t, std::size_t> > expected = brute_force ( corpus, patterns );
+        const ba::wu_manber<iter_type> wm ( patterns.begin (), patterns.end ());
+        BOOST_CHECK_EQUAL ( wm.size (), patterns.size ());
+
+        std::vector<std::pair<iter_type, std::size_t> > all;
+        wm.find_all ( corpus.begin (), corpus.end (), std::back_inserter ( all ));
+        std::vector<std::pair<std::size_t, std::size_t> > found;
+        for ( std::size_t i = 0; i < all.size (); ++i )
+            found.push_back ( std::make_pair ( all [ i ].first - corpus.begin (), all [ i ].second ));
+        BOOST_CHECK ( found == expected );
+
+        const std::pair<iter_type, std::size_t> first = wm ( corpus );
+        const std::pair<iter_type, std::size_t> first2 = ba::wu_manber_search ( corpus, patterns );
+        BOOST_CHECK ( first == first2 );
+        if ( expected.empty ()) {
+            BOOST_CHECK ( first.first == corpus.end ());
+            BOOST_CHECK_EQUAL ( first.second, ba::wu_manber<iter_type>::npos );
+            }
+        else {
+            BOOST_CHECK_EQUAL ( std::size_t ( first.first - corpus.begin ()), expected [ 0 ].first );
+            BOOST_CHECK_EQUAL ( first.second, expected [ 0 ].second );
+            }
+        }
+    }
+
+
+BOOST_AUTO_TEST_CASE( test_main )
+{
+    std::vector<std::string> patterns;
+    patterns.push_back ( "he" );
+    patterns.push_back ( "she" );
+    patterns.push_back ( "his" );
+    patterns.push_back ( "hers" );
+    check_one ( std::string ( "ushers" ), patterns );
+    check_one ( std::string ( "she sells his hers" ), patterns );
+    check_one ( std::string ( "xyz" ), patterns );
+    check_one ( std::string (), patterns );
+
+    patterns.push_back ( "" );          // ignored
+    patterns.push_back ( "she" );       // reported as pattern 1
+    check_one ( std::string ( "ushers" ), patterns );
+    check_one ( std::string ( "ushers" ), std::vector<std::string> ());
+    std::vector<std::string> twice ( 3, "ab" );
+    twice.push_back ( "abc" );
+    twice.push_back ( "ab" );
+    check_one ( std::string ( "xabcab" ), twice );
+    const ba::wu_manber<std::string::const_iterator> wm ( twice.begin (), twice.end ());
+    std::vector<std::pair<std::string::const_iterator, std::size_t> > all;
+    const std::string abab ( "abab" );
+    wm.find_all ( abab.begin (), abab.end (), std::back_inserter ( all ));
+    BOOST_CHECK_EQUAL ( all.size (), 2U );
+    BOOST_CHECK ( all.size () == 2 && all [ 0 ].second == 0 && all [ 1 ].second == 0 );
+
+//  A single element pattern sets the block size to one
+    patterns.push_back ( "s" );
+    check_one ( std::string ( "ushers sells" ), patterns );
+
+    for ( unsigned long seed = 1; seed < 60; ++seed ) {
+        unsigned long s = seed;
+        const unsigned alphabet = 2 + seed % 5;
+        const std::string corpus = make_string<std::string> ( 500, alphabet, s );
+        std::vector<std::string> pats;
+        const std::size_t k_count = 1 + seed * 7 % 400;     // some get the longer blocks
+        for ( std::size_t i = 0; i < k_count; ++i )
+            pats.push_back ( make_string<std::string> ( 2 + next_random ( s ) % 8, alphabet, s ));
+        check_one ( corpus, pats );
+        }
+
+//  Long patterns, long shifts
+    unsigned long s = 99;
+    const std::string corpus = make_string<std::string> ( 20000, 26, s );
+    std::vector<std::string> pats;
+    for ( std::size_t i = 0; i < 50; ++i )
+        pats.push_back ( corpus.substr ( next_random ( s ) % 19000, 300 + i ));
+    pats.push_back ( make_string<std::string> ( 400, 26, s ));
+    check_one ( corpus, pats );
+
+//  Wider elements
+    const std::wstring wcorpus ( L"the quick brown fox jumps over the lazy dog" );
+    std::vector<std::wstring> wpats;
+    wpats.push_back ( L"fox" );
+    wpats.push_back ( L"the" );
+    wpats.push_back ( L"lazy" );
+    check_one ( wcorpus, wpats );
+}